@@ -44,3 +44,12 @@
 #define LLONG_MAX 0x7fffffffffffffff
 #define LLONG_MIN (-0x7fffffffffffffff - 1)
 #define ULLONG_MAX 0xffffffffffffffff
+
+/* Other invariant values. */
+
+/* Maximum number of buffers that can be passed to writev(). */
+#define IOV_MAX 1024
+
+/* Maximum value of n in conversion specifications using the "%n$" sequence in
+ * calls to the printf() family of functions. */
+#define NL_ARGMAX 32
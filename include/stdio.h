@@ -24,33 +24,152 @@
 /* End-of-file return value. */
 #define EOF ((int)-1)
 
+/* Size of the buffer of the standard output stream. */
+#define BUFSIZ 1024
+
+/* Buffering modes for setvbuf(). */
+#define _IOFBF 0 /* Fully buffered. */
+#define _IOLBF 1 /* Line buffered. */
+#define _IONBF 2 /* Unbuffered. */
+
+/* An output stream. */
+typedef struct _FILE FILE;
+
+/* Standard output stream, which is line buffered. */
+extern FILE *stdout;
+/* Standard error stream, which is unbuffered. */
+extern FILE *stderr;
+
+/**
+ * @brief      Sets the buffering mode of a stream. Any buffered data is
+ *             flushed first.
+ *
+ * @param[in]  stream  The stream.
+ * @param[in]  buf     The buffer to be used, or NULL to use the default
+ *                     buffer of the stream. Ignored for @ref _IONBF.
+ * @param[in]  mode    One of @ref _IOFBF, @ref _IOLBF or @ref _IONBF.
+ * @param[in]  size    Size of @p buf in bytes.
+ *
+ * @return     On success, 0 is returned. Otherwise, a non-zero value is
+ *             returned and the value of @ref errno is set.
+ */
+int setvbuf(FILE *restrict stream, char *restrict buf, int mode, size_t size);
+
+/**
+ * @brief      Writes any buffered data of a stream.
+ *
+ * @param[in]  stream  The stream, or NULL to flush all streams.
+ *
+ * @return     On success, 0 is returned. Otherwise, @ref EOF is returned and
+ *             the error indicator of the stream is set.
+ */
+int fflush(FILE *stream);
+
+/**
+ * @brief      Writes an array of elements to a stream.
+ *
+ * @param[in]  ptr     Pointer to the first element.
+ * @param[in]  size    Size of each element in bytes.
+ * @param[in]  nmemb   Number of elements.
+ * @param[in]  stream  The stream.
+ *
+ * @return     The number of elements written, which is less than @p nmemb
+ *             only if an error occurred.
+ */
+size_t fwrite(const void *restrict ptr, size_t size, size_t nmemb,
+    FILE *restrict stream);
+
+/**
+ * @brief      Writes a byte to a stream.
+ *
+ * @param[in]  val     Byte to be written, converted to an unsigned char.
+ * @param[in]  stream  The stream.
+ *
+ * @return     On success, the byte written. Otherwise, @ref EOF.
+ */
+int fputc(int val, FILE *stream);
+
+/**
+ * @brief      Same as fputc().
+ */
+int putc(int val, FILE *stream);
+
+/**
+ * @brief      Writes a string to a stream, without its NUL terminator.
+ *
+ * @param[in]  str     The string.
+ * @param[in]  stream  The stream.
+ *
+ * @return     On success, a non-negative value. Otherwise, @ref EOF.
+ */
+int fputs(const char *restrict str, FILE *restrict stream);
+
+/**
+ * @brief      Tests the error indicator of a stream.
+ *
+ * @param[in]  stream  The stream.
+ *
+ * @return     Non-zero if the error indicator is set.
+ */
+int ferror(FILE *stream);
+
 /**
- * @brief      Puts a string on the standard output stream.
+ * @brief      Clears the error indicator of a stream.
+ *
+ * @param[in]  stream  The stream.
+ */
+void clearerr(FILE *stream);
+
+/**
+ * @brief      Puts a byte on the standard output stream.
  *
  * @param[in]  val   Byte to be written to the standard output.
  *
- * @return     On success, the value written to the standard output.
- *             Otherwise, a negative value indicating the error code.
+ * @return     On success, the byte written. Otherwise, @ref EOF.
  */
 int putchar(int val);
 
 /**
- * @brief      Puts a string on the standard output stream.
+ * @brief      Puts a string followed by a newline on the standard output
+ *             stream.
  *
  * @param[in]  str   Pointer to the first character of the string to be written.
  *
- * @return     On success, 0 is returned. Otherwise, the value of @ref errno is
- *             set and @ref EOF is returned.
+ * @return     On success, a non-negative value is returned. Otherwise,
+ *             @ref EOF is returned and the value of @ref errno is set.
+ */
+int puts(const char *str);
+
+/**
+ * @brief      Write a formatted string to a stream.
+ *
+ * @param[in]  stream  The stream.
+ * @param[in]  fmt     String to be used to format the output.
+ *
+ * @return     On success, the number of characters written is returned.
+ *             Otherwise, a negative value is returned and the value of
+ *             @ref errno is set to reflect the error.
  */
+int fprintf(FILE *restrict stream, const char *restrict fmt, ...);
 
 /**
- * hello
- * world
+ * @brief      Same as fprintf(), but taking a variable argument list.
+ *
+ * @param[in]  stream  The stream.
+ * @param[in]  fmt     String to be used to format the output.
+ * @param[in]  args    Argument list.
+ *
+ * @return     Same as fprintf().
  */
-int puts(const char *str);
+int vfprintf(FILE *restrict stream, const char *restrict fmt, va_list args);
 
 /**
  * @brief      Write a formatted string to the standard output stream.
+ *             Arguments may be referenced by position with "%n$" (where n
+ *             is at most @ref NL_ARGMAX), in which case all conversions in
+ *             the format string must be numbered. Long double arguments
+ *             ("%Lf" and the like) are not supported, and fail with
+ *             @ref errno set to ENOSYS.
  *
  * @param[in]  fmt   String to be used to format the output.
  *
@@ -59,11 +178,39 @@ int puts(const char *str);
  *             @ref errno is set to reflect the error.
  */
 int printf(const char *restrict fmt, ...);
+
+/**
+ * @brief      Write a formatted string to a buffer of bounded size.
+ *
+ * @param[out] dest  Destination buffer. May be NULL if @p n is 0.
+ * @param[in]  n     Size of @p dest in bytes, including the NUL terminator.
+ * @param[in]  fmt   String to be used to format the output.
+ *
+ * @return     The number of characters that would have been written had @p n
+ *             been large enough, not counting the NUL terminator. The output
+ *             is NUL-terminated unless @p n is 0. On error, a negative value.
+ */
 int snprintf(char *restrict dest, size_t n, const char *restrict fmt, ...);
+
+/**
+ * @brief      Write a formatted string to a buffer.
+ *
+ * @param[out] dest  Destination buffer, which must be large enough to hold
+ *                   the output and the NUL terminator.
+ * @param[in]  fmt   String to be used to format the output.
+ *
+ * @return     The number of characters written, not counting the NUL
+ *             terminator. On error, a negative value.
+ */
 int sprintf(char *restrict dest, const char *restrict fmt, ...);
 
 /**
  * @brief      Write a formatted string to the standard output stream.
+ *             Arguments may be referenced by position with "%n$" (where n
+ *             is at most @ref NL_ARGMAX), in which case all conversions in
+ *             the format string must be numbered. Long double arguments
+ *             ("%Lf" and the like) are not supported, and fail with
+ *             @ref errno set to ENOSYS.
  *
  * @param[in]  fmt   String to be used to format the output.
  * @param[in]  args  Argument list used for formatting.
@@ -74,6 +221,55 @@ int sprintf(char *restrict dest, const char *restrict fmt, ...);
  */
 int vprintf(const char *restrict fmt, va_list args);
 
+/**
+ * @brief      Write a formatted string to a buffer of bounded size.
+ *
+ * @param[out] dest  Destination buffer. May be NULL if @p n is 0.
+ * @param[in]  n     Size of @p dest in bytes, including the NUL terminator.
+ * @param[in]  fmt   String to be used to format the output.
+ * @param[in]  args  Argument list used for formatting.
+ *
+ * @return     See @ref snprintf.
+ */
 int vsnprintf(
     char *restrict dest, size_t n, const char *restrict fmt, va_list args);
+
+/**
+ * @brief      Write a formatted string to a buffer.
+ *
+ * @param[out] dest  Destination buffer.
+ * @param[in]  fmt   String to be used to format the output.
+ * @param[in]  args  Argument list used for formatting.
+ *
+ * @return     See @ref sprintf.
+ */
 int vsprintf(char *restrict dest, const char *restrict fmt, va_list args);
+
+/**
+ * @brief      Read formatted input from a string. Wide characters ("%lc",
+ *             "%ls" and "%l[") and long doubles ("%Lf" and the like) are
+ *             not supported, and fail with @ref errno set to ENOSYS.
+ *
+ * @param[in]  str   String to be read.
+ * @param[in]  fmt   String describing the expected input.
+ * @param[out] ...   Pointers to the objects that receive the converted
+ *                   values.
+ *
+ * @return     The number of values assigned, which may be less than the
+ *             number of conversions if the input does not match. If the
+ *             string ends before the first conversion, or if the format is
+ *             invalid, @ref EOF is returned.
+ */
+int sscanf(const char *restrict str, const char *restrict fmt, ...);
+
+/**
+ * @brief      Read formatted input from a string.
+ *
+ * @param[in]  str   String to be read.
+ * @param[in]  fmt   String describing the expected input.
+ * @param[in]  args  Argument list with the pointers to the objects that
+ *                   receive the converted values.
+ *
+ * @return     See @ref sscanf.
+ */
+int vsscanf(const char *restrict str, const char *restrict fmt, va_list args);
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <stddef.h>
+
 /**
  * @brief      Convert the given string to a long int value.
  *
@@ -92,6 +94,129 @@ unsigned long int strtoul(
 unsigned long long int strtoull(
     const char *restrict nptr, char **restrict endptr, int base);
 
+/**
+ * @brief      Convert the given string to a double value, correctly rounded
+ *             to nearest. Decimal and hexadecimal ("0x") notations are
+ *             accepted, as well as "inf", "infinity", "nan" and
+ *             "nan(n-char-sequence)", ignoring case.
+ *
+ * @param[in]  nptr    The string to be converted.
+ * @param      endptr  If not NULL, a pointer to a string starting immediately
+ *                     after the last character of the conversion.
+ *
+ * @return     The parsed numeric value. If no conversion could be made,
+ *             0 is returned and errno is set accordingly. If the value is
+ *             too large or too small, an infinity or zero is returned and
+ *             errno is set to ERANGE.
+ */
+double strtod(const char *restrict nptr, char **restrict endptr);
+
+/**
+ * @brief      Convert the given string to a float value. It behaves like
+ *             strtod(), but rounds straight to float.
+ *
+ * @param[in]  nptr    The string to be converted.
+ * @param      endptr  If not NULL, a pointer to a string starting immediately
+ *                     after the last character of the conversion.
+ *
+ * @return     The parsed numeric value, as for strtod().
+ */
+float strtof(const char *restrict nptr, char **restrict endptr);
+
+/**
+ * @brief      Convert the given string to a double value, as with
+ *             strtod(nptr, NULL).
+ *
+ * @param[in]  nptr  The string to be converted.
+ *
+ * @return     The parsed numeric value.
+ */
+double atof(const char *nptr);
+
+/**
+ * @brief      Sorts an array in ascending order. The sort is not stable, but
+ *             takes O(n log n) time and O(log n) stack space in the worst
+ *             case.
+ *
+ * @param      base    The array.
+ * @param[in]  nmemb   The number of elements in the array.
+ * @param[in]  size    The size of each element.
+ * @param[in]  compar  A function that returns a negative, zero or positive
+ *                     value if its first argument is less than, equal to or
+ *                     greater than the second, respectively.
+ */
+void qsort(void *base, size_t nmemb, size_t size,
+    int (*compar)(const void *, const void *));
+
+/**
+ * @brief      Searches a sorted array for an element that matches a key.
+ *
+ * @param[in]  key     The key.
+ * @param[in]  base    The array, sorted in ascending order according to
+ *                     compar.
+ * @param[in]  nmemb   The number of elements in the array.
+ * @param[in]  size    The size of each element.
+ * @param[in]  compar  A function that compares the key, its first argument,
+ *                     with an element, as for qsort().
+ *
+ * @return     A matching element, or NULL if there is none. If several
+ *             elements match, it is unspecified which one is returned.
+ */
+void *bsearch(const void *key, const void *base, size_t nmemb, size_t size,
+    int (*compar)(const void *, const void *));
+
+/**
+ * @brief      Allocates memory.
+ *
+ * @param[in]  size  The number of bytes.
+ *
+ * @return     The memory, aligned to 16 bytes, or NULL if there was not
+ *             enough, in which case errno is set to ENOMEM.
+ */
+void *malloc(size_t size);
+
+/**
+ * @brief      Allocates memory for an array, filled with zeros.
+ *
+ * @param[in]  nmemb  The number of elements.
+ * @param[in]  size   The size of each element.
+ *
+ * @return     The memory, as for malloc(). NULL is also returned if the
+ *             size of the array does not fit in a size_t.
+ */
+void *calloc(size_t nmemb, size_t size);
+
+/**
+ * @brief      Allocates memory with a given alignment.
+ *
+ * @param[in]  alignment  The alignment, a power of two.
+ * @param[in]  size       The number of bytes.
+ *
+ * @return     The memory, as for malloc(). If the alignment is not a power
+ *             of two, NULL is returned and errno is set to EINVAL.
+ */
+void *aligned_alloc(size_t alignment, size_t size);
+
+/**
+ * @brief      Changes the size of an allocation, moving it if needed.
+ *
+ * @param      ptr   The allocation, or NULL to make a new one.
+ * @param[in]  size  The new number of bytes.
+ *
+ * @return     The allocation, whose contents are those of the old one up to
+ *             the lesser of both sizes, or NULL if there was not enough
+ *             memory, in which case the old one is left untouched.
+ */
+void *realloc(void *ptr, size_t size);
+
+/**
+ * @brief      Frees memory obtained from malloc(), calloc(), aligned_alloc()
+ *             or realloc().
+ *
+ * @param      ptr   The memory, or NULL.
+ */
+void free(void *ptr);
+
 /**
  * @brief      Aborts the execution of the program.
  */
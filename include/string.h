@@ -28,6 +28,19 @@
  */
 size_t strlen(const char *str);
 
+/**
+ * @brief      Obtains the length of the null-terminated string @p str,
+ *             examining no more than @p maxlen characters.
+ *
+ * @param[in]  str     The string.
+ * @param[in]  maxlen  The maximum number of characters to be examined.
+ *
+ * @return     The number of characters in @p str up to the null terminator,
+ *             or @p maxlen if there is none among the first @p maxlen
+ *             characters.
+ */
+size_t strnlen(const char *str, size_t maxlen);
+
 /**
  * @brief      Compare the null-terminated strings @p str1 and @p str2
  *             lexicographically.
@@ -41,6 +54,66 @@ size_t strlen(const char *str);
  */
 int strcmp(const char *str1, const char *str2);
 
+/**
+ * @brief      Locates the first occurrence of a character in the
+ *             null-terminated string @p str.
+ *
+ * @param[in]  str   The string to be searched.
+ * @param[in]  c     The character, converted to a char. The null terminator
+ *                   is considered part of the string.
+ *
+ * @return     A pointer to the located character, or NULL if it does not
+ *             occur in @p str.
+ */
+char *strchr(const char *str, int c);
+
+/**
+ * @brief      Locates the last occurrence of a character in the
+ *             null-terminated string @p str.
+ *
+ * @param[in]  str   The string to be searched.
+ * @param[in]  c     The character, converted to a char. The null terminator
+ *                   is considered part of the string.
+ *
+ * @return     A pointer to the located character, or NULL if it does not
+ *             occur in @p str.
+ */
+char *strrchr(const char *str, int c);
+
+/**
+ * @brief      Locates the first occurrence of the null-terminated string
+ *             @p needle in the null-terminated string @p haystack.
+ *
+ * @param[in]  haystack  The string to be searched.
+ * @param[in]  needle    The string to be found.
+ *
+ * @return     A pointer to the located string, @p haystack if @p needle is
+ *             empty, or NULL if it does not occur.
+ */
+char *strstr(const char *haystack, const char *needle);
+
+/**
+ * @brief      Obtains the length of the initial segment of @p str that
+ *             consists only of characters in @p accept.
+ *
+ * @param[in]  str     The string to be examined.
+ * @param[in]  accept  The characters that may make up the segment.
+ *
+ * @return     The length of the segment.
+ */
+size_t strspn(const char *str, const char *accept);
+
+/**
+ * @brief      Obtains the length of the initial segment of @p str that
+ *             consists only of characters not in @p reject.
+ *
+ * @param[in]  str     The string to be examined.
+ * @param[in]  reject  The characters that end the segment.
+ *
+ * @return     The length of the segment.
+ */
+size_t strcspn(const char *str, const char *reject);
+
 /**
  * @brief      Append a copy of the null-terminated string @p src to the end
  *             of the null-terminated string @p dst, then add a terminating
@@ -66,6 +139,72 @@ char *strcat(char *restrict dst, const char *restrict src);
  */
 char *strncat(char *restrict dst, const char *restrict src, size_t n);
 
+/**
+ * @brief      Copies @p len bytes from the buffer @p src to the buffer @p dst.
+ *             The buffers must not overlap.
+ *
+ * @param[out] dst   The destination buffer.
+ * @param[in]  src   The source buffer.
+ * @param[in]  len   The number of bytes to be copied.
+ *
+ * @return     The pointer @p dst.
+ */
+void *memcpy(void *restrict dst, const void *restrict src, size_t len);
+
+/**
+ * @brief      Copies @p len bytes from the buffer @p src to the buffer @p dst.
+ *             The buffers may overlap.
+ *
+ * @param[out] dst   The destination buffer.
+ * @param[in]  src   The source buffer.
+ * @param[in]  len   The number of bytes to be copied.
+ *
+ * @return     The pointer @p dst.
+ */
+void *memmove(void *dst, const void *src, size_t len);
+
+/**
+ * @brief      Compare the first @p len bytes of the buffers @p src1 and
+ *             @p src2, interpreted as unsigned char.
+ *
+ * @param[in]  src1  The first buffer to be compared.
+ * @param[in]  src2  The second buffer to be compared.
+ * @param[in]  len   The number of bytes to be compared.
+ *
+ * @return     A value greater than zero, equal to zero or less than zero;
+ *             depending on @p src1 being greater than, equal to, or less than
+ *             @p src2.
+ */
+int memcmp(const void *src1, const void *src2, size_t len);
+
+/**
+ * @brief      Locates the first occurrence of a byte in the first @p len
+ *             bytes of the buffer @p src.
+ *
+ * @param[in]  src   The buffer to be searched.
+ * @param[in]  c     The byte, converted to an unsigned char.
+ * @param[in]  len   The number of bytes to be searched.
+ *
+ * @return     A pointer to the located byte, or NULL if it does not occur in
+ *             the buffer.
+ */
+void *memchr(const void *src, int c, size_t len);
+
+/**
+ * @brief      Locates the first occurrence of the buffer @p needle in the
+ *             buffer @p haystack.
+ *
+ * @param[in]  haystack  The buffer to be searched.
+ * @param[in]  hlen      The length of @p haystack.
+ * @param[in]  needle    The buffer to be found.
+ * @param[in]  nlen      The length of @p needle.
+ *
+ * @return     A pointer to the located buffer, @p haystack if @p nlen is 0,
+ *             or NULL if it does not occur.
+ */
+void *memmem(
+    const void *haystack, size_t hlen, const void *needle, size_t nlen);
+
 /**
  * @brief      Writes @p len bytes of the value @p v to the @p dst buffer.
  *
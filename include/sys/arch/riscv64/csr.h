@@ -30,10 +30,14 @@ enum csr {
 
     CSR_MHARTID = 0xF14, /* Hardware thread ID. */
     CSR_MSTATUS = 0x300, /* Machine status register. */
+    CSR_MISA = 0x301, /* ISA and extensions. */
     CSR_MTVEC = 0x305, /* Machine trap-handler base address. */
     CSR_MEPC = 0x341, /* Machine exception program counter. */
     CSR_MCAUSE = 0x342, /* Machine trap cause. */
     CSR_MTVAL = 0x343, /* Machine bad address or instruction. */
+    CSR_PMPCFG0 = 0x3A0, /* Physical memory protection configuration. */
+    CSR_PMPADDR0 = 0x3B0, /* Physical memory protection address 0. */
+    CSR_PMPADDR1 = 0x3B1, /* Physical memory protection address 1. */
 };
 
 /**
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/* The compiler lowers these builtins to single Zbb instructions (ctz, clz,
+ * cpop and rev8). Without Zbb, RISC-V targets would need libgcc, which the
+ * kernel does not link, so software versions are used there instead. Hosted
+ * builds rely on the host compiler and its runtime. */
+#if defined(__riscv_zbb) || !defined(__riscv)
+#define BITOPS_BUILTIN 1
+#endif
+
+/**
+ * @brief      Counts the bits set in a value, in software.
+ *
+ * @param[in]  x     The value.
+ *
+ * @return     The number of bits set.
+ */
+static inline unsigned popcount64_soft(uint64_t x)
+{
+    x -= (x >> 1U) & 0x5555555555555555ULL;
+    x = (x & 0x3333333333333333ULL) + ((x >> 2U) & 0x3333333333333333ULL);
+    x = (x + (x >> 4U)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (unsigned)((x * 0x0101010101010101ULL) >> 56U);
+}
+
+/**
+ * @brief      Finds the least significant bit set in a value, in software.
+ *
+ * @param[in]  x     The value.
+ *
+ * @return     The 1-based position of the bit, or 0 if @p x is 0.
+ */
+static inline unsigned ffs64_soft(uint64_t x)
+{
+    return x == 0 ? 0 : popcount64_soft((x & -x) - 1) + 1;
+}
+
+/**
+ * @brief      Finds the most significant bit set in a value, in software.
+ *
+ * @param[in]  x     The value.
+ *
+ * @return     The 1-based position of the bit, or 0 if @p x is 0.
+ */
+static inline unsigned fls64_soft(uint64_t x)
+{
+    /* Smear the top bit downwards, then count the bits below it. */
+    x |= x >> 1U;
+    x |= x >> 2U;
+    x |= x >> 4U;
+    x |= x >> 8U;
+    x |= x >> 16U;
+    x |= x >> 32U;
+    return popcount64_soft(x);
+}
+
+/**
+ * @brief      Reverses the order of the bytes of a value, in software.
+ *
+ * @param[in]  x     The value.
+ *
+ * @return     The value with its bytes reversed.
+ */
+static inline uint64_t bswap64_soft(uint64_t x)
+{
+    x = ((x & 0x00ff00ff00ff00ffULL) << 8U)
+        | ((x >> 8U) & 0x00ff00ff00ff00ffULL);
+    x = ((x & 0x0000ffff0000ffffULL) << 16U)
+        | ((x >> 16U) & 0x0000ffff0000ffffULL);
+    return (x << 32U) | (x >> 32U);
+}
+
+/**
+ * @brief      Counts the bits set in a value.
+ *
+ * @param[in]  x     The value.
+ *
+ * @return     The number of bits set.
+ */
+static inline unsigned popcount64(uint64_t x)
+{
+#ifdef BITOPS_BUILTIN
+    return (unsigned)__builtin_popcountll(x);
+#else
+    return popcount64_soft(x);
+#endif
+}
+
+/**
+ * @brief      Finds the least significant bit set in a value.
+ *
+ * @param[in]  x     The value.
+ *
+ * @return     The 1-based position of the bit, or 0 if @p x is 0.
+ */
+static inline unsigned ffs64(uint64_t x)
+{
+#ifdef BITOPS_BUILTIN
+    return x == 0 ? 0 : (unsigned)__builtin_ctzll(x) + 1;
+#else
+    return ffs64_soft(x);
+#endif
+}
+
+/**
+ * @brief      Finds the most significant bit set in a value.
+ *
+ * @param[in]  x     The value.
+ *
+ * @return     The 1-based position of the bit, or 0 if @p x is 0.
+ */
+static inline unsigned fls64(uint64_t x)
+{
+#ifdef BITOPS_BUILTIN
+    return x == 0 ? 0 : 64 - (unsigned)__builtin_clzll(x);
+#else
+    return fls64_soft(x);
+#endif
+}
+
+/**
+ * @brief      Reverses the order of the bytes of a value.
+ *
+ * @param[in]  x     The value.
+ *
+ * @return     The value with its bytes reversed.
+ */
+static inline uint64_t bswap64(uint64_t x)
+{
+#ifdef BITOPS_BUILTIN
+    return __builtin_bswap64(x);
+#else
+    return bswap64_soft(x);
+#endif
+}
+
+/**
+ * @brief      Reverses the order of the bytes of a 32-bit value.
+ *
+ * @param[in]  x     The value.
+ *
+ * @return     The value with its bytes reversed.
+ */
+static inline uint32_t bswap32(uint32_t x)
+{
+    return (uint32_t)(bswap64(x) >> 32U);
+}
+
+/**
+ * @brief      Reverses the order of the bytes of a 16-bit value.
+ *
+ * @param[in]  x     The value.
+ *
+ * @return     The value with its bytes reversed.
+ */
+static inline uint16_t bswap16(uint16_t x)
+{
+    return (uint16_t)(bswap64(x) >> 48U);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifdef _KERNEL
+#include <stddef.h>
+#include <stdint.h>
+
+/* Flattened device tree header magic. */
+#define FDT_MAGIC 0xd00dfeedU
+
+/**
+ * @brief      Reads a big-endian 32-bit value from the device tree.
+ *
+ * @param[in]  p     Pointer to the value.
+ *
+ * @return     The value.
+ */
+uint32_t fdt32(const void *p);
+
+/**
+ * @brief      Checks whether a device tree is present and well-formed enough
+ *             to be walked.
+ *
+ * @param[in]  fdt   The flattened device tree, or NULL.
+ *
+ * @return     1 if the device tree can be used, 0 otherwise.
+ */
+int fdt_valid(const void *fdt);
+
+/**
+ * @brief      Finds the first property with the given name in the device
+ *             tree.
+ *
+ * @param[in]  fdt   The flattened device tree.
+ * @param[in]  name  The property name.
+ * @param[out] len   The length of the property value.
+ *
+ * @return     The property value, or NULL if not found.
+ */
+const char *fdt_find_prop(const void *fdt, const char *name, size_t *len);
+
+/**
+ * @brief      Finds the memory region that contains an address, as described
+ *             by the memory nodes of the device tree.
+ *
+ * @param[in]  fdt    The flattened device tree.
+ * @param[in]  addr   The address.
+ * @param[out] start  The first address of the region.
+ * @param[out] end    The address past the end of the region.
+ *
+ * @return     0 on success, or -1 if no memory node covers the address.
+ */
+int fdt_memory(const void *fdt, uintptr_t addr, uintptr_t *start,
+    uintptr_t *end);
+
+/**
+ * @brief      Enumerates the memory that the device tree asks to be left
+ *             alone: the device tree itself, followed by the entries of its
+ *             memory reservation block.
+ *
+ * @param[in]  fdt    The flattened device tree.
+ * @param[in]  index  The index of the region, from 0.
+ * @param[out] start  The first address of the region.
+ * @param[out] end    The address past the end of the region.
+ *
+ * @return     0 on success, or -1 if there are no more regions.
+ */
+int fdt_reserved(const void *fdt, size_t index, uintptr_t *start,
+    uintptr_t *end);
+#endif /* _KERNEL */
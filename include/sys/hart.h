@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifdef _KERNEL
+/* Number of harts that get their own per-hart data. Any others share the
+ * global paths. */
+#define HART_MAX 8U
+
+/**
+ * @brief      Obtains the ID of the current hart, which the boot code leaves
+ *             in the thread pointer.
+ *
+ * @return     The hart ID.
+ */
+static inline unsigned hart_id(void)
+{
+#ifdef __riscv
+    unsigned long id;
+    __asm__("mv %0, tp" : "=r"(id));
+    return (unsigned)id;
+#else
+    return 0;
+#endif
+}
+#endif /* _KERNEL */
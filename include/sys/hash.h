@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief      Computes the CRC32C (Castagnoli) checksum of a buffer. Harts
+ *             with the Zbc extension fold the buffer with carry-less
+ *             multiplications.
+ *
+ * @param[in]  crc   The checksum of the preceding data, or 0 to start a new
+ *                   one.
+ * @param[in]  buf   The buffer.
+ * @param[in]  len   The number of bytes in the buffer.
+ *
+ * @return     The checksum of the preceding data followed by the buffer.
+ */
+uint32_t crc32c(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * @brief      Hashes a key into 64 bits. The hash is fast for short keys and
+ *             well distributed, but not cryptographic. It is the XXH3-64
+ *             hash of the key with the given seed.
+ *
+ * @param[in]  key   The key.
+ * @param[in]  len   The number of bytes in the key.
+ * @param[in]  seed  The seed, which selects one of many unrelated hash
+ *                   functions.
+ *
+ * @return     The hash.
+ */
+uint64_t hash64(const void *key, size_t len, uint64_t seed);
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/* Hardware capabilities. As in the misa CSR, bit N stands for the
+ * single-letter ISA extension whose letter is N places after 'A'. */
+#define HWCAP_ISA(letter) (1UL << ((letter) - 'A'))
+#define HWCAP_ISA_MASK (HWCAP_ISA('Z') * 2 - 1)
+#define HWCAP_ISA_V HWCAP_ISA('V')
+
+/* Multi-letter extensions, which misa cannot report. */
+#define HWCAP_ZBB (1UL << 32U) /* Basic bit manipulation. */
+#define HWCAP_ZBC (1UL << 33U) /* Carry-less multiplication. */
+#define HWCAP_ZICBOM (1UL << 34U) /* Cache-block management. */
+#define HWCAP_ZICBOZ (1UL << 35U) /* Cache-block zeroing. */
+#define HWCAP_ZIHINTPAUSE (1UL << 36U) /* Pause hint. */
+
+/* Hardware capabilities the C library was initialized with. */
+extern unsigned long libc_hwcap;
+
+/**
+ * @brief      Tells the C library which hardware capabilities it may use. It
+ *             must be called before any other library function, and only
+ *             once.
+ *
+ * @param[in]  hwcap  The hardware capabilities, as a combination of the
+ *                    HWCAP_* flags.
+ */
+void libc_init(unsigned long hwcap);
+
+#ifdef _KERNEL
+/**
+ * @brief      Detects the hardware capabilities of the current hart.
+ *
+ * @param[in]  fdt   The flattened device tree passed by the firmware, or NULL
+ *                   if there is none. Multi-letter extensions are only
+ *                   detected if it is given.
+ *
+ * @return     The hardware capabilities, as a combination of the HWCAP_*
+ *             flags.
+ */
+unsigned long hwcap_probe(const void *fdt);
+#endif /* _KERNEL */
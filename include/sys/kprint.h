@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Type of a kprint() field. */
+enum kp_type {
+    KP_END = 0, /* End of the field list. */
+    KP_LIT, /* String of known length. */
+    KP_STR, /* NUL-terminated string. */
+    KP_CHAR, /* Single character. */
+    KP_DEC, /* Signed decimal integer. */
+    KP_UDEC, /* Unsigned decimal integer. */
+    KP_HEX, /* Hexadecimal integer, zero-padded. */
+};
+
+/* A typed field to be printed by kprint(). */
+struct kp_field {
+    enum kp_type type;
+    /* Minimum width of the field. It is right-aligned unless negative. */
+    int width;
+    /* Length of a KP_LIT field. */
+    size_t len;
+    union {
+        const char *s;
+        intmax_t d;
+        uintmax_t u;
+    } val;
+};
+
+/* A string literal, whose length is known at compile time. */
+#define KP_S(lit)                                                              \
+    { .type = KP_LIT, .len = sizeof(lit) - 1, .val.s = (lit) }
+/* A NUL-terminated string. */
+#define KP_STRING(str)                                                         \
+    { .type = KP_STR, .val.s = (str) }
+/* A single character. */
+#define KP_C(c)                                                                \
+    { .type = KP_CHAR, .val.u = (unsigned char)(c) }
+/* A signed decimal integer, padded with spaces to @p w characters (on the
+ * right if @p w is negative). */
+#define KP_D(v, w)                                                             \
+    { .type = KP_DEC, .width = (w), .val.d = (intmax_t)(v) }
+/* An unsigned decimal integer, padded like KP_D(). */
+#define KP_U(v, w)                                                             \
+    { .type = KP_UDEC, .width = (w), .val.u = (uintmax_t)(v) }
+/* A hexadecimal integer, padded with zeros to @p w digits (or with spaces
+ * on the right if @p w is negative). */
+#define KP_X(v, w)                                                             \
+    { .type = KP_HEX, .width = (w), .val.u = (uintmax_t)(v) }
+
+/**
+ * @brief      Prints a list of typed fields to a stream. No format string is
+ *             involved, so nothing is parsed at runtime.
+ *
+ * @param[in]  stream  The stream.
+ * @param[in]  fields  The fields, terminated by one of type KP_END.
+ *
+ * @return     On success, the number of characters written is returned.
+ *             Otherwise, a negative value is returned and the value of
+ *             @ref errno is set to reflect the error.
+ */
+int kprint_fields(FILE *stream, const struct kp_field *fields);
+
+/* Prints fields built with the KP_*() macros to a stream. For instance,
+ * kfprint(stderr, KP_S("x="), KP_X(x, 8)) is the same as
+ * fprintf(stderr, "x=%08x", x). */
+#define kfprint(stream, ...)                                                   \
+    kprint_fields((stream),                                                    \
+        (const struct kp_field[]) { __VA_ARGS__, { .type = KP_END } })
+
+/* Prints fields built with the KP_*() macros to the standard output
+ * stream. */
+#define kprint(...) kfprint(stdout, __VA_ARGS__)
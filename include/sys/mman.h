@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <sys/types.h>
+
+/* Protection of a mapping. */
+#define PROT_NONE 0x0
+#define PROT_READ 0x1
+#define PROT_WRITE 0x2
+#define PROT_EXEC 0x4
+
+/* Kind of a mapping. Anonymous mappings are backed by no file, and are
+ * filled with zeros. */
+#define MAP_SHARED 0x01
+#define MAP_PRIVATE 0x02
+#define MAP_ANONYMOUS 0x20
+
+/* Value returned by mmap() on error. */
+#define MAP_FAILED ((void *)-1)
+
+/**
+ * @brief      Maps memory into the address space of the process.
+ *
+ * @param      addr    A hint of where to place the mapping, or NULL.
+ * @param[in]  length  The length of the mapping.
+ * @param[in]  prot    The protection of the mapping (PROT_*).
+ * @param[in]  flags   The kind of the mapping (MAP_*).
+ * @param[in]  fd      The file to be mapped, or -1 for anonymous mappings.
+ * @param[in]  offset  The offset into the file.
+ *
+ * @return     On success, the address of the mapping, which is aligned to a
+ *             page; otherwise, MAP_FAILED is returned and @ref errno is set
+ *             accordingly.
+ */
+void *mmap(
+    void *addr, size_t length, int prot, int flags, int fd, off_t offset);
+
+/**
+ * @brief      Removes the mappings for the pages of a range of addresses.
+ *
+ * @param      addr    The first address of the range, aligned to a page.
+ * @param[in]  length  The length of the range.
+ *
+ * @return     On success, 0; otherwise, -1 is returned and @ref errno is set
+ *             accordingly.
+ */
+int munmap(void *addr, size_t length);
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifdef _KERNEL
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/bitops.h>
+#include <sys/param.h>
+
+/* Largest order of a block of pages. Blocks of order n are made of 2^n
+ * contiguous pages, aligned to their size. */
+#define PAGE_MAX_ORDER 10U
+
+/* Capacity of the cache of single pages of each hart, and default low and
+ * high watermarks. */
+#define PAGE_CACHE_MAX 256U
+#define PAGE_CACHE_LOW 16U
+#define PAGE_CACHE_HIGH 64U
+
+/* Counters of the caches of single pages. */
+struct page_cache_stats {
+    size_t alloc_hits; /* Allocations served from the cache. */
+    size_t alloc_misses; /* Allocations that had to refill it. */
+    size_t free_hits; /* Frees kept in the cache. */
+    size_t free_misses; /* Frees that had to drain it. */
+};
+
+/**
+ * @brief      Obtains the order of the smallest block of pages that can hold
+ *             a number of bytes.
+ *
+ * @param[in]  size  The number of bytes.
+ *
+ * @return     The order.
+ */
+static inline unsigned page_order(size_t size)
+{
+    return size <= PAGE_SIZE ? 0 : fls64((size - 1) >> PAGE_SHIFT);
+}
+
+/**
+ * @brief      Sets up the page allocator for a range of physical memory. Its
+ *             metadata is placed at the start of the range, and every page
+ *             stays reserved until it is handed over with page_add().
+ *
+ * @param[in]  start  The first address of the range.
+ * @param[in]  end    The address past the end of the range.
+ */
+void page_init(uintptr_t start, uintptr_t end);
+
+/**
+ * @brief      Makes the pages within a range of physical memory available
+ *             for allocation. Parts of the range outside of the one given to
+ *             page_init(), or taken by its metadata, are ignored.
+ *
+ * @param[in]  start  The first address of the range.
+ * @param[in]  end    The address past the end of the range.
+ */
+void page_add(uintptr_t start, uintptr_t end);
+
+/**
+ * @brief      Allocates a block of contiguous pages.
+ *
+ * @param[in]  order  The order of the block, up to PAGE_MAX_ORDER.
+ *
+ * @return     The address of the block, which is aligned to its size, or
+ *             NULL if there is no free block that large.
+ */
+void *page_alloc(unsigned order);
+
+/**
+ * @brief      Frees a block of pages obtained from page_alloc().
+ *
+ * @param      addr   The address of the block.
+ * @param[in]  order  The order the block was allocated with.
+ */
+void page_free(void *addr, unsigned order);
+
+/**
+ * @brief      Turns an allocated block of pages into as many allocated
+ *             blocks of order 0, so that they can be freed one by one.
+ *
+ * @param      addr   The address of the block.
+ * @param[in]  order  The order the block was allocated with.
+ */
+void page_split(void *addr, unsigned order);
+
+/**
+ * @brief      Records the owner of every page of an allocated block, so that
+ *             it can be found from any address within the block.
+ *
+ * @param      addr   The address of the block.
+ * @param[in]  order  The order of the block.
+ * @param      owner  The owner, which is opaque to the page allocator.
+ */
+void page_set_owner(void *addr, unsigned order, void *owner);
+
+/**
+ * @brief      Obtains the owner of the page that holds an address, as set by
+ *             page_set_owner().
+ *
+ * @param[in]  addr  An address within a block that has an owner.
+ *
+ * @return     The owner.
+ */
+void *page_owner(const void *addr);
+
+/**
+ * @brief      Sets the watermarks of the caches of single pages. An empty
+ *             cache is refilled with up to low pages from the global free
+ *             lists, and a cache that holds high pages is drained down to
+ *             low pages. A high watermark of 0 disables the caches.
+ *
+ * @param[in]  low   The low watermark, which is kept below the high one.
+ * @param[in]  high  The high watermark, up to PAGE_CACHE_MAX.
+ */
+void page_cache_tune(unsigned low, unsigned high);
+
+/**
+ * @brief      Obtains the counters of the caches of single pages, added up
+ *             over all harts.
+ *
+ * @param[out] stats  The counters.
+ */
+void page_cache_stats(struct page_cache_stats *stats);
+
+/**
+ * @brief      Obtains the number of pages that are free.
+ *
+ * @return     The number of pages.
+ */
+size_t page_free_count(void);
+#endif /* _KERNEL */
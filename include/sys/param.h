@@ -20,3 +20,11 @@
 /* Macros for min/max. */
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+/* Size of a page of memory. */
+#define PAGE_SHIFT 12U
+#define PAGE_SIZE (1UL << PAGE_SHIFT)
+
+/* Size of a line of the data caches, which is 64 bytes on every core that is
+ * likely to run this. */
+#define CACHE_LINE_SIZE 64
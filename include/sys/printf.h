@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdarg.h> /* va_list */
+#include <stdint.h>
+
+/* Maximum number of operations in a compiled format string. */
+#define PRINTF_OPS_MAX 16
+
+/* A single operation of a compiled format string: a literal span followed by
+ * an optional conversion specifier. */
+struct printf_op {
+    const char *lit; /* Literal text preceding the conversion. */
+    uint16_t lit_len; /* Length of the literal text. */
+    uint8_t flags; /* Conversion flags. */
+    uint8_t len; /* Argument length modifier. */
+    uint8_t has_width; /* Whether a field width was specified. */
+    uint8_t has_prec; /* Whether a precision was specified. */
+    char conv; /* Conversion character, or '\0' for a trailing literal. */
+    uint32_t width; /* Minimum field width. */
+    uint32_t prec; /* Precision. */
+};
+
+/* A format string compiled by @ref printf_compile. */
+struct printf_fmt {
+    /* Number of operations in @ref ops. Zero if the format string has not
+     * been compiled yet, negative if compilation failed or, for
+     * @ref printf_cached, is under way. */
+    int nops;
+    struct printf_op ops[PRINTF_OPS_MAX];
+};
+
+/**
+ * @brief      Compiles a format string so it can be used repeatedly without
+ *             parsing it again.
+ *
+ * @param[out] pf    The compiled format string.
+ * @param[in]  fmt   The format string. It must outlive @p pf, since literal
+ *                   spans point into it.
+ *
+ * @return     On success, the number of operations in @p pf. Otherwise, a
+ *             negative value is returned and @ref errno is set accordingly.
+ */
+int printf_compile(struct printf_fmt *pf, const char *fmt);
+
+/**
+ * @brief      Write a string formatted with a compiled format string to the
+ *             standard output stream.
+ *
+ * @param[in]  pf    The compiled format string.
+ * @param[in]  args  Argument list used for formatting.
+ *
+ * @return     On success, the number of characters written is returned.
+ *             Otherwise, a negative value is returned and the value of
+ *             @ref errno is set to reflect the error.
+ */
+int vprintf_compiled(const struct printf_fmt *pf, va_list args);
+
+/**
+ * @brief      Write a string formatted with a compiled format string to the
+ *             standard output stream.
+ *
+ * @param[in]  pf    The compiled format string.
+ *
+ * @return     See @ref vprintf_compiled.
+ */
+int printf_compiled(const struct printf_fmt *pf, ...);
+
+/**
+ * @brief      Write a formatted string to the standard output stream,
+ *             compiling the format string into @p pf on first use.
+ *
+ * A format string is only compiled once, even if it cannot be, and calls
+ * that find it being compiled by another hart parse it themselves.
+ *
+ * @param      pf    Storage for the compiled format string, which must be
+ *                   zero-initialized before the first call.
+ * @param[in]  fmt   String to be used to format the output. It must be the
+ *                   same on every call with the same @p pf.
+ *
+ * @return     See @ref vprintf_compiled.
+ */
+int printf_cached(struct printf_fmt *pf, const char *fmt, ...);
+
+/* Like printf(), but the format string is compiled once and cached in static
+ * storage private to the call site. The format string must be constant. */
+#define PRINTF_CACHED(...)                                                     \
+    do {                                                                       \
+        static struct printf_fmt printf_cached_fmt_;                           \
+        printf_cached(&printf_cached_fmt_, __VA_ARGS__);                       \
+    } while (0)
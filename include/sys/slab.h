@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifdef _KERNEL
+#include <stddef.h>
+
+/* Largest size served by the kmalloc() size classes. Larger requests take
+ * whole blocks of pages. */
+#define KMALLOC_MAX_CACHE_SIZE 4096U
+
+/* Cache of objects of a single size, carved out of slabs of pages. */
+struct kmem_cache;
+
+/**
+ * @brief      Sets up the slab allocator and the kmalloc() size classes. It
+ *             must be called once the page allocator is ready.
+ */
+void slab_init(void);
+
+/**
+ * @brief      Creates a cache of objects.
+ *
+ * @param[in]  name   The name of the cache, which must outlive it.
+ * @param[in]  size   The size of each object.
+ * @param[in]  align  The alignment of each object, a power of two, or 0 for
+ *                    that of a pointer.
+ * @param[in]  ctor   A function that initializes each object when its slab
+ *                    is created, or NULL. Objects must be returned to the
+ *                    cache in the same state, since it is not run again.
+ *
+ * @return     The cache, or NULL if there was no memory for it or its
+ *             objects are too large for a slab.
+ */
+struct kmem_cache *kmem_cache_create(
+    const char *name, size_t size, size_t align, void (*ctor)(void *));
+
+/**
+ * @brief      Allocates an object from a cache.
+ *
+ * @param      cache  The cache.
+ *
+ * @return     The object, or NULL if there was no memory for it.
+ */
+void *kmem_cache_alloc(struct kmem_cache *cache);
+
+/**
+ * @brief      Returns an object to the cache it was allocated from.
+ *
+ * @param      cache  The cache.
+ * @param      obj    The object.
+ */
+void kmem_cache_free(struct kmem_cache *cache, void *obj);
+
+/**
+ * @brief      Allocates memory.
+ *
+ * @param[in]  size  The number of bytes.
+ *
+ * @return     The memory, aligned to 16 bytes, or NULL if there was not
+ *             enough.
+ */
+void *kmalloc(size_t size);
+
+/**
+ * @brief      Frees memory obtained from kmalloc().
+ *
+ * @param      ptr   The memory, or NULL.
+ */
+void kfree(void *ptr);
+#endif /* _KERNEL */
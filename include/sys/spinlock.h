@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/* A lock that waits by spinning, for short critical sections that may run
+ * on several harts at once. */
+typedef struct {
+    uint32_t locked;
+} spinlock_t;
+
+#define SPINLOCK_INIT { 0 }
+
+/**
+ * @brief      Tells the hart that it is spinning, so that it may save power or
+ *             yield to another thread of the same core.
+ */
+static inline void cpu_relax(void)
+{
+#ifdef __riscv
+    /* The Zihintpause hint, which other harts take as a no-op. */
+    __asm__ volatile(".insn i 0x0f, 0, x0, x0, 0x010");
+#endif
+}
+
+/**
+ * @brief      Acquires a lock, waiting for as long as another hart holds it.
+ *
+ * @param      lock  The lock.
+ */
+static inline void spin_lock(spinlock_t *lock)
+{
+    while (__atomic_exchange_n(&lock->locked, 1, __ATOMIC_ACQUIRE) != 0) {
+        /* Wait for the lock to look free before trying again, so that the
+         * cache line is not bounced around by the swaps. */
+        while (__atomic_load_n(&lock->locked, __ATOMIC_RELAXED) != 0) {
+            cpu_relax();
+        }
+    }
+}
+
+/**
+ * @brief      Releases a lock held by the current hart.
+ *
+ * @param      lock  The lock.
+ */
+static inline void spin_unlock(spinlock_t *lock)
+{
+    __atomic_store_n(&lock->locked, 0, __ATOMIC_RELEASE);
+}
@@ -20,3 +20,4 @@
 #include <stddef.h> /* size_t */
 
 typedef long ssize_t;
+typedef long off_t;
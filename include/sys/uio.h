@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h> /* size_t */
+#include <sys/types.h> /* ssize_t */
+
+/* A buffer to be written by writev(). */
+struct iovec {
+    void *iov_base; /* Base address of the buffer. */
+    size_t iov_len; /* Length of the buffer in bytes. */
+};
+
+/**
+ * @brief      Write the buffers described by @ref iov, in order, to the file
+ *             associated with the open file descriptor @ref fd. This is
+ *             equivalent to a single write() of their concatenation.
+ *
+ * @param[in]  fd      Open file descriptor of the destination stream.
+ * @param[in]  iov     The buffers to be written.
+ * @param[in]  iovcnt  The number of buffers, which must be positive and no
+ *                     greater than @ref IOV_MAX.
+ *
+ * @return     On success, the number of bytes written to the destination
+ *             stream; otherwise, -1 will be returned and @ref errno will be
+ *             set accordingly.
+ */
+ssize_t writev(int fd, const struct iovec *iov, int iovcnt);
@@ -19,6 +19,12 @@
 
 #include <stddef.h>
 #include <sys/types.h>
+#include <sys/uio.h> /* struct iovec, writev() */
+
+/* File descriptors of the standard streams. */
+#define STDIN_FILENO 0
+#define STDOUT_FILENO 1
+#define STDERR_FILENO 2
 
 /**
  * @brief      Write @ref count bytes from the buffer pointed to by @ref buf
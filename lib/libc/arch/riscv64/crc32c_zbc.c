@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../crc32c_impl.h"
+
+/* Zbc instructions, which the compiler does not generate on its own. */
+static inline uint64_t clmul(uint64_t a, uint64_t b)
+{
+    uint64_t r;
+    __asm__("clmul %0, %1, %2" : "=r"(r) : "r"(a), "r"(b));
+    return r;
+}
+
+static inline uint64_t clmulh(uint64_t a, uint64_t b)
+{
+    uint64_t r;
+    __asm__("clmulh %0, %1, %2" : "=r"(r) : "r"(a), "r"(b));
+    return r;
+}
+
+#include "../../crc32c_clmul.h"
+
+uint32_t crc32c_zbc(uint32_t crc, const unsigned char *buf, size_t len)
+{
+    return crc32c_fold(crc, buf, len);
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crc32c_impl.h"
+#include "crc32c_table.h"
+#include "string_impl.h"
+#include <sys/hash.h>
+#include <sys/hwcap.h>
+#include <sys/init.h>
+
+uint32_t crc32c_generic(uint32_t crc, const unsigned char *buf, size_t len)
+{
+#ifdef STRING_WORD
+    const string_word *w;
+    uint64_t v;
+
+    while (len > 0 && (uintptr_t)buf % WORD_SIZE != 0) {
+        crc = (crc >> 8U) ^ crc32c_table[0][(crc ^ *buf++) & 0xffU];
+        len--;
+    }
+    /* Each table gives the contribution of a byte that is followed by as
+     * many bytes as its index, so the eight of a word are looked up at
+     * once. */
+    for (w = (const string_word *)buf; len >= WORD_SIZE; len -= WORD_SIZE) {
+        v = *w++ ^ crc;
+        crc = crc32c_table[7][v & 0xffU] ^ crc32c_table[6][(v >> 8U) & 0xffU]
+            ^ crc32c_table[5][(v >> 16U) & 0xffU]
+            ^ crc32c_table[4][(v >> 24U) & 0xffU]
+            ^ crc32c_table[3][(v >> 32U) & 0xffU]
+            ^ crc32c_table[2][(v >> 40U) & 0xffU]
+            ^ crc32c_table[1][(v >> 48U) & 0xffU]
+            ^ crc32c_table[0][v >> 56U];
+    }
+    buf = (const unsigned char *)w;
+#endif
+    while (len-- > 0) {
+        crc = (crc >> 8U) ^ crc32c_table[0][(crc ^ *buf++) & 0xffU];
+    }
+    return crc;
+}
+
+/* Implementation in use, chosen by crc32c_init(). */
+static uint32_t (*crc32c_impl)(uint32_t crc, const unsigned char *buf,
+    size_t len) __ro_after_init = crc32c_generic;
+
+void crc32c_init(unsigned long hwcap)
+{
+#ifdef CRC32C_RISCV64
+    if (hwcap & HWCAP_ZBC) {
+        crc32c_impl = crc32c_zbc;
+    }
+#endif
+}
+
+uint32_t crc32c(uint32_t crc, const void *buf, size_t len)
+{
+    return ~crc32c_impl(~crc, buf, len);
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "crc32c_impl.h"
+#include "crc32c_table.h"
+#include "string_impl.h"
+
+/* Carry-less multiplication folding, shared by the implementations for each
+ * architecture. The includer defines clmul() and clmulh(), which return the
+ * low and high halves of the carry-less product of two words. */
+
+/* Buffers shorter than this are not worth folding. */
+#define CRC32C_FOLD_MIN 64
+
+/**
+ * @brief      Updates a CRC32C register with a buffer, folding it 128 bits at a
+ *             time with carry-less multiplications.
+ *
+ * @param[in]  crc   The CRC register.
+ * @param[in]  buf   The buffer.
+ * @param[in]  len   The number of bytes in the buffer.
+ *
+ * @return     The updated CRC register.
+ */
+static inline uint32_t crc32c_fold(
+    uint32_t crc, const unsigned char *buf, size_t len)
+{
+    size_t head = -(uintptr_t)buf % WORD_SIZE;
+    const string_word *w;
+    uint64_t s0, s1, n0;
+
+    if (len < head + CRC32C_FOLD_MIN) {
+        return crc32c_generic(crc, buf, len);
+    }
+    crc = crc32c_generic(crc, buf, head);
+    len -= head;
+    w = (const string_word *)(buf + head);
+
+    /* The 128-bit state is congruent, modulo the polynomial, with the
+     * message read so far. Each block moves it 128 bits forward and adds the
+     * next two words. */
+    s0 = w[0] ^ crc;
+    s1 = w[1];
+    for (w += 2, len -= 16; len >= 16; w += 2, len -= 16) {
+        n0 = clmul(s0, CRC32C_K192) ^ clmul(s1, CRC32C_K128) ^ w[0];
+        s1 = clmulh(s0, CRC32C_K192) ^ clmulh(s1, CRC32C_K128) ^ w[1];
+        s0 = n0;
+    }
+
+    /* Fold the first word into the second one, in two steps so that the
+     * product fits in 64 bits, and let the tables reduce what is left. */
+    s1 ^= clmulh(s0, CRC32C_K64);
+    s1 ^= clmulh(clmul(s0, CRC32C_K64), CRC32C_K64);
+    crc = crc32c_generic(0, (const unsigned char *)&s1, sizeof(s1));
+    return crc32c_generic(crc, (const unsigned char *)w, len);
+}
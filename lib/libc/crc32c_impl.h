@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Every implementation works on the CRC register directly: the initial and
+ * final inversions are left to crc32c(). */
+
+/**
+ * @brief      Updates a CRC32C register with a buffer, using the slice-by-8
+ *             tables.
+ *
+ * @param[in]  crc   The CRC register.
+ * @param[in]  buf   The buffer.
+ * @param[in]  len   The number of bytes in the buffer.
+ *
+ * @return     The updated CRC register.
+ */
+uint32_t crc32c_generic(uint32_t crc, const unsigned char *buf, size_t len);
+
+#if defined(__riscv) && __riscv_xlen == 64
+#define CRC32C_RISCV64 1
+
+/* Implementation for harts with the Zbc extension, in arch/riscv64. */
+uint32_t crc32c_zbc(uint32_t crc, const unsigned char *buf, size_t len);
+#endif
+
+/**
+ * @brief      Chooses the best CRC32C implementation for the given hardware
+ *             capabilities.
+ *
+ * @param[in]  hwcap  The hardware capabilities, as HWCAP_* flags.
+ */
+void crc32c_init(unsigned long hwcap);
@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "umul128.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/bitops.h>
+#include <sys/hash.h>
+
+/* hash64() is XXH3-64 with a seed, so its values match those of the
+ * reference implementation. Short keys take a few multiplications, while
+ * keys longer than HASH_MID_MAX bytes go through eight accumulators. */
+
+#define PRIME32_1 0x9e3779b1U
+#define PRIME32_2 0x85ebca77U
+#define PRIME32_3 0xc2b2ae3dU
+#define PRIME64_1 0x9e3779b185ebca87U
+#define PRIME64_2 0xc2b2ae3d27d4eb4fU
+#define PRIME64_3 0x165667b19e3779f9U
+#define PRIME64_4 0x85ebca77c2b2ae63U
+#define PRIME64_5 0x27d4eb2f165667c5U
+#define PRIME_MX1 0x165667919e3779f9U
+#define PRIME_MX2 0x9fb21c651e98df25U
+
+/* Longest key hashed without the accumulators. */
+#define HASH_MID_MAX 240
+/* Bytes consumed by each accumulation round, and secret bytes skipped. */
+#define HASH_STRIPE 64
+#define HASH_SECRET_RATE 8
+#define HASH_SECRET_SIZE 192
+
+/* Default secret of XXH3, from which the seed derives the one in use. */
+static const unsigned char hash_secret[HASH_SECRET_SIZE] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c,
+    0xf7, 0x21, 0xad, 0x1c, 0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb,
+    0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f, 0xcb, 0x79, 0xe6, 0x4e,
+    0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6,
+    0x81, 0x3a, 0x26, 0x4c, 0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb,
+    0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3, 0x71, 0x64, 0x48, 0x97,
+    0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7,
+    0xc7, 0x0b, 0x4f, 0x1d, 0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31,
+    0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64, 0xea, 0xc5, 0xac, 0x83,
+    0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26,
+    0x29, 0xd4, 0x68, 0x9e, 0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc,
+    0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce, 0x45, 0xcb, 0x3a, 0x8f,
+    0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+/* Keys and secrets are read byte by byte, since they may be unaligned and
+ * the hash must not depend on the byte order of the machine. */
+static inline uint32_t read32(const unsigned char *p)
+{
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8U | (uint32_t)p[2] << 16U
+        | (uint32_t)p[3] << 24U;
+}
+
+static inline uint64_t read64(const unsigned char *p)
+{
+    return (uint64_t)read32(p) | (uint64_t)read32(p + 4) << 32U;
+}
+
+static inline uint64_t rotl64(uint64_t x, unsigned n)
+{
+    return (x << n) | (x >> (64U - n));
+}
+
+/* Multiplies two words and folds the 128-bit product into one. */
+static inline uint64_t mul_fold(uint64_t a, uint64_t b)
+{
+    uint64_t hi;
+    uint64_t lo = umul128(a, b, &hi);
+    return lo ^ hi;
+}
+
+/* Final mixes, which spread every input bit over the whole hash. */
+static uint64_t avalanche_xxh64(uint64_t h)
+{
+    h ^= h >> 33U;
+    h *= PRIME64_2;
+    h ^= h >> 29U;
+    h *= PRIME64_3;
+    return h ^ (h >> 32U);
+}
+
+static uint64_t avalanche(uint64_t h)
+{
+    h ^= h >> 37U;
+    h *= PRIME_MX1;
+    return h ^ (h >> 32U);
+}
+
+static uint64_t avalanche_rrmxmx(uint64_t h, size_t len)
+{
+    h ^= rotl64(h, 49U) ^ rotl64(h, 24U);
+    h *= PRIME_MX2;
+    h ^= (h >> 35U) + len;
+    h *= PRIME_MX2;
+    return h ^ (h >> 28U);
+}
+
+static uint64_t hash_0to16(
+    const unsigned char *key, size_t len, const unsigned char *secret,
+    uint64_t seed)
+{
+    uint64_t lo, hi, acc;
+    uint32_t combo;
+
+    if (len > 8) {
+        lo = read64(key) ^ ((read64(secret + 24) ^ read64(secret + 32)) + seed);
+        hi = read64(key + len - 8)
+            ^ ((read64(secret + 40) ^ read64(secret + 48)) - seed);
+        acc = len + bswap64(lo) + hi + mul_fold(lo, hi);
+        return avalanche(acc);
+    }
+    if (len >= 4) {
+        /* Mirror the low half of the seed into the high one. */
+        seed ^= bswap64((uint32_t)seed);
+        acc = read32(key + len - 4) + ((uint64_t)read32(key) << 32U);
+        acc ^= (read64(secret + 8) ^ read64(secret + 16)) - seed;
+        return avalanche_rrmxmx(acc, len);
+    }
+    if (len > 0) {
+        combo = (uint32_t)key[0] << 16U | (uint32_t)key[len >> 1U] << 24U
+            | (uint32_t)key[len - 1] | (uint32_t)len << 8U;
+        acc = (uint64_t)(read32(secret) ^ read32(secret + 4)) + seed;
+        return avalanche_xxh64(combo ^ acc);
+    }
+    return avalanche_xxh64(
+        seed ^ read64(secret + 56) ^ read64(secret + 64));
+}
+
+/* Mixes 16 bytes of the key with 16 bytes of the secret. */
+static inline uint64_t mix16(
+    const unsigned char *key, const unsigned char *secret, uint64_t seed)
+{
+    return mul_fold(read64(key) ^ (read64(secret) + seed),
+        read64(key + 8) ^ (read64(secret + 8) - seed));
+}
+
+static uint64_t hash_17to128(
+    const unsigned char *key, size_t len, const unsigned char *secret,
+    uint64_t seed)
+{
+    uint64_t acc = len * PRIME64_1;
+
+    /* Pairs of blocks are taken from both ends towards the middle. */
+    if (len > 32) {
+        if (len > 64) {
+            if (len > 96) {
+                acc += mix16(key + 48, secret + 96, seed);
+                acc += mix16(key + len - 64, secret + 112, seed);
+            }
+            acc += mix16(key + 32, secret + 64, seed);
+            acc += mix16(key + len - 48, secret + 80, seed);
+        }
+        acc += mix16(key + 16, secret + 32, seed);
+        acc += mix16(key + len - 32, secret + 48, seed);
+    }
+    acc += mix16(key, secret, seed);
+    acc += mix16(key + len - 16, secret + 16, seed);
+    return avalanche(acc);
+}
+
+static uint64_t hash_129to240(
+    const unsigned char *key, size_t len, const unsigned char *secret,
+    uint64_t seed)
+{
+    uint64_t acc = len * PRIME64_1;
+    size_t i;
+
+    for (i = 0; i < 8; i++) {
+        acc += mix16(key + 16 * i, secret + 16 * i, seed);
+    }
+    acc = avalanche(acc);
+    /* The secret is too short for the remaining blocks, so it is reused at
+     * an odd offset. */
+    for (; i < len / 16; i++) {
+        acc += mix16(key + 16 * i, secret + 16 * (i - 8) + 3, seed);
+    }
+    acc += mix16(key + len - 16, secret + 136 - 17, seed);
+    return avalanche(acc);
+}
+
+/* Adds a stripe of the key to the accumulators. */
+static void accumulate(
+    uint64_t acc[8], const unsigned char *key, const unsigned char *secret)
+{
+    uint64_t v, k;
+    size_t i;
+
+    for (i = 0; i < 8; i++) {
+        v = read64(key + 8 * i);
+        k = v ^ read64(secret + 8 * i);
+        acc[i ^ 1U] += v;
+        acc[i] += (k & 0xffffffffU) * (k >> 32U);
+    }
+}
+
+/* Stirs the accumulators after each block of stripes. */
+static void scramble(uint64_t acc[8], const unsigned char *secret)
+{
+    size_t i;
+
+    for (i = 0; i < 8; i++) {
+        acc[i] ^= (acc[i] >> 47U) ^ read64(secret + 8 * i);
+        acc[i] *= PRIME32_1;
+    }
+}
+
+static uint64_t hash_long(const unsigned char *key, size_t len, uint64_t seed)
+{
+    enum { STRIPES = (HASH_SECRET_SIZE - HASH_STRIPE) / HASH_SECRET_RATE };
+    uint64_t acc[8] = { PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4,
+        PRIME32_2, PRIME64_5, PRIME32_1 };
+    unsigned char derived[HASH_SECRET_SIZE];
+    const unsigned char *secret = hash_secret;
+    const unsigned char *last = key + len - HASH_STRIPE;
+    size_t i, j, blocks, stripes;
+    uint64_t h;
+
+    /* A seed shifts every pair of secret words in opposite directions. */
+    if (seed != 0) {
+        for (i = 0; i < HASH_SECRET_SIZE; i += 16) {
+            uint64_t lo = read64(hash_secret + i) + seed;
+            uint64_t hi = read64(hash_secret + i + 8) - seed;
+            for (j = 0; j < 8; j++) {
+                derived[i + j] = (unsigned char)(lo >> (8 * j));
+                derived[i + 8 + j] = (unsigned char)(hi >> (8 * j));
+            }
+        }
+        secret = derived;
+    }
+
+    /* The last byte always goes into the final stripe, which may overlap the
+     * one before it. */
+    blocks = (len - 1) / (HASH_STRIPE * STRIPES);
+    for (i = 0; i < blocks; i++, key += HASH_STRIPE * STRIPES) {
+        for (j = 0; j < STRIPES; j++) {
+            accumulate(
+                acc, key + HASH_STRIPE * j, secret + HASH_SECRET_RATE * j);
+        }
+        scramble(acc, secret + HASH_SECRET_SIZE - HASH_STRIPE);
+    }
+    stripes = (len - 1 - blocks * HASH_STRIPE * STRIPES) / HASH_STRIPE;
+    for (j = 0; j < stripes; j++) {
+        accumulate(acc, key + HASH_STRIPE * j, secret + HASH_SECRET_RATE * j);
+    }
+    accumulate(acc, last, secret + HASH_SECRET_SIZE - HASH_STRIPE - 7);
+
+    h = len * PRIME64_1;
+    for (i = 0; i < 8; i += 2) {
+        h += mul_fold(acc[i] ^ read64(secret + 11 + 8 * i),
+            acc[i + 1] ^ read64(secret + 11 + 8 * i + 8));
+    }
+    return avalanche(h);
+}
+
+uint64_t hash64(const void *key, size_t len, uint64_t seed)
+{
+    const unsigned char *k = key;
+
+    if (len <= 16) {
+        return hash_0to16(k, len, hash_secret, seed);
+    }
+    if (len <= 128) {
+        return hash_17to128(k, len, hash_secret, seed);
+    }
+    if (len <= HASH_MID_MAX) {
+        return hash_129to240(k, len, hash_secret, seed);
+    }
+    return hash_long(k, len, seed);
+}
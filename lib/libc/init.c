@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crc32c_impl.h"
+#include "string_impl.h"
+#include <sys/init.h>
+#include <sys/hwcap.h>
+
+unsigned long libc_hwcap __ro_after_init;
+
+void libc_init(unsigned long hwcap)
+{
+    libc_hwcap = hwcap;
+    /* Resolve the function tables once, so that calls need not test the
+     * capabilities again. */
+    string_init(hwcap);
+    crc32c_init(hwcap);
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <sys/bitops.h>
+
+#include "itoa.h"
+
+/* Two-digit decimal representations of all numbers from 0 to 99. */
+static const char digits2[200] = "00010203040506070809"
+                                 "10111213141516171819"
+                                 "20212223242526272829"
+                                 "30313233343536373839"
+                                 "40414243444546474849"
+                                 "50515253545556575859"
+                                 "60616263646566676869"
+                                 "70717273747576777879"
+                                 "80818283848586878889"
+                                 "90919293949596979899";
+
+static const char lowerhex[16] = "0123456789abcdef";
+static const char upperhex[16] = "0123456789ABCDEF";
+
+/* Powers of ten representable in 64 bits. */
+static const uint64_t powers10[20] = {
+    1U,
+    10U,
+    100U,
+    1000U,
+    10000U,
+    100000U,
+    1000000U,
+    10000000U,
+    100000000U,
+    1000000000U,
+    10000000000U,
+    100000000000U,
+    1000000000000U,
+    10000000000000U,
+    100000000000000U,
+    1000000000000000U,
+    10000000000000000U,
+    100000000000000000U,
+    1000000000000000000U,
+    10000000000000000000U,
+};
+
+unsigned itoa_declen(uint64_t val)
+{
+    /* Setting the lowest bit makes 0 count as a single digit and does not
+     * change the result otherwise, since powers of ten above 1 are even. */
+    uint64_t x = val | 1U;
+    /* 1233 / 4096 approximates log10(2), so this is either the number of
+     * digits minus one or an overestimate of it by one. */
+    unsigned n = (fls64(x) * 1233U) >> 12U;
+    return n + 1 - (x < powers10[n]);
+}
+
+unsigned itoa_dec(char *dst, uint64_t val)
+{
+    unsigned len = itoa_declen(val);
+    char *p = dst + len;
+
+    /* Divisions by a constant are lowered to multiplications, so none of
+     * these loops issues an actual division instruction. */
+    while (val > UINT32_MAX) {
+        uint64_t q = val / 100;
+        unsigned r = (unsigned)(val - q * 100) * 2;
+        p -= 2;
+        p[0] = digits2[r];
+        p[1] = digits2[r + 1];
+        val = q;
+    }
+    /* Finish the conversion with cheaper 32-bit arithmetic. */
+    for (uint32_t v = (uint32_t)val;;) {
+        if (v < 10) {
+            *--p = (char)('0' + v);
+            break;
+        }
+        uint32_t q = v / 100;
+        unsigned r = (v - q * 100) * 2;
+        p -= 2;
+        p[0] = digits2[r];
+        p[1] = digits2[r + 1];
+        if (q == 0) {
+            break;
+        }
+        v = q;
+    }
+    return len;
+}
+
+unsigned itoa_hexlen(uint64_t val) { return (fls64(val | 1U) + 3) / 4; }
+
+unsigned itoa_hex(char *dst, uint64_t val, int upper)
+{
+    const char *digits = upper ? upperhex : lowerhex;
+    unsigned len = itoa_hexlen(val);
+
+    for (unsigned i = len; i > 0; i--, val >>= 4U) {
+        dst[i - 1] = digits[val & 0xFU];
+    }
+    return len;
+}
+
+unsigned itoa_octlen(uint64_t val) { return (fls64(val | 1U) + 2) / 3; }
+
+unsigned itoa_oct(char *dst, uint64_t val)
+{
+    unsigned len = itoa_octlen(val);
+
+    for (unsigned i = len; i > 0; i--, val >>= 3U) {
+        dst[i - 1] = (char)('0' + (val & 7U));
+    }
+    return len;
+}
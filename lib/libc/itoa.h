@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/* Maximum number of digits produced by the conversions below (a 64-bit value
+ * in octal). */
+#define ITOA_MAXLEN 22
+
+/**
+ * @brief      Obtains the number of decimal digits needed to represent a
+ *             value.
+ *
+ * @param[in]  val   The value.
+ *
+ * @return     The number of digits (1 for 0).
+ */
+unsigned itoa_declen(uint64_t val);
+
+/**
+ * @brief      Writes the decimal representation of a value. The digit count
+ *             is computed up front so that digits are written straight to
+ *             their final position, two at a time.
+ *
+ * @param[out] dst   The destination buffer, which must be able to hold
+ *                   @ref itoa_declen(val) characters. It is not
+ *                   NUL-terminated.
+ * @param[in]  val   The value to be converted.
+ *
+ * @return     The number of characters written.
+ */
+unsigned itoa_dec(char *dst, uint64_t val);
+
+/**
+ * @brief      Obtains the number of hexadecimal digits needed to represent a
+ *             value.
+ *
+ * @param[in]  val   The value.
+ *
+ * @return     The number of digits (1 for 0).
+ */
+unsigned itoa_hexlen(uint64_t val);
+
+/**
+ * @brief      Writes the hexadecimal representation of a value.
+ *
+ * @param[out] dst    The destination buffer, which must be able to hold
+ *                    @ref itoa_hexlen(val) characters. It is not
+ *                    NUL-terminated.
+ * @param[in]  val    The value to be converted.
+ * @param[in]  upper  Whether to use uppercase digits.
+ *
+ * @return     The number of characters written.
+ */
+unsigned itoa_hex(char *dst, uint64_t val, int upper);
+
+/**
+ * @brief      Obtains the number of octal digits needed to represent a value.
+ *
+ * @param[in]  val   The value.
+ *
+ * @return     The number of digits (1 for 0).
+ */
+unsigned itoa_octlen(uint64_t val);
+
+/**
+ * @brief      Writes the octal representation of a value.
+ *
+ * @param[out] dst   The destination buffer, which must be able to hold
+ *                   @ref itoa_octlen(val) characters. It is not
+ *                   NUL-terminated.
+ * @param[in]  val   The value to be converted.
+ *
+ * @return     The number of characters written.
+ */
+unsigned itoa_oct(char *dst, uint64_t val);
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/kprint.h>
+
+#include "itoa.h"
+#include "printf_out.h"
+
+int kprint_fields(FILE *stream, const struct kp_field *fields)
+{
+    struct vnprintf_opts opts = { .stream = stream };
+    struct printf_out out;
+    char conv[ITOA_MAXLEN + 1];
+    const char *buf;
+    size_t len, width;
+    char fill;
+
+    out_init(&out, &opts);
+    for (const struct kp_field *f = fields; f->type != KP_END; f++) {
+        fill = ' ';
+        switch (f->type) {
+        case KP_LIT:
+            out_write_ref(&out, f->val.s, f->len);
+            continue;
+        case KP_STR:
+            buf = f->val.s;
+            len = strlen(buf);
+            break;
+        case KP_CHAR:
+            conv[0] = (char)f->val.u;
+            buf = conv;
+            len = 1;
+            break;
+        case KP_DEC:
+            /* Negate in unsigned arithmetic so that INTMAX_MIN does not
+             * overflow. */
+            if (f->val.d < 0) {
+                conv[0] = '-';
+                len = 1 + itoa_dec(conv + 1, 0 - (uintmax_t)f->val.d);
+            } else {
+                len = itoa_dec(conv, (uintmax_t)f->val.d);
+            }
+            buf = conv;
+            break;
+        case KP_UDEC:
+            len = itoa_dec(conv, f->val.u);
+            buf = conv;
+            break;
+        case KP_HEX:
+            len = itoa_hex(conv, f->val.u, 0);
+            buf = conv;
+            /* Digits are only zero-padded on the left. */
+            fill = f->width > 0 ? '0' : ' ';
+            break;
+        default:
+            continue;
+        }
+
+        width = f->width < 0 ? 0 - (size_t)f->width : (size_t)f->width;
+        if (f->width > 0 && len < width) {
+            out_fill(&out, fill, width - len);
+        }
+        if (f->type == KP_STR) {
+            out_write_ref(&out, buf, len);
+        } else {
+            out_write(&out, buf, len);
+        }
+        if (f->width < 0 && len < width) {
+            out_fill(&out, fill, width - len);
+        }
+    }
+    return (int)out_finish(&out);
+}
@@ -0,0 +1,508 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/bitops.h>
+#include <sys/mman.h>
+#include <sys/spinlock.h>
+
+/* Memory allocator. Small requests are rounded up to one of CLASS_COUNT
+ * size classes, and objects of each class are carved out of spans: mappings
+ * of SPAN_SIZE bytes, aligned to their size, that start with a header. The
+ * header of the span that holds an object is thus found by rounding its
+ * address down, which is all free() needs. Larger requests get a mapping of
+ * their own, with a header in the same place.
+ *
+ * Each thread keeps a cache of free objects of every class, which it alone
+ * touches, so that most calls take no lock. Objects freed to it are kept in
+ * a list, and objects that were never handed out, taken from the end of a
+ * span as a range, are still zero-filled as mapped, which calloc() makes
+ * use of. An empty cache is refilled, and a full one flushed, by half of
+ * its capacity at a time under the lock of the class. The caches of
+ * threads that exit are not given back.
+ *
+ * A freestanding library has no thread-local storage, but the kernel keeps
+ * the hart ID in the thread pointer, so each hart is given a set of caches
+ * by its ID instead. Harts with no set of their own take the lock of the
+ * class on every call. */
+
+/* Alignment of every allocation. */
+#define MALLOC_ALIGN 16U
+/* Granularity of mappings. Only the smallest page size matters. */
+#define MALLOC_PAGE 4096U
+
+#define SPAN_SHIFT 17U
+#define SPAN_SIZE ((size_t)1 << SPAN_SHIFT)
+/* Offset of the first object of a span past its header. Objects of classes
+ * that are multiples of this are aligned to it. */
+#define SPAN_DATA 64U
+
+/* Size classes: multiples of 16 bytes up to 128, then four for each power
+ * of two up to SMALL_MAX, so that no more than a fifth of an object goes
+ * to waste past 128 bytes. */
+#define SMALL_MAX 16384U
+#define CLASS_COUNT 36U
+/* Class of the header of a mapping of its own. */
+#define CLASS_LARGE CLASS_COUNT
+
+/* Capacity of the cache of each class, in objects and in bytes. */
+#define TCACHE_MAX 64U
+#define TCACHE_BYTES 32768U
+
+/* Number of sets of caches, one for each thread or hart. */
+#if __STDC_HOSTED__
+#define MALLOC_THREAD __thread
+#define TCACHE_SETS 1U
+#else
+#define MALLOC_THREAD
+#define TCACHE_SETS 8U
+#endif
+
+struct span {
+    /* Size class of the objects, or CLASS_LARGE. */
+    unsigned cls;
+    /* Number of objects handed out to caches. */
+    unsigned used;
+    /* Neighbours in the list of partial spans of the class. */
+    struct span *next;
+    struct span *prev;
+    /* Objects given back, linked through their first word. */
+    void *free;
+    /* Objects never handed out, from fresh up to end. */
+    char *fresh;
+    char *end;
+    /* Mapping of a large allocation. */
+    void *base;
+    size_t len;
+};
+
+/* Spans of a class shared by all threads, each on a cache line of its
+ * own. */
+struct central {
+    spinlock_t lock;
+    /* Spans with objects to hand out, in their free lists or fresh. */
+    struct span *partial;
+    /* A span with no objects handed out, kept to avoid mapping it anew.
+     * Any other such span is unmapped at once. */
+    struct span *empty;
+} __attribute__((__aligned__(64)));
+
+/* Cache of free objects of a class of a thread. */
+struct tcache_bin {
+    void *list;
+    unsigned count;
+    /* Range of objects that were never handed out. */
+    char *fresh;
+    char *fresh_end;
+};
+
+static struct central centrals[CLASS_COUNT];
+static MALLOC_THREAD struct tcache_bin tcache[TCACHE_SETS][CLASS_COUNT];
+
+/**
+ * @brief      Obtains the size class of a small request.
+ *
+ * @param[in]  size  The number of bytes, up to SMALL_MAX.
+ *
+ * @return     The class.
+ */
+static unsigned size_class(size_t size)
+{
+    unsigned b;
+
+    if (size <= 128) {
+        return size == 0 ? 0 : (unsigned)(size - 1) / 16;
+    }
+    /* Classes 5 << (b - 3) to 8 << (b - 3) share the same b. */
+    b = fls64(size - 1);
+    return 4 * b - 28 + (unsigned)((size - 1) >> (b - 3));
+}
+
+static size_t class_size(unsigned cls)
+{
+    if (cls < 8) {
+        return 16 * (cls + 1);
+    }
+    cls -= 8;
+    return (size_t)(5 + cls % 4) << (cls / 4 + 5);
+}
+
+/* Number of objects of a class that a cache holds before it is flushed. */
+static unsigned tcache_max(unsigned cls)
+{
+    size_t n = TCACHE_BYTES / class_size(cls);
+    return n < 2 ? 2 : n > TCACHE_MAX ? TCACHE_MAX : (unsigned)n;
+}
+
+/**
+ * @brief      Obtains the caches of the calling thread.
+ *
+ * @return     The cache of every class, or NULL if the hart has none.
+ */
+static struct tcache_bin *tcache_get(void)
+{
+#if !__STDC_HOSTED__ && defined(__riscv)
+    unsigned long id;
+    __asm__("mv %0, tp" : "=r"(id));
+    return id < TCACHE_SETS ? tcache[id] : NULL;
+#else
+    return tcache[0];
+#endif
+}
+
+static struct span *span_of(const void *ptr)
+{
+    return (struct span *)(((uintptr_t)ptr - 1) & ~(SPAN_SIZE - 1));
+}
+
+/**
+ * @brief      Maps zero-filled memory.
+ *
+ * @param[in]  len    The length of the mapping, a multiple of MALLOC_PAGE.
+ * @param[in]  align  The alignment of the mapping, a power of two.
+ *
+ * @return     The mapping, or NULL if there was not enough memory.
+ */
+static void *map_aligned(size_t len, size_t align)
+{
+    char *p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    size_t extra = align - MALLOC_PAGE;
+    uintptr_t a;
+
+    if (p == MAP_FAILED) {
+        return NULL;
+    }
+    if ((uintptr_t)p % align == 0) {
+        return p;
+    }
+    /* Map enough to find an aligned range in, and unmap the rest. */
+    munmap(p, len);
+    if (len > SIZE_MAX - extra) {
+        return NULL;
+    }
+    p = mmap(NULL, len + extra, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        return NULL;
+    }
+    a = ((uintptr_t)p + align - 1) & ~(align - 1);
+    if (a > (uintptr_t)p) {
+        munmap(p, a - (uintptr_t)p);
+    }
+    if (a < (uintptr_t)p + extra) {
+        munmap((void *)(a + len), (uintptr_t)p + extra - a);
+    }
+    return (void *)a;
+}
+
+static void span_push(struct central *c, struct span *s)
+{
+    s->prev = NULL;
+    s->next = c->partial;
+    if (s->next != NULL) {
+        s->next->prev = s;
+    }
+    c->partial = s;
+}
+
+static void span_remove(struct central *c, struct span *s)
+{
+    if (s->prev != NULL) {
+        s->prev->next = s->next;
+    } else {
+        c->partial = s->next;
+    }
+    if (s->next != NULL) {
+        s->next->prev = s->prev;
+    }
+}
+
+/**
+ * @brief      Fills an empty cache with objects of a class, either given back
+ *             or fresh, but not both.
+ *
+ * @param      bin   The cache.
+ * @param[in]  cls   The class.
+ * @param[in]  want  The number of objects to take, at most.
+ *
+ * @return     0 on success, or -1 if there was no memory for a new span.
+ */
+static int tcache_refill(struct tcache_bin *bin, unsigned cls, unsigned want)
+{
+    struct central *c = &centrals[cls];
+    size_t size = class_size(cls);
+    unsigned n = 0;
+    struct span *s;
+    void *obj;
+
+    spin_lock(&c->lock);
+    if ((s = c->partial) == NULL) {
+        if (c->empty != NULL) {
+            s = c->empty;
+            c->empty = NULL;
+        } else if ((s = map_aligned(SPAN_SIZE, SPAN_SIZE)) != NULL) {
+            s->cls = cls;
+            s->used = 0;
+            s->free = NULL;
+            s->fresh = (char *)s + SPAN_DATA;
+            s->end = s->fresh + (SPAN_SIZE - SPAN_DATA) / size * size;
+        } else {
+            spin_unlock(&c->lock);
+            errno = ENOMEM;
+            return -1;
+        }
+        span_push(c, s);
+    }
+    if (s->free != NULL) {
+        for (; n < want && (obj = s->free) != NULL; n++) {
+            s->free = *(void **)obj;
+            *(void **)obj = bin->list;
+            bin->list = obj;
+        }
+        bin->count = n;
+    } else {
+        n = (unsigned)((size_t)(s->end - s->fresh) / size);
+        n = n < want ? n : want;
+        bin->fresh = s->fresh;
+        s->fresh += n * size;
+        bin->fresh_end = s->fresh;
+    }
+    s->used += n;
+    if (s->free == NULL && s->fresh == s->end) {
+        span_remove(c, s);
+    }
+    spin_unlock(&c->lock);
+    return 0;
+}
+
+/**
+ * @brief      Gives objects in the list of a cache back to their spans.
+ *
+ * @param      bin   The cache.
+ * @param[in]  cls   The class.
+ * @param[in]  n     The number of objects, no more than are in the list.
+ */
+static void tcache_flush(struct tcache_bin *bin, unsigned cls, unsigned n)
+{
+    struct central *c = &centrals[cls];
+    struct span *s;
+    void *obj;
+
+    spin_lock(&c->lock);
+    for (; n > 0; n--, bin->count--) {
+        obj = bin->list;
+        bin->list = *(void **)obj;
+        s = span_of(obj);
+        if (s->free == NULL && s->fresh == s->end) {
+            span_push(c, s);
+        }
+        *(void **)obj = s->free;
+        s->free = obj;
+        if (--s->used == 0) {
+            span_remove(c, s);
+            if (c->empty == NULL) {
+                c->empty = s;
+            } else {
+                munmap(s, SPAN_SIZE);
+            }
+        }
+    }
+    spin_unlock(&c->lock);
+}
+
+/**
+ * @brief      Allocates an object of a class from the cache of the thread.
+ *
+ * @param[in]  cls   The class.
+ * @param[out] zero  Set to whether the object is known to be zero-filled.
+ *
+ * @return     The object, or NULL if there was not enough memory.
+ */
+static void *small_alloc(unsigned cls, int *zero)
+{
+    struct tcache_bin *bins = tcache_get(), one = { 0 };
+    struct tcache_bin *bin = bins != NULL ? &bins[cls] : &one;
+    void *obj;
+
+    if (bin->list == NULL && bin->fresh == bin->fresh_end
+        && tcache_refill(bin, cls, bins != NULL ? tcache_max(cls) / 2 : 1)
+            != 0) {
+        return NULL;
+    }
+    if ((obj = bin->list) != NULL) {
+        bin->list = *(void **)obj;
+        bin->count--;
+        *zero = 0;
+        return obj;
+    }
+    obj = bin->fresh;
+    bin->fresh += class_size(cls);
+    *zero = 1;
+    return obj;
+}
+
+static void small_free(void *obj, unsigned cls)
+{
+    struct tcache_bin *bins = tcache_get(), one = { 0 };
+    struct tcache_bin *bin = bins != NULL ? &bins[cls] : &one;
+
+    *(void **)obj = bin->list;
+    bin->list = obj;
+    if (bins == NULL) {
+        tcache_flush(bin, cls, ++bin->count);
+    } else if (++bin->count > tcache_max(cls)) {
+        tcache_flush(bin, cls, tcache_max(cls) / 2);
+    }
+}
+
+/**
+ * @brief      Allocates a mapping of its own, which is zero-filled.
+ *
+ * @param[in]  size   The number of bytes.
+ * @param[in]  align  The alignment, a power of two no less than MALLOC_ALIGN.
+ *
+ * @return     The allocation, or NULL if there was not enough memory.
+ */
+static void *large_alloc(size_t size, size_t align)
+{
+    /* If the allocation is aligned further than a span, its header goes in
+     * the span right before it. */
+    size_t off = align > SPAN_DATA ? align : SPAN_DATA;
+    size_t len;
+    struct span *s;
+    char *base;
+
+    if (size > SIZE_MAX - off - MALLOC_PAGE) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    len = (off + size + MALLOC_PAGE - 1) & ~(size_t)(MALLOC_PAGE - 1);
+    if ((base = map_aligned(len, align > SPAN_SIZE ? align : SPAN_SIZE))
+        == NULL) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    s = span_of(base + off);
+    s->cls = CLASS_LARGE;
+    s->base = base;
+    s->len = len;
+    return base + off;
+}
+
+void *malloc(size_t size)
+{
+    int zero;
+
+    if (size > SMALL_MAX) {
+        return large_alloc(size, MALLOC_ALIGN);
+    }
+    return small_alloc(size_class(size), &zero);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+    size_t total = nmemb * size;
+    int zero;
+    void *p;
+
+    if (size != 0 && total / size != nmemb) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    if (total > SMALL_MAX) {
+        return large_alloc(total, MALLOC_ALIGN);
+    }
+    /* Objects that were never handed out are still as mapped. */
+    if ((p = small_alloc(size_class(total), &zero)) != NULL && !zero) {
+        memset(p, 0, total);
+    }
+    return p;
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+    unsigned cls;
+    int zero;
+
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (alignment <= MALLOC_ALIGN) {
+        return malloc(size);
+    }
+    if (alignment > SPAN_DATA || size > SMALL_MAX) {
+        return large_alloc(size, alignment);
+    }
+    /* Classes that are multiples of the alignment are aligned to it, and
+     * SMALL_MAX is one. */
+    cls = size_class(size);
+    while (class_size(cls) % alignment != 0) {
+        cls++;
+    }
+    return small_alloc(cls, &zero);
+}
+
+void free(void *ptr)
+{
+    struct span *s;
+
+    if (ptr == NULL) {
+        return;
+    }
+    s = span_of(ptr);
+    if (s->cls == CLASS_LARGE) {
+        munmap(s->base, s->len);
+    } else {
+        small_free(ptr, s->cls);
+    }
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    struct span *s;
+    size_t usable;
+    void *p;
+
+    if (ptr == NULL) {
+        return malloc(size);
+    }
+    s = span_of(ptr);
+    if (s->cls == CLASS_LARGE) {
+        usable = (size_t)((char *)s->base + s->len - (char *)ptr);
+        /* Keep the mapping unless it would be mostly unused. */
+        if (size > SMALL_MAX && size <= usable && size > usable / 2) {
+            return ptr;
+        }
+    } else {
+        usable = class_size(s->cls);
+        if (size <= SMALL_MAX && size_class(size) == s->cls) {
+            return ptr;
+        }
+    }
+    if ((p = malloc(size)) == NULL) {
+        return NULL;
+    }
+    memcpy(p, ptr, size < usable ? size : usable);
+    free(ptr);
+    return p;
+}
@@ -16,21 +16,19 @@
  */
 
 #include <errno.h>
+#include <limits.h>
 #include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 #include <sys/param.h>
-#include <unistd.h>
+#include <sys/printf.h>
 
+#include "itoa.h"
 #include "printf_convspec.h"
-
-/* Prototype of the write() system call. */
-typedef ssize_t (*write_t)(int, const void *, size_t);
-struct vnprintf_opts {
-    int is_bounded; /* Whether this was a *nprintf() function or not. */
-    size_t n; /* Maximum number of bytes to be written. */
-    int fd; /* Destination file descriptor. */
-    write_t write; /* Pointer to a write() implementation. */
-};
+#include "printf_float.h"
+#include "printf_out.h"
 
 struct pad_opts {
     /* Type of padding to perform. */
@@ -39,198 +37,519 @@ struct pad_opts {
     size_t len;
 };
 
-static ssize_t pad(struct convspec *convspec, struct pad_opts pad_opts,
-    struct vnprintf_opts *print_opts)
+static void pad(
+    struct convspec *convspec, struct pad_opts pad_opts, struct printf_out *out)
 {
-    ssize_t nwritten = 0;
-    ssize_t rc;
-    char fill;
-
     if (pad_opts.type == LEADING && (convspec->flags & CONVSPEC_MINUS) != 0) {
         /* Minus flag has been specified (pad characters to the right). */
-        return 0;
+        return;
     }
     if (pad_opts.type == TRAILING && (convspec->flags & CONVSPEC_MINUS) == 0) {
         /* Minus flag was not specified (no trailing padding to be done). */
-        return 0;
+        return;
     }
     if (convspec->width == 0 || pad_opts.len >= convspec->width) {
         /* No padding to be done, or text overflows. */
-        return 0;
+        return;
     }
-    fill = (convspec->flags & CONVSPEC_ZERO) != 0 ? '0' : ' ';
     /* (arg_len < cs->width) is guaranteed here. */
-    for (size_t pad_len = convspec->width - pad_opts.len; pad_len > 0;
-         pad_len--) {
-        rc = print_opts->write(print_opts->fd, &fill, 1);
-        if (rc < 0) {
-            return rc;
+    out_fill(out, (convspec->flags & CONVSPEC_ZERO) != 0 ? '0' : ' ',
+        convspec->width - pad_opts.len);
+}
+
+/* Fetches an integer argument, given its length modifier. Values are returned
+ * sign-extended, and truncated to the width of the modifier by the caller. */
+typedef uintmax_t (*fetch_t)(va_list *args);
+
+static uintmax_t fetch_int(va_list *args)
+{
+    return (uintmax_t)(intmax_t)va_arg(*args, int);
+}
+
+static uintmax_t fetch_long(va_list *args)
+{
+    return (uintmax_t)(intmax_t)va_arg(*args, long);
+}
+
+static uintmax_t fetch_long_long(va_list *args)
+{
+    return (uintmax_t)(intmax_t)va_arg(*args, long long);
+}
+
+static uintmax_t fetch_max(va_list *args)
+{
+    return (uintmax_t)va_arg(*args, intmax_t);
+}
+
+static uintmax_t fetch_size(va_list *args)
+{
+    return (uintmax_t)va_arg(*args, size_t);
+}
+
+static uintmax_t fetch_ptrdiff(va_list *args)
+{
+    return (uintmax_t)(intmax_t)va_arg(*args, ptrdiff_t);
+}
+
+/* char and short arguments are promoted to int, so they are fetched as such
+ * and then truncated. */
+static const fetch_t fetch_arg[] = {
+    [0] = fetch_int,
+    [CONVSPEC_CHAR] = fetch_int,
+    [CONVSPEC_SHORT] = fetch_int,
+    [CONVSPEC_LONG] = fetch_long,
+    [CONVSPEC_LONG_LONG] = fetch_long_long,
+    [CONVSPEC_MAX] = fetch_max,
+    [CONVSPEC_SIZE] = fetch_size,
+    [CONVSPEC_PTRDIFF] = fetch_ptrdiff,
+};
+
+/* Number of bits to be discarded from a fetched argument, given its length
+ * modifier. */
+static const unsigned char arg_shift[] = {
+    [0] = sizeof(uintmax_t) * CHAR_BIT - sizeof(int) * CHAR_BIT,
+    [CONVSPEC_CHAR] = sizeof(uintmax_t) * CHAR_BIT - sizeof(char) * CHAR_BIT,
+    [CONVSPEC_SHORT] = sizeof(uintmax_t) * CHAR_BIT - sizeof(short) * CHAR_BIT,
+    [CONVSPEC_LONG] = sizeof(uintmax_t) * CHAR_BIT - sizeof(long) * CHAR_BIT,
+    [CONVSPEC_LONG_LONG]
+    = sizeof(uintmax_t) * CHAR_BIT - sizeof(long long) * CHAR_BIT,
+    [CONVSPEC_MAX] = 0,
+    [CONVSPEC_SIZE] = sizeof(uintmax_t) * CHAR_BIT - sizeof(size_t) * CHAR_BIT,
+    [CONVSPEC_PTRDIFF]
+    = sizeof(uintmax_t) * CHAR_BIT - sizeof(ptrdiff_t) * CHAR_BIT,
+};
+
+/* An argument fetched from a va_list ahead of being formatted. */
+union printf_arg {
+    uintmax_t i; /* Integers (sign-extended) and pointers. */
+    double f;
+    const char *s;
+};
+
+/* Determines how the argument of a conversion specifier is fetched. */
+enum arg_class {
+    ARG_NONE = 0, /* No argument is consumed. */
+    ARG_STR, /* A string. */
+    ARG_PTR, /* A pointer. */
+    ARG_DOUBLE, /* A double. */
+    ARG_INT, /* An integer, plus the index in fetch_arg[]. */
+};
+
+static int arg_class(const struct convspec *cs)
+{
+    switch (cs->conv) {
+    case '%':
+        return ARG_NONE;
+    case 's':
+        return ARG_STR;
+    case 'p':
+        return ARG_PTR;
+    case 'a':
+    case 'A':
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+        return ARG_DOUBLE;
+    default:
+        /* char and short arguments are promoted to int, so fetching them
+         * is no different. */
+        return ARG_INT + (cs->len <= CONVSPEC_SHORT ? 0 : (int)cs->len);
+    }
+}
+
+/* Fetches the next argument from a va_list, given its class. */
+static void load_arg(union printf_arg *arg, int cls, va_list *args)
+{
+    switch (cls) {
+    case ARG_NONE:
+        break;
+    case ARG_STR:
+        arg->s = va_arg(*args, const char *);
+        break;
+    case ARG_PTR:
+        arg->i = (uintptr_t)va_arg(*args, void *);
+        break;
+    case ARG_DOUBLE:
+        arg->f = va_arg(*args, double);
+        break;
+    default:
+        arg->i = fetch_arg[cls - ARG_INT](args);
+        break;
+    }
+}
+
+/**
+ * @brief      Fetches all arguments referenced with "%n$" conversion
+ *             specifiers. The format string is scanned once to record the
+ *             type of every argument, and then all of them are fetched in a
+ *             single pass, so that no argument is fetched more than once.
+ *
+ * @param[out] argv  The argument table, indexed by n - 1.
+ * @param[in]  fmt   The format string.
+ * @param[in]  args  The argument list.
+ *
+ * @return     On success, the number of arguments fetched. On error, -1 is
+ *             returned and errno is set to EINVAL. This happens when not all
+ *             conversions are numbered, when n is out of range, when an
+ *             argument is referenced with incompatible types, or when some
+ *             argument before the last one is not referenced at all.
+ */
+static int load_positional(
+    union printf_arg *argv, const char *fmt, va_list *args)
+{
+    unsigned char cls[NL_ARGMAX] = { 0 };
+    struct convspec cs;
+    int nargs = 0, nskip, c;
+
+    while ((nskip = convspec_parse(&cs, fmt)) > 0) {
+        fmt += nskip;
+        if (cs.conv == '\0' || (c = arg_class(&cs)) == ARG_NONE) {
+            continue;
         }
-        nwritten += rc;
+        if (!cs.has_argno || cs.argno == 0 || cs.argno > NL_ARGMAX
+            || (cls[cs.argno - 1] != ARG_NONE && cls[cs.argno - 1] != c)) {
+            errno = EINVAL;
+            return -1;
+        }
+        cls[cs.argno - 1] = (unsigned char)c;
+        nargs = MAX(nargs, (int)cs.argno);
+    }
+
+    for (int i = 0; i < nargs; i++) {
+        if (cls[i] == ARG_NONE) {
+            /* There is no way to know the type of this argument, and hence
+             * to skip over it. */
+            errno = EINVAL;
+            return -1;
+        }
+        load_arg(&argv[i], cls[i], args);
+    }
+    return nargs;
+}
+
+/* Formats a floating-point conversion specifier. */
+static void format_float(
+    struct printf_out *out, struct convspec *cs, const union printf_arg *arg)
+{
+    struct float_fmt ff;
+    size_t total;
+
+    float_format(&ff, arg->f, cs);
+    if (!ff.is_finite) {
+        /* Infinity and NaN are never zero-padded. */
+        cs->flags &= ~CONVSPEC_ZERO;
+    }
+
+    total = ff.prefix_len + ff.len;
+    if ((cs->flags & CONVSPEC_ZERO) != 0) {
+        out_write(out, ff.prefix, ff.prefix_len);
+        pad(cs, (struct pad_opts) { .type = LEADING, .len = total }, out);
+    } else {
+        pad(cs, (struct pad_opts) { .type = LEADING, .len = total }, out);
+        out_write(out, ff.prefix, ff.prefix_len);
+    }
+    /* Large runs of zeros are never stored, but written straight away. */
+    for (int i = 0; i < ff.nseg; i++) {
+        out_write(out, ff.seg[i].ptr, ff.seg[i].len);
+        out_fill(out, '0', ff.seg[i].zeros);
+    }
+    pad(cs, (struct pad_opts) { .type = TRAILING, .len = total }, out);
+}
+
+/* Formats a single conversion specifier, given its argument. */
+static void format_arg(
+    struct printf_out *out, struct convspec *cs, const union printf_arg *arg)
+{
+    const void *buf = NULL;
+    size_t len = 0;
+    char conv[64];
+    /* Sign or radix prefix, which goes before any zero padding. */
+    char prefix[2];
+    size_t prefix_len = 0;
+    size_t total;
+
+    if (cs->conv == '%') {
+        out_write(out, "%", 1);
+        return;
+    }
+
+    switch (cs->conv) {
+    case 'a':
+    case 'A':
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+        format_float(out, cs, arg);
+        return;
+    default:
+        break;
+    }
+
+    if (cs->conv == 'c') {
+        /* Write a single character. */
+        conv[len++] = (char)(arg->i & 0xFFU);
+        buf = &conv;
+    } else if (cs->conv == 's') {
+        /* Write a string. */
+        buf = arg->s;
+        len = strlen((char *)buf);
+        if (cs->has_prec) {
+            /* Precision part in the 's' conversion specifier determines
+             * the maximum number of bytes from the string to be written
+             * to the output stream. Limit the argument length to that. */
+            len = MIN(len, cs->prec);
+        }
+    } else if (cs->conv == 'd' || cs->conv == 'i' || cs->conv == 'D') {
+        /* Write a signed integer. Sign-extend it from the width of its
+         * length modifier (this relies on right shifts being arithmetic). */
+        unsigned shift = arg_shift[cs->len];
+        intmax_t val = (intmax_t)(arg->i << shift) >> shift;
+
+        if (val < 0) {
+            /* Number is negative. */
+            prefix[prefix_len++] = '-';
+        } else if ((cs->flags & CONVSPEC_PLUS) != 0) {
+            /* Print plus sign before positive number. */
+            prefix[prefix_len++] = '+';
+        } else if ((cs->flags & CONVSPEC_SPACE) != 0) {
+            /* Print space before positive number. */
+            prefix[prefix_len++] = ' ';
+        }
+        /* Negate in unsigned arithmetic so that INTMAX_MIN does not
+         * overflow. */
+        len = itoa_dec(conv, val < 0 ? 0 - (uintmax_t)val : (uintmax_t)val);
+        buf = &conv;
+    } else if (cs->conv == 'U' || cs->conv == 'O' || cs->conv == 'X'
+        || cs->conv == 'u' || cs->conv == 'o' || cs->conv == 'x'
+        || cs->conv == 'p') {
+        /* Write an unsigned integer. */
+        uintmax_t val;
+        unsigned shift;
+
+        if (cs->conv == 'p') {
+            /* "%p" is equivalent to "%#x" or "%#lx". */
+            cs->conv = 'x';
+            cs->flags = CONVSPEC_HASH;
+            cs->len = CONVSPEC_LONG_LONG;
+        }
+
+        /* Truncate it to the width of its length modifier. */
+        shift = arg_shift[cs->len];
+        val = arg->i & (UINTMAX_MAX >> shift);
+
+        if (cs->conv == 'x' || cs->conv == 'X') {
+            if ((cs->flags & CONVSPEC_HASH) != 0) {
+                /* Prepend "0x" or "0X". */
+                prefix[prefix_len++] = '0';
+                prefix[prefix_len++] = cs->conv;
+            }
+            len = itoa_hex(conv, val, cs->conv == 'X');
+        } else if (cs->conv == 'u' || cs->conv == 'U') {
+            len = itoa_dec(conv, val);
+        } else {
+            len = itoa_oct(conv, val);
+        }
+        buf = &conv;
+    }
+
+    total = prefix_len + len;
+    if ((cs->flags & CONVSPEC_ZERO) != 0) {
+        /* Zero padding goes between the prefix and the digits. */
+        out_write(out, prefix, prefix_len);
+        pad(cs, (struct pad_opts) { .type = LEADING, .len = total }, out);
+    } else {
+        pad(cs, (struct pad_opts) { .type = LEADING, .len = total }, out);
+        out_write(out, prefix, prefix_len);
     }
-    return nwritten;
+    if (cs->conv == 's') {
+        /* String arguments outlive the call, so they need not be copied. */
+        out_write_ref(out, buf, len);
+    } else {
+        out_write(out, buf, len);
+    }
+    pad(cs, (struct pad_opts) { .type = TRAILING, .len = total }, out);
 }
 
 ssize_t vfprintf_impl(
     const char *restrict fmt, va_list args, struct vnprintf_opts opts)
 {
-    int nskip;
-    ssize_t nwritten = 0;
+    const char *fmt_initial = fmt;
+    int nskip, nconv = 0;
     struct convspec cs;
+    struct printf_out out;
+    union printf_arg arg;
+    /* Arguments referenced with "%n$", which are all fetched beforehand.
+     * nargs is negative unless conversions are numbered. */
+    union printf_arg argv[NL_ARGMAX];
+    int nargs = -1;
+    va_list ap;
 
-    while ((nskip = convspec_parse(&cs, fmt)) > 0) {
-        ssize_t rc;
-        void *buf = NULL;
-        size_t len = 0;
-
+    out_init(&out, &opts);
+    va_copy(ap, args);
+    while ((nskip = convspec_parse(&cs, fmt)) > 0 && !out.error) {
         if (cs.conv == '\0') {
-            /* No conversion specifier, meaning this was a string. */
-            buf = (void *)fmt;
-            len = nskip;
-        } else if (cs.conv == 'c') {
-            /* Write a single character. */
-            char chr = (char)(va_arg(args, unsigned) & 0xFFU);
-            buf = &chr;
-            len = sizeof(chr);
-        } else if (cs.conv == 's') {
-            /* Write a string. */
-            buf = va_arg(args, char *);
-            len = strlen((char *)buf);
-            if (cs.has_prec) {
-                /* Precision part in the 's' conversion specifier determines
-                 * the maximum number of bytes from the string to be written
-                 * to the output stream. Limit the argument length to that. */
-                len = MIN(len, cs.prec);
+            /* No conversion specifier, meaning this was a string. Literal
+             * runs are never padded, and are written from the format string
+             * itself. */
+            out_write_ref(&out, fmt, nskip);
+        } else if (arg_class(&cs) == ARG_NONE) {
+            format_arg(&out, &cs, NULL);
+        } else {
+            if (nconv++ == 0 && cs.has_argno) {
+                /* Either all conversions are numbered, or none is. */
+                nargs = load_positional(argv, fmt_initial, &ap);
             }
-        } else if (cs.conv == 'd' || cs.conv == 'i' || cs.conv == 'D') {
-            /* Write a signed integer. */
-            intmax_t val = va_arg(args, int);
-            char conv[64];
-            buf = &conv;
-
-            if (val == 0) {
-                conv[len++] = '0';
+            if (cs.has_argno != (nargs >= 0)) {
+                errno = EINVAL;
+                out.error = 1;
+            } else if (nargs >= 0) {
+                format_arg(&out, &cs, &argv[cs.argno - 1]);
             } else {
-                if (val > 0) {
-                    if ((cs.flags & CONVSPEC_PLUS) != 0) {
-                        /* Print plus sign before positive number. */
-                        conv[len++] = '+';
-                    } else if ((cs.flags & CONVSPEC_SPACE) != 0) {
-                        /* Print space before positive number. */
-                        conv[len++] = ' ';
-                    }
-                } else {
-                    /* Number is negative */
-                    conv[len++] = '-';
-                    val = -val;
-                }
-
-                char rev[64];
-                size_t n;
-                for (n = 0; val > 0; val /= 10) {
-                    rev[n++] = (char)('0' + (val % 10));
-                }
-                while (n-- > 0) {
-                    conv[len++] = rev[n];
-                }
-            }
-        } else if (cs.conv == 'U' || cs.conv == 'O' || cs.conv == 'X'
-            || cs.conv == 'u' || cs.conv == 'o' || cs.conv == 'x'
-            || cs.conv == 'p') {
-            /* Write an unsigned integer. */
-            char conv[64];
-            buf = &conv;
-
-            if (cs.conv == 'p') {
-                /* "%p" is equivalent to "%#x" or "%#lx". */
-                cs.conv = 'x';
-                cs.flags = CONVSPEC_HASH;
-                cs.len = CONVSPEC_LONG_LONG;
+                load_arg(&arg, arg_class(&cs), &ap);
+                format_arg(&out, &cs, &arg);
             }
+        }
+        fmt += nskip;
+    }
+    va_end(ap);
+    return out_finish(&out);
+}
 
-            if ((cs.flags & CONVSPEC_HASH)
-                && (cs.conv == 'X' || cs.conv == 'x')) {
-                /* Prepend "0x" or "0X". */
-                conv[len++] = '0';
-                conv[len++] = cs.conv;
-            }
+/* Same as vfprintf_impl(), but using a compiled format string. */
+static ssize_t vfprintf_compiled_impl(
+    const struct printf_fmt *pf, va_list args, struct vnprintf_opts opts)
+{
+    struct convspec cs;
+    struct printf_out out;
+    union printf_arg arg;
+    va_list ap;
 
-            int base;
-            if (cs.conv == 'x' || cs.conv == 'X') {
-                base = 16;
-            } else if (cs.conv == 'u' || cs.conv == 'U') {
-                base = 10;
-            } else if (cs.conv == 'o' || cs.conv == 'O') {
-                base = 8;
-            }
+    if (pf->nops <= 0) {
+        /* Format string has not been compiled, or failed to compile. */
+        errno = EINVAL;
+        return -1;
+    }
 
-            uintmax_t val;
-            switch (cs.len) {
-            case CONVSPEC_SIZE:
-            case CONVSPEC_LONG:
-                val = va_arg(args, unsigned long);
-                break;
-            case CONVSPEC_PTRDIFF:
-            case CONVSPEC_LONG_LONG:
-            case CONVSPEC_MAX:
-                val = va_arg(args, unsigned long long);
-                break;
-            default:
-                val = va_arg(args, unsigned);
-                break;
-            }
+    out_init(&out, &opts);
+    va_copy(ap, args);
+    for (int i = 0; i < pf->nops && !out.error; i++) {
+        const struct printf_op *op = &pf->ops[i];
 
-            const char lowerhex[16] = "0123456789abcdef";
-            const char upperhex[16] = "0123456789ABCDEF";
-            const char *hex = cs.conv == 'X' ? upperhex : lowerhex;
+        out_write_ref(&out, op->lit, op->lit_len);
+        if (op->conv == '\0') {
+            continue;
+        }
+        cs = (struct convspec) {
+            .flags = op->flags,
+            .has_flags = op->flags != 0,
+            .width = op->width,
+            .has_width = op->has_width,
+            .prec = op->prec,
+            .has_prec = op->has_prec,
+            .len = (enum convspec_length)op->len,
+            .has_len = op->len != 0,
+            .conv = op->conv,
+        };
+        load_arg(&arg, arg_class(&cs), &ap);
+        format_arg(&out, &cs, &arg);
+    }
+    va_end(ap);
+    return out_finish(&out);
+}
 
-            if (val == 0) {
-                conv[len++] = '0';
-            } else {
-                char rev[64];
-                size_t n;
-                for (n = 0; val > 0; val /= base) {
-                    rev[n++] = (char)(hex[val % base]);
-                }
-                while (n-- > 0) {
-                    conv[len++] = rev[n];
-                }
+/* Compiles a format string into an array of PRINTF_OPS_MAX operations, and
+ * obtains their number, or -1 on failure with errno set. */
+static int compile_ops(struct printf_op *ops, const char *fmt)
+{
+    struct printf_op *op = ops;
+    struct convspec cs;
+    int nskip;
+
+    *op = (struct printf_op) { .lit = fmt };
+    while (*fmt != '\0') {
+        errno = 0;
+        nskip = convspec_parse(&cs, fmt);
+        if (nskip < 0) {
+            /* Invalid or unsupported conversion specifier. */
+            if (errno == 0) {
+                errno = EINVAL;
             }
+            return -1;
         }
 
-        rc = pad(&cs, (struct pad_opts) { .type = LEADING, .len = len }, &opts);
-        if (rc < 0) {
-            goto end;
-        }
-        nwritten += rc;
-        rc = opts.write(opts.fd, buf, len);
-        if (rc < 0) {
-            goto end;
+        if (cs.conv == '\0') {
+            /* Literal run. */
+            if (op->lit_len + (unsigned)nskip > UINT16_MAX) {
+                errno = EINVAL;
+                return -1;
+            }
+            op->lit_len += nskip;
+            fmt += nskip;
+            continue;
         }
-        nwritten += rc;
-        rc = pad(
-            &cs, (struct pad_opts) { .type = TRAILING, .len = len }, &opts);
-        if (rc < 0) {
-            goto end;
+
+        if (cs.has_argno || cs.width > UINT32_MAX || cs.prec > UINT32_MAX
+            || op == &ops[PRINTF_OPS_MAX - 1]) {
+            /* Positional arguments are not supported, and the last
+             * operation is reserved for the trailing literal. */
+            errno = EINVAL;
+            return -1;
         }
-        nwritten += rc;
+        op->flags = (uint8_t)cs.flags;
+        op->len = (uint8_t)cs.len;
+        op->has_width = (uint8_t)cs.has_width;
+        op->has_prec = (uint8_t)cs.has_prec;
+        op->conv = cs.conv;
+        op->width = (uint32_t)cs.width;
+        op->prec = (uint32_t)cs.prec;
+
         fmt += nskip;
+        *++op = (struct printf_op) { .lit = fmt };
     }
-end:
-    return nwritten;
+
+    return (int)(op - ops) + 1;
 }
 
-int vprintf(const char *restrict fmt, va_list args)
+int printf_compile(struct printf_fmt *pf, const char *fmt)
+{
+    pf->nops = compile_ops(pf->ops, fmt);
+    return pf->nops;
+}
+
+int vfprintf(FILE *restrict stream, const char *restrict fmt, va_list args)
 {
     return (int)vfprintf_impl(fmt, args,
         (struct vnprintf_opts) {
             .is_bounded = 0,
             .n = 0,
-            .fd = 0,
-            .write = write,
+            .stream = stream,
+            .dest = NULL,
         });
 }
 
+int fprintf(FILE *restrict stream, const char *restrict fmt, ...)
+{
+    va_list args;
+    int rc;
+
+    va_start(args, fmt);
+    rc = vfprintf(stream, fmt, args);
+    va_end(args);
+
+    return rc;
+}
+
+int vprintf(const char *restrict fmt, va_list args)
+{
+    return vfprintf(stdout, fmt, args);
+}
+
 int printf(const char *restrict fmt, ...)
 {
     va_list args;
@@ -242,3 +561,105 @@ int printf(const char *restrict fmt, ...)
 
     return rc;
 }
+
+int vsnprintf(
+    char *restrict dest, size_t n, const char *restrict fmt, va_list args)
+{
+    return (int)vfprintf_impl(fmt, args,
+        (struct vnprintf_opts) {
+            .is_bounded = 1,
+            .n = n,
+            .stream = NULL,
+            .dest = dest,
+        });
+}
+
+int snprintf(char *restrict dest, size_t n, const char *restrict fmt, ...)
+{
+    va_list args;
+    int rc;
+
+    va_start(args, fmt);
+    rc = vsnprintf(dest, n, fmt, args);
+    va_end(args);
+
+    return rc;
+}
+
+int vsprintf(char *restrict dest, const char *restrict fmt, va_list args)
+{
+    return (int)vfprintf_impl(fmt, args,
+        (struct vnprintf_opts) {
+            .is_bounded = 0,
+            .n = 0,
+            .stream = NULL,
+            .dest = dest,
+        });
+}
+
+int sprintf(char *restrict dest, const char *restrict fmt, ...)
+{
+    va_list args;
+    int rc;
+
+    va_start(args, fmt);
+    rc = vsprintf(dest, fmt, args);
+    va_end(args);
+
+    return rc;
+}
+
+int vprintf_compiled(const struct printf_fmt *pf, va_list args)
+{
+    return (int)vfprintf_compiled_impl(pf, args,
+        (struct vnprintf_opts) {
+            .is_bounded = 0,
+            .n = 0,
+            .stream = stdout,
+            .dest = NULL,
+        });
+}
+
+int printf_compiled(const struct printf_fmt *pf, ...)
+{
+    va_list args;
+    int rc;
+
+    va_start(args, pf);
+    rc = vprintf_compiled(pf, args);
+    va_end(args);
+
+    return rc;
+}
+
+int printf_cached(struct printf_fmt *pf, const char *fmt, ...)
+{
+    va_list args;
+    int rc, nops = __atomic_load_n(&pf->nops, __ATOMIC_ACQUIRE), zero = 0;
+
+    /* The first caller marks the format string as tried before compiling
+     * it, so that it is compiled once, and publishes the operations only
+     * once they are complete. Callers that find it being compiled, or that
+     * it could not be, parse it themselves. */
+    if (nops == 0
+        && __atomic_compare_exchange_n(&pf->nops, &zero, -1, 0,
+            __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+        if ((nops = compile_ops(pf->ops, fmt)) > 0) {
+            __atomic_store_n(&pf->nops, nops, __ATOMIC_RELEASE);
+        }
+    } else if (nops == 0) {
+        nops = zero;
+    }
+
+    va_start(args, fmt);
+    if (nops > 0) {
+        rc = vprintf_compiled(pf, args);
+    } else {
+        /* Format string could not be compiled (e.g. it uses positional
+         * arguments). Fall back to parsing it on every call. */
+        rc = vprintf(fmt, args);
+    }
+    va_end(args);
+
+    return rc;
+}
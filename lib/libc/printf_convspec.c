@@ -305,6 +305,30 @@ static int parse_specifier(struct convspec *cs, const char *fmt)
     case 'F':
     case 'g':
     case 'G':
+        /* ' ' and '+' are mutually exclusive. */
+        if ((cs->flags & (CONVSPEC_SPACE | CONVSPEC_PLUS))
+            == (CONVSPEC_SPACE | CONVSPEC_PLUS)) {
+            return -1;
+        }
+        /* '-' and '0' are mutually exclusive. */
+        if ((cs->flags & (CONVSPEC_MINUS | CONVSPEC_ZERO))
+            == (CONVSPEC_MINUS | CONVSPEC_ZERO)) {
+            return -1;
+        }
+        if (cs->len == CONVSPEC_LONG_DOUBLE) {
+            /* Long double arguments are not supported: they are quad
+             * precision on riscv64, which the digit generation does not
+             * handle. */
+            errno = ENOSYS;
+            return -1;
+        }
+        /* Check supported modifiers ('l' has no effect, others are not
+         * supported). */
+        if (cs->len != 0 && cs->len != CONVSPEC_LONG) {
+            return -1;
+        }
+        break;
+
     case 'n':
         /* TODO: Implement this specifier. */
         errno = ENOSYS;
@@ -317,11 +341,109 @@ static int parse_specifier(struct convspec *cs, const char *fmt)
     return 1;
 }
 
-int convspec_parse(struct convspec *cs, const char *fmt)
+static int parse_scan_specifier(struct convspec *cs, const char *fmt)
 {
-    const char *fmt_initial = fmt;
-    int rc = 0;
+    const char *set = fmt + 1;
+
+    switch (*fmt) {
+    case '%':
+        /* '%' supports no parts. */
+        if (cs->has_len || cs->has_argno || cs->has_flags || cs->has_width) {
+            return -1;
+        }
+        break;
+
+    case '[':
+        /* Find the closing bracket. A bracket right after the opening one
+         * (or after '^') is part of the set. */
+        if (*set == '^') {
+            set++;
+        }
+        if (*set == ']') {
+            set++;
+        }
+        while (*set != ']') {
+            if (*set == '\0') {
+                return -1;
+            }
+            set++;
+        }
+        cs->set = fmt + 1;
+        /* Fall through. */
+    case 'c':
+    case 's':
+        if (cs->len == CONVSPEC_LONG) {
+            /* Wide characters are not supported, since the library has
+             * no multibyte conversion to produce them with. */
+            errno = ENOSYS;
+            return -1;
+        }
+        if (cs->has_len) {
+            return -1;
+        }
+        if (*fmt == '[') {
+            cs->conv = '[';
+            return (int)((ptrdiff_t)(set + 1 - fmt));
+        }
+        break;
+
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        /* Check supported modifiers ('L' is not supported). */
+        if (cs->len == CONVSPEC_LONG_DOUBLE) {
+            return -1;
+        }
+        break;
 
+    case 'p':
+        /* 'p' supports no length modifier. */
+        if (cs->has_len) {
+            return -1;
+        }
+        break;
+
+    case 'n':
+        /* Suppressing or bounding 'n' makes no sense. */
+        if ((cs->flags & CONVSPEC_STAR) || cs->has_width
+            || cs->len == CONVSPEC_LONG_DOUBLE) {
+            return -1;
+        }
+        break;
+
+    case 'a':
+    case 'A':
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+        if (cs->len == CONVSPEC_LONG_DOUBLE) {
+            /* Long double arguments are not supported, as in printf(). */
+            errno = ENOSYS;
+            return -1;
+        }
+        /* Check supported modifiers ('l' selects double, others are not
+         * supported). */
+        if (cs->len != 0 && cs->len != CONVSPEC_LONG) {
+            return -1;
+        }
+        break;
+
+    default:
+        /* Invalid or unsupported specifier. */
+        return -1;
+    }
+    cs->conv = *fmt;
+    return 1;
+}
+
+static void convspec_init(struct convspec *cs)
+{
     cs->argno = 0;
     cs->has_argno = 0;
 
@@ -338,6 +460,15 @@ int convspec_parse(struct convspec *cs, const char *fmt)
     cs->has_len = 0;
 
     cs->conv = '\0';
+    cs->set = NULL;
+}
+
+int convspec_parse(struct convspec *cs, const char *fmt)
+{
+    const char *fmt_initial = fmt;
+    int rc = 0;
+
+    convspec_init(cs);
 
     /* Skip until we find a conversion specifier or the end of the string. */
     if (*fmt != '%') {
@@ -388,3 +519,61 @@ int convspec_parse(struct convspec *cs, const char *fmt)
 
     return (int)((ptrdiff_t)(fmt - fmt_initial));
 }
+
+int convspec_parse_scan(struct convspec *cs, const char *fmt)
+{
+    const char *fmt_initial = fmt;
+    int rc = 0;
+
+    convspec_init(cs);
+
+    /* Skip until we find a conversion specifier or the end of the string. */
+    if (*fmt != '%') {
+        while (*fmt != '%' && *fmt != '\0') {
+            fmt++, rc++;
+        }
+        return rc;
+    }
+
+    /* Skip initial '%' character. */
+    fmt++;
+
+    rc = parse_argno(cs, fmt);
+    if (rc < 0) {
+        return rc;
+    }
+    fmt += rc;
+
+    /* Assignment suppression is the only flag. */
+    if (*fmt == '*') {
+        cs->flags = CONVSPEC_STAR;
+        cs->has_flags = 1;
+        fmt++;
+    }
+
+    if (isdigit(*fmt)) {
+        rc = parse_width(cs, fmt);
+        if (rc < 0) {
+            return rc;
+        }
+        if (cs->width == 0) {
+            /* Fields must be at least one character wide. */
+            return -1;
+        }
+        fmt += rc;
+    }
+
+    rc = parse_length_modifier(cs, fmt);
+    if (rc < 0) {
+        return rc;
+    }
+    fmt += rc;
+
+    rc = parse_scan_specifier(cs, fmt);
+    if (rc < 0) {
+        return rc;
+    }
+    fmt += rc;
+
+    return (int)((ptrdiff_t)(fmt - fmt_initial));
+}
@@ -32,6 +32,8 @@
 #define CONVSPEC_ZERO (1U << 4U)
 /* Pad numbers to the left instead of to the right. */
 #define CONVSPEC_MINUS (1U << 5U)
+/* Do not assign the result of the conversion (scanf() only). */
+#define CONVSPEC_STAR (1U << 6U)
 
 enum convspec_length {
     /* Specifies that the specifier applies to a char argument. */
@@ -78,6 +80,10 @@ struct convspec {
 
     /* Character determining the expected argument type and its format. */
     char conv;
+
+    /* For '[' conversions (scanf() only), the characters after the opening
+     * bracket, up to and including the closing one. */
+    const char *set;
 };
 
 /**
@@ -94,3 +100,16 @@ struct convspec {
  *              (whichever comes first).
  */
 int convspec_parse(struct convspec *cs, const char *fmt);
+
+/**
+ * @brief       Parses a conversion specifier for the scanf() family. It
+ *              accepts an argno, the '*' flag, a non-zero width and a length
+ *              modifier, and the '[' conversion.
+ *
+ * @param[out]  cs     A pointer to a @ref convspec struct that will hold the
+ *                     parameters for the conversion specifier.
+ * @param[in]   fmt    The format string.
+ *
+ * @return      The same as @ref convspec_parse().
+ */
+int convspec_parse_scan(struct convspec *cs, const char *fmt);
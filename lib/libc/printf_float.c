@@ -0,0 +1,673 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "itoa.h"
+#include "printf_convspec.h"
+#include "printf_float.h"
+#include "printf_float_table.h"
+#include "umul128.h"
+
+#define DOUBLE_MANTISSA_BITS 52
+#define DOUBLE_EXPONENT_BITS 11
+#define DOUBLE_BIAS 1023
+
+/* Number of 32-bit words needed to hold the exact integer m * 2^e or
+ * m * 5^-e of any double. */
+#define BIG_WORDS 82
+/* Number of base 10^9 chunks needed to hold FLOAT_DIGITS_MAX digits. */
+#define BIG_CHUNKS 86
+
+/* A decimal floating-point number: mant * 10^exp. */
+struct decimal {
+    uint64_t mant;
+    int32_t exp;
+};
+
+static inline uint32_t pow5bits(int32_t e)
+{
+    /* Computes ceil(log2(5^e)) for e in [0, 3528]. */
+    return (uint32_t)(((uint32_t)e * 1217359U) >> 19U) + 1;
+}
+
+static inline uint32_t log10pow2(int32_t e)
+{
+    /* Computes floor(log10(2^e)) for e in [0, 1650]. */
+    return ((uint32_t)e * 78913U) >> 18U;
+}
+
+static inline uint32_t log10pow5(int32_t e)
+{
+    /* Computes floor(log10(5^e)) for e in [0, 2620]. */
+    return ((uint32_t)e * 732923U) >> 20U;
+}
+
+static inline int multiple_of_pow5(uint64_t val, uint32_t p)
+{
+    uint32_t count = 0;
+
+    for (; val % 5 == 0; val /= 5) {
+        count++;
+    }
+    return count >= p;
+}
+
+static inline int multiple_of_pow2(uint64_t val, uint32_t p)
+{
+    return (val & ((1ULL << p) - 1)) == 0;
+}
+
+static inline uint64_t mul_shift64(
+    uint64_t m, const uint64_t *mul, int32_t j)
+{
+    uint64_t high0, high1, low1, sum;
+    unsigned dist;
+
+    low1 = umul128(m, mul[1], &high1);
+    umul128(m, mul[0], &high0);
+    sum = high0 + low1;
+    if (sum < high0) {
+        high1++;
+    }
+    /* j is always in [65, 127] here. */
+    dist = (unsigned)j - 64;
+    return (high1 << (64 - dist)) | (sum >> dist);
+}
+
+/**
+ * @brief      Obtains the shortest decimal representation that reads back as
+ *             the given value, using the Ryu algorithm.
+ *
+ * @param[in]  ieee_mant  The stored mantissa bits.
+ * @param[in]  ieee_exp   The stored (biased) exponent bits, which must not be
+ *                        all ones.
+ *
+ * @return     The decimal representation. Its mantissa has at most 17 digits.
+ */
+static struct decimal shortest(uint64_t ieee_mant, uint32_t ieee_exp)
+{
+    struct decimal d;
+    int32_t e2, e10, removed;
+    uint64_t m2, mv, vr, vp, vm;
+    uint32_t mm_shift, q;
+    int32_t i, j, k;
+    int accept_bounds, vm_trailing_zeros = 0, vr_trailing_zeros = 0;
+    unsigned last_removed = 0;
+
+    if (ieee_exp == 0) {
+        e2 = 1 - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS - 2;
+        m2 = ieee_mant;
+    } else {
+        e2 = (int32_t)ieee_exp - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS - 2;
+        m2 = (1ULL << DOUBLE_MANTISSA_BITS) | ieee_mant;
+    }
+    /* The bounds of the rounding interval are included when the mantissa is
+     * even, as round-half-to-even reads them back as this value. */
+    accept_bounds = (m2 & 1) == 0;
+
+    /* Work with 4 * m2 so that the interval bounds are integers. The lower
+     * bound is closer when the mantissa is a power of two. */
+    mv = 4 * m2;
+    mm_shift = ieee_mant != 0 || ieee_exp <= 1;
+
+    /* Compute vr, vp and vm, the value and the bounds of its rounding
+     * interval scaled by 10^-e10. */
+    if (e2 >= 0) {
+        q = log10pow2(e2) - (e2 > 3);
+        e10 = (int32_t)q;
+        k = POW5_INV_BITCOUNT + (int32_t)pow5bits((int32_t)q) - 1;
+        i = -e2 + (int32_t)q + k;
+        vr = mul_shift64(4 * m2, pow5_inv_split[q], i);
+        vp = mul_shift64(4 * m2 + 2, pow5_inv_split[q], i);
+        vm = mul_shift64(4 * m2 - 1 - mm_shift, pow5_inv_split[q], i);
+        if (q <= 21) {
+            /* Only one of mv, mp and mm can be a multiple of 5, if any. */
+            if (mv % 5 == 0) {
+                vr_trailing_zeros = multiple_of_pow5(mv, q);
+            } else if (accept_bounds) {
+                vm_trailing_zeros = multiple_of_pow5(mv - 1 - mm_shift, q);
+            } else {
+                vp -= multiple_of_pow5(mv + 2, q);
+            }
+        }
+    } else {
+        q = log10pow5(-e2) - (-e2 > 1);
+        e10 = (int32_t)q + e2;
+        i = -e2 - (int32_t)q;
+        k = (int32_t)pow5bits(i) - POW5_BITCOUNT;
+        j = (int32_t)q - k;
+        vr = mul_shift64(4 * m2, pow5_split[i], j);
+        vp = mul_shift64(4 * m2 + 2, pow5_split[i], j);
+        vm = mul_shift64(4 * m2 - 1 - mm_shift, pow5_split[i], j);
+        if (q <= 1) {
+            /* mv has at least q trailing zero bits, so vr is exact. */
+            vr_trailing_zeros = 1;
+            if (accept_bounds) {
+                vm_trailing_zeros = mm_shift == 1;
+            } else {
+                vp--;
+            }
+        } else if (q < 63) {
+            vr_trailing_zeros = multiple_of_pow2(mv, q);
+        }
+    }
+
+    /* Remove digits while the bounds still differ. */
+    removed = 0;
+    if (vm_trailing_zeros || vr_trailing_zeros) {
+        /* General case, which happens rarely. */
+        for (;;) {
+            if (vp / 10 <= vm / 10) {
+                break;
+            }
+            vm_trailing_zeros &= vm % 10 == 0;
+            vr_trailing_zeros &= last_removed == 0;
+            last_removed = (unsigned)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vm_trailing_zeros) {
+            while (vm % 10 == 0) {
+                vr_trailing_zeros &= last_removed == 0;
+                last_removed = (unsigned)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if (vr_trailing_zeros && last_removed == 5 && vr % 2 == 0) {
+            /* Exact tie: round to even. */
+            last_removed = 4;
+        }
+        d.mant = vr
+            + ((vr == vm && (!accept_bounds || !vm_trailing_zeros))
+                || last_removed >= 5);
+    } else {
+        /* Common case: no trailing zeros to keep track of. */
+        int round_up = 0;
+
+        if (vp / 100 > vm / 100) {
+            round_up = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        for (;;) {
+            if (vp / 10 <= vm / 10) {
+                break;
+            }
+            round_up = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        d.mant = vr + (vr == vm || round_up);
+    }
+    d.exp = e10 + removed;
+    return d;
+}
+
+/* Multiplies a little-endian big integer by a small factor. */
+static void big_mul(uint32_t *big, int *nwords, uint32_t factor)
+{
+    uint64_t carry = 0;
+    int i;
+
+    for (i = 0; i < *nwords; i++) {
+        carry += (uint64_t)big[i] * factor;
+        big[i] = (uint32_t)carry;
+        carry >>= 32U;
+    }
+    if (carry != 0) {
+        big[(*nwords)++] = (uint32_t)carry;
+    }
+}
+
+/* Shifts a little-endian big integer to the left. */
+static void big_shl(uint32_t *big, int *nwords, unsigned shift)
+{
+    unsigned words = shift / 32, bits = shift % 32;
+    int i;
+
+    big[*nwords] = 0;
+    if (bits != 0) {
+        for (i = *nwords; i > 0; i--) {
+            big[i] = (big[i] << bits) | (big[i - 1] >> (32 - bits));
+        }
+        big[0] <<= bits;
+    }
+    (*nwords)++;
+    for (i = *nwords - 1; i >= 0; i--) {
+        big[i + (int)words] = big[i];
+    }
+    for (i = 0; i < (int)words; i++) {
+        big[i] = 0;
+    }
+    *nwords += (int)words;
+    while (*nwords > 0 && big[*nwords - 1] == 0) {
+        (*nwords)--;
+    }
+}
+
+/* Divides a little-endian big integer by 10^9 and returns the remainder. */
+static uint32_t big_div1e9(uint32_t *big, int *nwords)
+{
+    uint64_t rem = 0;
+    int i;
+
+    for (i = *nwords - 1; i >= 0; i--) {
+        rem = (rem << 32U) | big[i];
+        big[i] = (uint32_t)(rem / 1000000000U);
+        rem %= 1000000000U;
+    }
+    while (*nwords > 0 && big[*nwords - 1] == 0) {
+        (*nwords)--;
+    }
+    return (uint32_t)rem;
+}
+
+/**
+ * @brief      Obtains all significant digits of the exact value m2 * 2^e2.
+ *             This is slow, and only used when the shortest representation
+ *             is not enough to round the value correctly.
+ *
+ * @param[out] buf   The destination buffer, which must be able to hold
+ *                   FLOAT_DIGITS_MAX characters.
+ * @param[in]  m2    The binary mantissa, which must be non-zero.
+ * @param[in]  e2    The binary exponent.
+ * @param[out] exp   The decimal exponent of the first digit.
+ *
+ * @return     The number of digits, excluding trailing zeros.
+ */
+static int exact_digits(char *buf, uint64_t m2, int32_t e2, int *exp)
+{
+    uint32_t big[BIG_WORDS];
+    uint32_t chunks[BIG_CHUNKS];
+    int nwords = 2, nchunks = 0, n, i, k;
+    int32_t e;
+
+    big[0] = (uint32_t)m2;
+    big[1] = (uint32_t)(m2 >> 32U);
+    if (e2 > 0) {
+        big_shl(big, &nwords, (unsigned)e2);
+    } else {
+        /* m2 * 2^e2 = m2 * 5^-e2 * 10^e2. */
+        for (e = -e2; e >= 13; e -= 13) {
+            big_mul(big, &nwords, 1220703125U);
+        }
+        for (; e > 0; e--) {
+            big_mul(big, &nwords, 5);
+        }
+    }
+    while (nwords > 0 && big[nwords - 1] == 0) {
+        nwords--;
+    }
+
+    while (nwords > 0) {
+        chunks[nchunks++] = big_div1e9(big, &nwords);
+    }
+    n = (int)itoa_dec(buf, chunks[nchunks - 1]);
+    for (i = nchunks - 2; i >= 0; i--) {
+        uint32_t c = chunks[i];
+
+        for (k = 8; k >= 0; k--) {
+            buf[n + k] = (char)('0' + c % 10);
+            c /= 10;
+        }
+        n += 9;
+    }
+
+    *exp = n - 1 + (e2 < 0 ? e2 : 0);
+    while (buf[n - 1] == '0') {
+        n--;
+    }
+    return n;
+}
+
+/**
+ * @brief      Rounds a digit string to nearest, ties to even.
+ *
+ * @param[in]  buf    The digits.
+ * @param      n      The number of digits, updated after rounding. Trailing
+ *                    zeros are removed.
+ * @param      exp    The decimal exponent of the first digit, which is
+ *                    incremented if rounding carries over it.
+ * @param[in]  keep   The number of digits to keep, which may be zero or
+ *                    negative.
+ * @param[in]  exact  Whether the digits are the exact value. If not, they are
+ *                    the shortest representation of it, and a tie cannot be
+ *                    decided.
+ *
+ * @return     Zero on success, or -1 if the tie could not be decided.
+ */
+static int round_digits(char *buf, int *n, int *exp, int keep, int exact)
+{
+    int up, i;
+
+    if (keep >= *n) {
+        return 0;
+    }
+    if (keep < 0) {
+        /* Less than half a unit in the last place to keep. */
+        *n = 0;
+        *exp = 0;
+        return 0;
+    }
+
+    if (buf[keep] != '5') {
+        up = buf[keep] > '5';
+    } else if (*n - keep > 1) {
+        up = 1;
+    } else if (!exact) {
+        return -1;
+    } else {
+        up = keep > 0 && (buf[keep - 1] - '0') % 2 != 0;
+    }
+
+    i = keep;
+    if (up) {
+        while (i > 0 && buf[i - 1] == '9') {
+            i--;
+        }
+        if (i == 0) {
+            buf[0] = '1';
+            i = 1;
+            (*exp)++;
+        } else {
+            buf[i - 1]++;
+        }
+    }
+    while (i > 0 && buf[i - 1] == '0') {
+        i--;
+    }
+    *n = i;
+    if (*n == 0) {
+        *exp = 0;
+    }
+    return 0;
+}
+
+/**
+ * @brief      Obtains the significant digits of a finite value, correctly
+ *             rounded to a number of digits.
+ *
+ * @param[out] buf        The destination buffer, which must be able to hold
+ *                        FLOAT_DIGITS_MAX characters.
+ * @param[in]  ieee_mant  The stored mantissa bits.
+ * @param[in]  ieee_exp   The stored (biased) exponent bits.
+ * @param[in]  fixed      If set, @p prec counts digits after the decimal
+ *                        point. Otherwise it counts significant digits.
+ * @param[in]  prec       The precision.
+ * @param[out] exp        The decimal exponent of the first digit.
+ *
+ * @return     The number of digits, excluding trailing zeros. It is zero if
+ *             the value is (or rounds to) zero.
+ */
+static int float_digits(char *buf, uint64_t ieee_mant, uint32_t ieee_exp,
+    int fixed, int prec, int *exp)
+{
+    struct decimal d;
+    uint64_t m2;
+    int32_t e2;
+    int n, keep;
+
+    if (ieee_mant == 0 && ieee_exp == 0) {
+        *exp = 0;
+        return 0;
+    }
+
+    /* Try with the shortest representation first. If it has no more digits
+     * than requested, its zero-padded expansion is the correctly rounded
+     * value as long as no more than 15 digits are requested and the value
+     * is normal (as any such decimal reads back as a different double). If
+     * it has more digits, it rounds the same way as the exact value unless a
+     * tie is found. */
+    d = shortest(ieee_mant, ieee_exp);
+    n = (int)itoa_dec(buf, d.mant);
+    while (buf[n - 1] == '0') {
+        n--;
+    }
+    *exp = d.exp + (int)itoa_declen(d.mant) - 1;
+    keep = fixed ? *exp + 1 + prec : prec;
+    if (n > keep) {
+        if (round_digits(buf, &n, exp, keep, 0) == 0) {
+            return n;
+        }
+    } else if (keep <= 15 && ieee_exp != 0) {
+        return n;
+    }
+
+    /* Fall back to the exact expansion. */
+    if (ieee_exp == 0) {
+        e2 = 1 - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS;
+        m2 = ieee_mant;
+    } else {
+        e2 = (int32_t)ieee_exp - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS;
+        m2 = (1ULL << DOUBLE_MANTISSA_BITS) | ieee_mant;
+    }
+    n = exact_digits(buf, m2, e2, exp);
+    keep = fixed ? *exp + 1 + prec : prec;
+    round_digits(buf, &n, exp, keep, 1);
+    return n;
+}
+
+static void add_seg(
+    struct float_fmt *ff, const char *ptr, size_t len, size_t zeros)
+{
+    ff->seg[ff->nseg].ptr = ptr;
+    ff->seg[ff->nseg].len = len;
+    ff->seg[ff->nseg].zeros = zeros;
+    ff->nseg++;
+    ff->len += len + zeros;
+}
+
+/* Lays out digits in the style [-]ddd.ddd. */
+static void layout_fixed(
+    struct float_fmt *ff, int n, int exp, int prec, int alt)
+{
+    int lead, frac;
+
+    if (exp >= 0) {
+        /* Integer part, zero-padded if needed. */
+        lead = n < exp + 1 ? n : exp + 1;
+        add_seg(ff, ff->digits, (size_t)lead, (size_t)(exp + 1 - lead));
+        if (prec > 0 || alt) {
+            add_seg(ff, ".", 1, 0);
+        }
+        frac = n - lead;
+        add_seg(ff, ff->digits + lead, (size_t)frac, (size_t)(prec - frac));
+    } else {
+        /* Zero integer part, then leading zeros in the fractional part. */
+        add_seg(ff, "0", 1, 0);
+        if (prec > 0 || alt) {
+            add_seg(ff, ".", 1, (size_t)(-exp - 1));
+        }
+        add_seg(ff, ff->digits, (size_t)n, (size_t)(prec - n + exp + 1));
+    }
+}
+
+/* Writes an exponent suffix with at least two digits into ff->exp. */
+static size_t format_exp(struct float_fmt *ff, char c, int exp, unsigned min)
+{
+    size_t len = 0;
+    unsigned absexp = exp < 0 ? (unsigned)-exp : (unsigned)exp;
+
+    ff->exp[len++] = c;
+    ff->exp[len++] = exp < 0 ? '-' : '+';
+    if (itoa_declen(absexp) < min) {
+        ff->exp[len++] = '0';
+    }
+    len += itoa_dec(ff->exp + len, absexp);
+    return len;
+}
+
+/* Lays out digits in the style [-]d.ddde±dd. */
+static void layout_exp(
+    struct float_fmt *ff, int n, int exp, int prec, int alt, int upper)
+{
+    int frac = n > 1 ? n - 1 : 0;
+
+    add_seg(ff, ff->digits, n > 0, n == 0);
+    if (prec > 0 || alt) {
+        add_seg(ff, ".", 1, 0);
+    }
+    add_seg(ff, ff->digits + 1, (size_t)frac, (size_t)(prec - frac));
+    add_seg(ff, ff->exp, format_exp(ff, upper ? 'E' : 'e', exp, 2), 0);
+}
+
+/* Lays out a value in the style [-]0xh.hhhp±d. */
+static void layout_hex(struct float_fmt *ff, uint64_t ieee_mant,
+    uint32_t ieee_exp, const struct convspec *cs, int upper)
+{
+    const char *xdigits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    /* The mantissa has 13 hexadecimal digits after the point. */
+    uint64_t m = ieee_mant;
+    int32_t exp = 0;
+    int ndigits = 13, zeros = 0, i;
+
+    if (ieee_exp != 0) {
+        m |= 1ULL << DOUBLE_MANTISSA_BITS;
+        exp = (int32_t)ieee_exp - DOUBLE_BIAS;
+    } else if (ieee_mant != 0) {
+        /* Subnormal numbers are shown with a leading 0. */
+        exp = 1 - DOUBLE_BIAS;
+    }
+
+    if (cs->has_prec && cs->prec < 13) {
+        unsigned drop = (13 - (unsigned)cs->prec) * 4;
+        uint64_t rem = m & ((1ULL << drop) - 1), half = 1ULL << (drop - 1);
+
+        m >>= drop;
+        if (rem > half || (rem == half && (m & 1) != 0)) {
+            /* This may carry into the leading digit, making it 2. */
+            m++;
+        }
+        ndigits = (int)cs->prec;
+    } else if (cs->has_prec) {
+        zeros = (int)(cs->prec - 13);
+    } else {
+        /* Shortest exact representation. */
+        while (ndigits > 0 && (m & 0xf) == 0) {
+            m >>= 4U;
+            ndigits--;
+        }
+    }
+
+    ff->digits[0] = xdigits[m >> (ndigits * 4)];
+    for (i = 0; i < ndigits; i++) {
+        ff->digits[1 + i] = xdigits[(m >> ((ndigits - 1 - i) * 4)) & 0xf];
+    }
+    add_seg(ff, ff->digits, 1, 0);
+    if (ndigits + zeros > 0 || (cs->flags & CONVSPEC_HASH) != 0) {
+        add_seg(ff, ".", 1, 0);
+    }
+    add_seg(ff, ff->digits + 1, (size_t)ndigits, (size_t)zeros);
+    add_seg(ff, ff->exp, format_exp(ff, upper ? 'P' : 'p', exp, 1), 0);
+}
+
+void float_format(struct float_fmt *ff, double val, const struct convspec *cs)
+{
+    union {
+        double d;
+        uint64_t u;
+    } bits;
+    uint64_t ieee_mant;
+    uint32_t ieee_exp;
+    int upper = cs->conv == 'A' || cs->conv == 'E' || cs->conv == 'F'
+        || cs->conv == 'G';
+    int alt = (cs->flags & CONVSPEC_HASH) != 0;
+    int prec, n, exp;
+
+    bits.d = val;
+    ieee_mant = bits.u & ((1ULL << DOUBLE_MANTISSA_BITS) - 1);
+    ieee_exp = (uint32_t)(bits.u >> DOUBLE_MANTISSA_BITS)
+        & ((1U << DOUBLE_EXPONENT_BITS) - 1);
+
+    ff->prefix_len = 0;
+    ff->nseg = 0;
+    ff->len = 0;
+    ff->is_finite = ieee_exp != (1U << DOUBLE_EXPONENT_BITS) - 1;
+
+    if ((bits.u >> 63U) != 0) {
+        ff->prefix[ff->prefix_len++] = '-';
+    } else if ((cs->flags & CONVSPEC_PLUS) != 0) {
+        ff->prefix[ff->prefix_len++] = '+';
+    } else if ((cs->flags & CONVSPEC_SPACE) != 0) {
+        ff->prefix[ff->prefix_len++] = ' ';
+    }
+
+    if (!ff->is_finite) {
+        if (ieee_mant != 0) {
+            add_seg(ff, upper ? "NAN" : "nan", 3, 0);
+        } else {
+            add_seg(ff, upper ? "INF" : "inf", 3, 0);
+        }
+        return;
+    }
+
+    if (cs->conv == 'a' || cs->conv == 'A') {
+        ff->prefix[ff->prefix_len++] = '0';
+        ff->prefix[ff->prefix_len++] = upper ? 'X' : 'x';
+        layout_hex(ff, ieee_mant, ieee_exp, cs, upper);
+        return;
+    }
+
+    /* Larger precisions cannot make a difference other than more zeros, and
+     * are clamped so that digit arithmetic does not overflow. */
+    prec = 6;
+    if (cs->has_prec) {
+        prec = cs->prec > INT_MAX / 2 ? INT_MAX / 2 : (int)cs->prec;
+    }
+
+    switch (cs->conv) {
+    case 'f':
+    case 'F':
+        n = float_digits(ff->digits, ieee_mant, ieee_exp, 1, prec, &exp);
+        layout_fixed(ff, n, exp, prec, alt);
+        break;
+    case 'e':
+    case 'E':
+        n = float_digits(ff->digits, ieee_mant, ieee_exp, 0, prec + 1, &exp);
+        layout_exp(ff, n, exp, prec, alt, upper);
+        break;
+    default:
+        /* 'g' and 'G' use P significant digits, and the style of 'e' only
+         * if the exponent is less than -4 or not less than P. Unless '#' is
+         * given, trailing zeros are removed from the fractional part. */
+        if (prec == 0) {
+            prec = 1;
+        }
+        n = float_digits(ff->digits, ieee_mant, ieee_exp, 0, prec, &exp);
+        if (exp < prec && exp >= -4) {
+            layout_fixed(ff, n, exp,
+                alt ? prec - 1 - exp : (n - 1 - exp > 0 ? n - 1 - exp : 0),
+                alt);
+        } else {
+            layout_exp(ff, n, exp, alt ? prec - 1 : (n > 1 ? n - 1 : 0), alt,
+                upper);
+        }
+        break;
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include "printf_convspec.h"
+
+/* Maximum number of significant decimal digits in the exact representation
+ * of a double (that of the largest subnormal number). */
+#define FLOAT_DIGITS_MAX 768
+
+/* A piece of formatted output: @ref len characters from @ref ptr followed by
+ * @ref zeros '0' characters. */
+struct float_seg {
+    const char *ptr;
+    size_t len;
+    size_t zeros;
+};
+
+/* Output of a floating-point conversion, split in segments so that large
+ * runs of zeros do not need to be stored. */
+struct float_fmt {
+    /* Sign and radix prefix, which goes before any zero padding. */
+    char prefix[3];
+    size_t prefix_len;
+    /* Segments to be written after the prefix. */
+    struct float_seg seg[4];
+    int nseg;
+    /* Total length of all segments. */
+    size_t len;
+    /* Whether the value is finite (only finite values are zero-padded). */
+    int is_finite;
+    /* Storage for the exponent suffix. */
+    char exp[8];
+    /* Storage for the significant digits. */
+    char digits[FLOAT_DIGITS_MAX];
+};
+
+/**
+ * @brief      Formats a floating-point value for one of the a, A, e, E, f, F,
+ *             g or G conversion specifiers.
+ *
+ * @param[out] ff    The formatted output, which refers to storage within
+ *                   @p ff itself.
+ * @param[in]  val   The value to be formatted.
+ * @param[in]  cs    The conversion specifier.
+ */
+void float_format(struct float_fmt *ff, double val, const struct convspec *cs);
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/param.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "stdio_impl.h"
+
+/* Size of the staging buffer used for coalescing writes to the output. */
+#define PRINTF_BUFSIZ 128
+
+/* Fragments at least this long are referenced from the output vector instead
+ * of being copied, provided they outlive the formatting call. Shorter ones are
+ * cheaper to copy. */
+#define PRINTF_REF_MIN 16
+
+struct vnprintf_opts {
+    int is_bounded; /* Whether this was a *nprintf() function or not. */
+    size_t n; /* Maximum number of bytes to be written. */
+    /* Destination stream. When NULL, output is formatted straight into
+     * @ref dest instead. */
+    FILE *stream;
+    char *dest; /* Destination buffer for the *sprintf() family. */
+};
+
+/* Output state for a single formatting call, shared by the printf() family
+ * and kprint(). When writing to a stream, output is gathered in @ref iov,
+ * whose entries either point to data that outlives the call (such as literal
+ * spans of the format string) or to converted fragments staged in
+ * @ref stage. It is only handed to the stream when either of them overflows
+ * or when formatting finishes. When writing to memory, @ref buf points to the
+ * caller's buffer instead. */
+struct printf_out {
+    struct vnprintf_opts *opts;
+    char *buf; /* Either @ref stage or the destination buffer. */
+    size_t bufcap; /* Capacity of @ref buf. */
+    size_t buflen; /* Number of bytes stored in @ref buf. */
+    ssize_t nwritten; /* Number of bytes produced so far. */
+    int error; /* Set when writing to the stream failed. */
+    struct iovec iov[STREAM_IOV_MAX]; /* Output vector. */
+    int iovcnt; /* Number of entries in @ref iov. */
+    char stage[PRINTF_BUFSIZ]; /* Staging buffer. */
+};
+
+static inline void out_init(
+    struct printf_out *out, struct vnprintf_opts *opts)
+{
+    out->opts = opts;
+    out->buflen = 0;
+    out->nwritten = 0;
+    out->error = 0;
+    out->iovcnt = 0;
+    if (opts->stream != NULL) {
+        out->buf = out->stage;
+        out->bufcap = sizeof(out->stage);
+    } else if (opts->is_bounded) {
+        /* Leave room for the NUL terminator. */
+        out->buf = opts->dest;
+        out->bufcap = opts->n > 0 ? opts->n - 1 : 0;
+    } else {
+        out->buf = opts->dest;
+        out->bufcap = SIZE_MAX;
+    }
+}
+
+static inline void out_flush(struct printf_out *out)
+{
+    if (out->opts->stream == NULL) {
+        return;
+    }
+    if (out->iovcnt > 0 && !out->error
+        && stream_writev(out->opts->stream, out->iov, out->iovcnt) == 0) {
+        out->error = 1;
+    }
+    out->iovcnt = 0;
+    out->buflen = 0;
+}
+
+/* Appends a span to the output vector, merging it with the last entry if
+ * they are contiguous. There must be room for a new entry. */
+static inline void out_push(
+    struct printf_out *out, const char *buf, size_t len)
+{
+    if (out->iovcnt > 0
+        && (const char *)out->iov[out->iovcnt - 1].iov_base
+                + out->iov[out->iovcnt - 1].iov_len
+            == buf) {
+        out->iov[out->iovcnt - 1].iov_len += len;
+        return;
+    }
+    out->iov[out->iovcnt++]
+        = (struct iovec) { .iov_base = (void *)buf, .iov_len = len };
+}
+
+static inline void out_write(
+    struct printf_out *out, const void *buf, size_t len)
+{
+    const char *src = buf;
+    size_t n = len;
+
+    if (out->error || len == 0) {
+        return;
+    }
+    out->nwritten += (ssize_t)len;
+    if (out->opts->stream == NULL) {
+        if (len > out->bufcap - out->buflen) {
+            /* Truncate the output, but keep counting the bytes that would
+             * have been written. */
+            n = out->bufcap - out->buflen;
+        }
+    } else {
+        if (len > out->bufcap - out->buflen
+            || out->iovcnt == STREAM_IOV_MAX) {
+            out_flush(out);
+            if (len >= out->bufcap) {
+                /* The fragment would not fit in the staging buffer anyway,
+                 * so hand it to the stream straight away. */
+                if (!out->error
+                    && stream_write(out->opts->stream, buf, len) != len) {
+                    out->error = 1;
+                }
+                return;
+            }
+        }
+        out_push(out, out->buf + out->buflen, len);
+    }
+    for (size_t i = 0; i < n; i++) {
+        out->buf[out->buflen++] = src[i];
+    }
+}
+
+/* Same as out_write(), but for data that outlives the formatting call, such
+ * as literal spans of the format string or string arguments. Long fragments
+ * are referenced instead of being copied. */
+static inline void out_write_ref(
+    struct printf_out *out, const void *buf, size_t len)
+{
+    if (out->opts->stream == NULL || len < PRINTF_REF_MIN) {
+        out_write(out, buf, len);
+        return;
+    }
+    if (out->error) {
+        return;
+    }
+    out->nwritten += (ssize_t)len;
+    if (out->iovcnt == STREAM_IOV_MAX) {
+        out_flush(out);
+    }
+    out_push(out, buf, len);
+}
+
+static inline void out_fill(struct printf_out *out, char fill, size_t len)
+{
+    out->nwritten += (ssize_t)len;
+    while (len > 0 && !out->error) {
+        size_t n;
+
+        if (out->buflen == out->bufcap
+            || (out->opts->stream != NULL && out->iovcnt == STREAM_IOV_MAX)) {
+            if (out->opts->stream == NULL) {
+                /* Destination buffer is full. */
+                return;
+            }
+            out_flush(out);
+        }
+        n = MIN(len, out->bufcap - out->buflen);
+        if (out->opts->stream != NULL) {
+            out_push(out, out->buf + out->buflen, n);
+        }
+        for (size_t i = 0; i < n; i++) {
+            out->buf[out->buflen++] = fill;
+        }
+        len -= n;
+    }
+}
+
+/* Finishes formatting, returning the number of bytes produced. */
+static inline ssize_t out_finish(struct printf_out *out)
+{
+    out_flush(out);
+    if (out->opts->stream == NULL
+        && (!out->opts->is_bounded || out->opts->n > 0)) {
+        /* NUL-terminate the destination buffer, even if truncated. */
+        out->buf[out->buflen] = '\0';
+    }
+    if (out->error) {
+        return -1;
+    }
+    return out->nwritten;
+}
@@ -15,27 +15,13 @@
  * this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <errno.h>
 #include <stdio.h>
-#include <string.h>
-#include <unistd.h>
 
-int putchar(int val)
-{
-    ssize_t rc;
-    rc = write(0, &val, 1);
-    if (rc < 0) {
-        return (int)rc;
-    }
-    return 0;
-}
+int putchar(int val) { return fputc(val, stdout); }
 
 int puts(const char *str)
 {
-    ssize_t rc;
-    rc = write(0, str, strlen(str));
-    if (rc < 0) {
-        errno = (int)rc;
+    if (fputs(str, stdout) == EOF || fputc('\n', stdout) == EOF) {
         return EOF;
     }
     return 0;
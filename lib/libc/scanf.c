@@ -0,0 +1,382 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "printf_convspec.h"
+#include "strtod.h"
+#include "strtoint.h"
+
+/* Bounds of integer conversions. Unsigned conversions accept a minus sign and
+ * negate the value, as the standard strtoul() does. */
+static const struct strtoint_opts signed_opts = {
+    .min = INTMAX_MIN,
+    .max = INTMAX_MAX,
+};
+static const struct strtoint_opts unsigned_opts = {
+    .min = INTMAX_MIN,
+    .max = UINTMAX_MAX,
+};
+
+/* Fetches the pointer argument of a conversion. Numbered arguments are found
+ * by walking a copy of the argument list, as they are all pointers. */
+static void *fetch_ptr(const struct convspec *cs, va_list *args, va_list *argv)
+{
+    va_list ap;
+    void *ptr;
+
+    if (!cs->has_argno) {
+        return va_arg(*args, void *);
+    }
+    va_copy(ap, *argv);
+    for (uintmax_t i = 1; i < cs->argno; i++) {
+        (void)va_arg(ap, void *);
+    }
+    ptr = va_arg(ap, void *);
+    va_end(ap);
+    return ptr;
+}
+
+static void store_int(void *ptr, enum convspec_length len, uintmax_t val)
+{
+    switch (len) {
+    case CONVSPEC_CHAR:
+        *(signed char *)ptr = (signed char)val;
+        break;
+    case CONVSPEC_SHORT:
+        *(short *)ptr = (short)val;
+        break;
+    case CONVSPEC_LONG:
+        *(long *)ptr = (long)val;
+        break;
+    case CONVSPEC_LONG_LONG:
+        *(long long *)ptr = (long long)val;
+        break;
+    case CONVSPEC_MAX:
+        *(intmax_t *)ptr = (intmax_t)val;
+        break;
+    case CONVSPEC_SIZE:
+        *(size_t *)ptr = (size_t)val;
+        break;
+    case CONVSPEC_PTRDIFF:
+        *(ptrdiff_t *)ptr = (ptrdiff_t)val;
+        break;
+    default:
+        *(int *)ptr = (int)val;
+        break;
+    }
+}
+
+/**
+ * @brief      Builds the bitmap of the characters matched by a scanset.
+ *
+ * @param      map   Bitmap, one bit per character.
+ * @param[in]  set   Characters after the opening bracket of the scanset.
+ */
+static void build_set(uint8_t map[32], const char *set)
+{
+    int invert = *set == '^';
+
+    if (invert) {
+        set++;
+    }
+    for (int i = 0; i < 32; i++) {
+        map[i] = 0;
+    }
+    /* A leading bracket is part of the set. */
+    do {
+        unsigned lo = (unsigned char)set[0], hi = lo;
+
+        if (set[1] == '-' && set[2] != ']'
+            && (unsigned char)set[2] >= (unsigned char)set[0]) {
+            /* Range of characters. */
+            hi = (unsigned char)set[2];
+            set += 2;
+        }
+        /* Characters may be listed more than once. */
+        for (unsigned c = lo; c <= hi; c++) {
+            map[c / 8] |= (uint8_t)(1U << (c % 8));
+        }
+        set++;
+    } while (*set != ']');
+    if (invert) {
+        for (int i = 0; i < 32; i++) {
+            map[i] = (uint8_t)~map[i];
+        }
+    }
+    /* The terminator is never matched. */
+    map[0] &= (uint8_t)~1U;
+}
+
+/* Builds the bitmap of the characters matched by "%s". */
+static void build_nonspace(uint8_t map[32])
+{
+    for (int i = 0; i < 32; i++) {
+        map[i] = 0;
+    }
+    for (unsigned c = 1; c < 256; c++) {
+        if (!isspace((int)c)) {
+            map[c / 8] |= (uint8_t)(1U << (c % 8));
+        }
+    }
+}
+
+/* Finds the end of a field of at most width characters, or returns NULL if
+ * the field is not bounded. */
+static const char *field_end(const struct convspec *cs, const char *s)
+{
+    uintmax_t width = cs->width;
+
+    if (!cs->has_width) {
+        return NULL;
+    }
+    while (width > 0 && *s != '\0') {
+        s++, width--;
+    }
+    return s;
+}
+
+/* Outcome of a directive. */
+enum scan_status {
+    SCAN_OK,
+    /* The input did not match the directive. */
+    SCAN_MATCH_FAILURE,
+    /* The input ended before the directive could be matched. */
+    SCAN_INPUT_FAILURE,
+};
+
+/**
+ * @brief      Scans the field of a conversion other than 'n'.
+ *
+ * @param[in]  cs    Conversion specifier.
+ * @param      sp    Pointer to the input, updated past the field on success.
+ * @param[out] ptr   Where to store the result, or NULL if it is not assigned.
+ *
+ * @return     The outcome of the conversion.
+ */
+static enum scan_status scan_field(
+    const struct convspec *cs, const char **sp, void *ptr)
+{
+    const char *s = *sp, *end;
+    char *next;
+    uint8_t map[32];
+
+    if (cs->conv != 'c' && cs->conv != '[') {
+        while (isspace(*s)) {
+            s++;
+        }
+    }
+    if (*s == '\0') {
+        return SCAN_INPUT_FAILURE;
+    }
+
+    end = field_end(cs, s);
+    switch (cs->conv) {
+    case '%':
+        if (*s != '%') {
+            return SCAN_MATCH_FAILURE;
+        }
+        next = (char *)s + 1;
+        break;
+
+    case 'c':
+        /* Exactly width characters, 1 by default. */
+        if (end == NULL) {
+            end = s + 1;
+        } else if ((uintmax_t)(end - s) < cs->width) {
+            return SCAN_INPUT_FAILURE;
+        }
+        for (char *dst = ptr; dst != NULL && s < end; s++) {
+            *dst++ = *s;
+        }
+        next = (char *)end;
+        break;
+
+    case 's':
+    case '[':
+        if (cs->conv == '[') {
+            build_set(map, cs->set);
+        } else {
+            build_nonspace(map);
+        }
+        next = (char *)s;
+        while (next != end
+            && (map[(unsigned char)*next / 8] >> ((unsigned char)*next % 8))
+                & 1) {
+            next++;
+        }
+        if (next == s) {
+            return SCAN_MATCH_FAILURE;
+        }
+        if (ptr != NULL) {
+            char *dst = ptr;
+
+            while (s < next) {
+                *dst++ = *s++;
+            }
+            *dst = '\0';
+        }
+        break;
+
+    case 'a':
+    case 'A':
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+        if (cs->len == CONVSPEC_LONG) {
+            double val = strtod_range(s, end, &next);
+
+            if (next != s && ptr != NULL) {
+                *(double *)ptr = val;
+            }
+        } else {
+            float val = strtof_range(s, end, &next);
+
+            if (next != s && ptr != NULL) {
+                *(float *)ptr = val;
+            }
+        }
+        if (next == s) {
+            return SCAN_MATCH_FAILURE;
+        }
+        break;
+
+    default: {
+        /* Integer conversions, parsed in place. */
+        int base = cs->conv == 'd' || cs->conv == 'u' ? 10
+            : cs->conv == 'o'                         ? 8
+            : cs->conv == 'i'                         ? 0
+                                                      : 16;
+        int is_signed = cs->conv == 'd' || cs->conv == 'i';
+        uintmax_t val;
+
+        val = strtoint(
+            s, end, &next, base, is_signed ? signed_opts : unsigned_opts);
+        if (next == s) {
+            return SCAN_MATCH_FAILURE;
+        }
+        if (ptr != NULL && cs->conv == 'p') {
+            *(void **)ptr = (void *)(uintptr_t)val;
+        } else if (ptr != NULL) {
+            store_int(ptr, cs->len, val);
+        }
+        break;
+    }
+    }
+
+    *sp = next;
+    return SCAN_OK;
+}
+
+int vsscanf(const char *restrict str, const char *restrict fmt, va_list args)
+{
+    enum scan_status status = SCAN_OK;
+    const char *s = str;
+    struct convspec cs;
+    int nassigned = 0, ndone = 0, nconv = 0, positional = 0, nskip, valid;
+    void *ptr;
+    va_list ap, argv;
+
+    va_copy(ap, args);
+    va_copy(argv, args);
+    while (*fmt != '\0' && status == SCAN_OK) {
+        if (isspace(*fmt)) {
+            /* Whitespace matches any amount of whitespace, even none. */
+            while (isspace(*fmt)) {
+                fmt++;
+            }
+            while (isspace(*s)) {
+                s++;
+            }
+            continue;
+        }
+        if (*fmt != '%') {
+            /* Other characters must match exactly. */
+            if (*s == '\0') {
+                status = SCAN_INPUT_FAILURE;
+            } else if (*s != *fmt) {
+                status = SCAN_MATCH_FAILURE;
+            } else {
+                s++, fmt++;
+            }
+            continue;
+        }
+
+        nskip = convspec_parse_scan(&cs, fmt);
+        valid = nskip > 0
+            && (!cs.has_argno || (cs.argno > 0 && cs.argno <= NL_ARGMAX));
+        if (valid && cs.conv != '%' && !(cs.flags & CONVSPEC_STAR)) {
+            if (nconv++ == 0) {
+                /* Either all conversions are numbered, or none is. */
+                positional = cs.has_argno;
+            }
+            valid = cs.has_argno == positional;
+        }
+        if (!valid) {
+            if (nskip >= 0 || errno != ENOSYS) {
+                errno = EINVAL;
+            }
+            nassigned = EOF;
+            break;
+        }
+        fmt += nskip;
+
+        ptr = cs.conv == '%' || (cs.flags & CONVSPEC_STAR)
+            ? NULL
+            : fetch_ptr(&cs, &ap, &argv);
+        if (cs.conv == 'n') {
+            /* Not a conversion, so it is not counted. */
+            store_int(ptr, cs.len, (uintmax_t)(s - str));
+            continue;
+        }
+
+        status = scan_field(&cs, &s, ptr);
+        if (status == SCAN_OK && cs.conv != '%') {
+            ndone++;
+            nassigned += ptr != NULL;
+        }
+    }
+    if (status == SCAN_INPUT_FAILURE && ndone == 0) {
+        /* The input ended before the first conversion. */
+        nassigned = EOF;
+    }
+
+    va_end(argv);
+    va_end(ap);
+    return nassigned;
+}
+
+int sscanf(const char *restrict str, const char *restrict fmt, ...)
+{
+    va_list args;
+    int rc;
+
+    va_start(args, fmt);
+    rc = vsscanf(str, fmt, args);
+    va_end(args);
+
+    return rc;
+}
@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/bitops.h>
+
+/* qsort() is an introsort: a quicksort that falls back to heapsort when it
+ * recurses too deep, and leaves short runs to insertion sort or, below five
+ * elements, to sorting networks. */
+
+/* Longest run left to insertion sort. */
+#define SORT_SMALL 12
+/* Shortest run whose pivot is the median of three medians. */
+#define SORT_NINTHER 128
+
+typedef uint32_t __attribute__((__may_alias__)) sort_word32;
+typedef uint64_t __attribute__((__may_alias__)) sort_word64;
+
+typedef int (*sort_cmp)(const void *, const void *);
+typedef void (*sort_swap)(void *a, void *b, size_t size);
+
+/* Parameters of a sort, shared by every step. */
+struct sort_ctx {
+    size_t size;
+    sort_cmp cmp;
+    sort_swap swap;
+};
+
+/* Element swaps, specialized for the sizes of the usual scalar types and
+ * for pairs of them. Each one is only used if the elements are aligned for
+ * it. */
+static void swap_4(void *a, void *b, size_t size)
+{
+    sort_word32 t = *(sort_word32 *)a;
+    *(sort_word32 *)a = *(sort_word32 *)b;
+    *(sort_word32 *)b = t;
+}
+
+static void swap_8(void *a, void *b, size_t size)
+{
+    sort_word64 t = *(sort_word64 *)a;
+    *(sort_word64 *)a = *(sort_word64 *)b;
+    *(sort_word64 *)b = t;
+}
+
+static void swap_16(void *a, void *b, size_t size)
+{
+    sort_word64 *x = a, *y = b;
+    sort_word64 t0 = x[0], t1 = x[1];
+    x[0] = y[0], x[1] = y[1];
+    y[0] = t0, y[1] = t1;
+}
+
+static void swap_words(void *a, void *b, size_t size)
+{
+    sort_word64 *x = a, *y = b, t;
+    for (; size > 0; size -= sizeof(*x)) {
+        t = *x, *x++ = *y, *y++ = t;
+    }
+}
+
+static void swap_bytes(void *a, void *b, size_t size)
+{
+    unsigned char *x = a, *y = b, t;
+    while (size-- > 0) {
+        t = *x, *x++ = *y, *y++ = t;
+    }
+}
+
+/**
+ * @brief      Chooses the fastest swap for the elements of an array.
+ *
+ * @param[in]  base  The array.
+ * @param[in]  size  The size of each element.
+ *
+ * @return     The swap function.
+ */
+static sort_swap sort_swap_for(const void *base, size_t size)
+{
+    uintptr_t align = (uintptr_t)base | size;
+
+    if (align % sizeof(sort_word64) == 0) {
+        if (size == 8) {
+            return swap_8;
+        }
+        return size == 16 ? swap_16 : swap_words;
+    }
+    if (size == 4 && align % sizeof(sort_word32) == 0) {
+        return swap_4;
+    }
+    return swap_bytes;
+}
+
+/* Swaps two elements if they are out of order. */
+static inline void sort_cswap(char *a, char *b, const struct sort_ctx *ctx)
+{
+    if (ctx->cmp(a, b) > 0) {
+        ctx->swap(a, b, ctx->size);
+    }
+}
+
+/* Comparators of the optimal sorting networks for two to four elements. */
+static const unsigned char sort_network[][10] = {
+    { 0 },
+    { 0 },
+    { 0, 1 },
+    { 0, 1, 1, 2, 0, 1 },
+    { 0, 1, 2, 3, 0, 2, 1, 3, 1, 2 },
+};
+
+/* Number of comparators of each network. */
+static const unsigned char sort_network_len[] = { 0, 0, 1, 3, 5 };
+
+static void small_sort(char *base, size_t n, const struct sort_ctx *ctx)
+{
+    size_t size = ctx->size;
+    char *end = base + n * size;
+    char *i, *j;
+
+    if (n < sizeof(sort_network_len)) {
+        const unsigned char *net = sort_network[n];
+        for (size_t k = 0; k < sort_network_len[n]; k++, net += 2) {
+            sort_cswap(base + net[0] * size, base + net[1] * size, ctx);
+        }
+        return;
+    }
+    for (i = base + size; i < end; i += size) {
+        for (j = i; j > base && ctx->cmp(j - size, j) > 0; j -= size) {
+            ctx->swap(j - size, j, size);
+        }
+    }
+}
+
+/* Moves an element down a max-heap until its children are not greater. */
+static void sift_down(char *base, size_t root, size_t n,
+    const struct sort_ctx *ctx)
+{
+    size_t size = ctx->size;
+    size_t child;
+
+    while ((child = 2 * root + 1) < n) {
+        if (child + 1 < n
+            && ctx->cmp(base + child * size, base + (child + 1) * size) < 0) {
+            child++;
+        }
+        if (ctx->cmp(base + root * size, base + child * size) >= 0) {
+            return;
+        }
+        ctx->swap(base + root * size, base + child * size, size);
+        root = child;
+    }
+}
+
+static void heap_sort(char *base, size_t n, const struct sort_ctx *ctx)
+{
+    size_t i;
+
+    for (i = n / 2; i-- > 0;) {
+        sift_down(base, i, n, ctx);
+    }
+    for (i = n; i-- > 1;) {
+        ctx->swap(base, base + i * ctx->size, ctx->size);
+        sift_down(base, 0, i, ctx);
+    }
+}
+
+static char *median3(char *a, char *b, char *c, const struct sort_ctx *ctx)
+{
+    if (ctx->cmp(a, b) < 0) {
+        if (ctx->cmp(b, c) < 0) {
+            return b;
+        }
+        return ctx->cmp(a, c) < 0 ? c : a;
+    }
+    if (ctx->cmp(b, c) > 0) {
+        return b;
+    }
+    return ctx->cmp(a, c) > 0 ? c : a;
+}
+
+/**
+ * @brief      Chooses a pivot for a run of elements.
+ *
+ * @param      base  The first element of the run.
+ * @param[in]  n     The number of elements in the run.
+ * @param[in]  ctx   The sort parameters.
+ *
+ * @return     The pivot, which is one of the elements.
+ */
+static char *sort_pivot(char *base, size_t n, const struct sort_ctx *ctx)
+{
+    size_t size = ctx->size;
+    char *mid = base + n / 2 * size;
+    char *last = base + (n - 1) * size;
+    size_t step;
+
+    /* Tukey's ninther resists the inputs that defeat a plain median of
+     * three, such as organ pipes. */
+    if (n >= SORT_NINTHER) {
+        step = n / 8 * size;
+        base = median3(base, base + step, base + 2 * step, ctx);
+        mid = median3(mid - step, mid, mid + step, ctx);
+        last = median3(last - 2 * step, last - step, last, ctx);
+    }
+    return median3(base, mid, last, ctx);
+}
+
+static void intro_sort(char *base, size_t n, unsigned depth,
+    const struct sort_ctx *ctx)
+{
+    size_t size = ctx->size;
+    size_t left, right;
+    char *i, *j;
+
+    while (n > SORT_SMALL) {
+        if (depth-- == 0) {
+            heap_sort(base, n, ctx);
+            return;
+        }
+        ctx->swap(base, sort_pivot(base, n, ctx), size);
+
+        /* Hoare partition around the pivot at base. Both scans stop at
+         * elements equal to it, which splits runs of equal elements in
+         * halves. */
+        i = base;
+        j = base + n * size;
+        for (;;) {
+            do {
+                i += size;
+            } while (i < j && ctx->cmp(i, base) < 0);
+            do {
+                j -= size;
+            } while (ctx->cmp(j, base) > 0);
+            if (i >= j) {
+                break;
+            }
+            ctx->swap(i, j, size);
+        }
+        ctx->swap(base, j, size);
+
+        /* Recursing into the shorter side only bounds the stack to a
+         * logarithmic depth. */
+        left = (size_t)(j - base) / size;
+        right = n - left - 1;
+        if (left < right) {
+            intro_sort(base, left, depth, ctx);
+            base = j + size;
+            n = right;
+        } else {
+            intro_sort(j + size, right, depth, ctx);
+            n = left;
+        }
+    }
+    small_sort(base, n, ctx);
+}
+
+void qsort(void *base, size_t nmemb, size_t size,
+    int (*compar)(const void *, const void *))
+{
+    struct sort_ctx ctx;
+
+    if (nmemb < 2 || size == 0) {
+        return;
+    }
+    ctx.size = size;
+    ctx.cmp = compar;
+    ctx.swap = sort_swap_for(base, size);
+    intro_sort(base, nmemb, 2 * fls64(nmemb), &ctx);
+}
+
+void *bsearch(const void *key, const void *base, size_t nmemb, size_t size,
+    int (*compar)(const void *, const void *))
+{
+    const char *lo = base;
+    size_t half;
+
+    if (nmemb == 0) {
+        return NULL;
+    }
+    /* Any element equal to the key stays within the nmemb elements from lo.
+     * The loop runs the same number of times whatever the comparisons
+     * return, and lo moves by a multiplication instead of a branch, so that
+     * there are no mispredictions to pay for. */
+    while (nmemb > 1) {
+        half = nmemb / 2;
+        /* Fetch both candidates for the next step while this one waits for
+         * the comparison. */
+        __builtin_prefetch(lo + half / 2 * size);
+        __builtin_prefetch(lo + (half + half / 2) * size);
+        lo += (size_t)(compar(key, lo + half * size) >= 0) * half * size;
+        nmemb -= half;
+    }
+    return compar(key, lo) == 0 ? (void *)lo : NULL;
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "stdio_impl.h"
+
+static char stdout_buf[BUFSIZ];
+static char stderr_buf[BUFSIZ];
+
+static FILE stdout_file = {
+    .fd = STDOUT_FILENO,
+    .mode = _IOLBF,
+    .buf = stdout_buf,
+    .bufsiz = sizeof(stdout_buf),
+    .defbuf = stdout_buf,
+    .defbufsiz = sizeof(stdout_buf),
+};
+
+static FILE stderr_file = {
+    .fd = STDERR_FILENO,
+    .mode = _IONBF,
+    .defbuf = stderr_buf,
+    .defbufsiz = sizeof(stderr_buf),
+};
+
+FILE *stdout = &stdout_file;
+FILE *stderr = &stderr_file;
+
+/* Writes a list of buffers to a file descriptor, retrying on short writes.
+ * The list is modified in the process. */
+static int writev_all(FILE *stream, struct iovec *iov, int iovcnt)
+{
+    ssize_t rc;
+    size_t n;
+
+    for (;;) {
+        /* Skip buffers that have been written entirely. */
+        while (iovcnt > 0 && iov->iov_len == 0) {
+            iov++, iovcnt--;
+        }
+        if (iovcnt == 0) {
+            return 0;
+        }
+        rc = writev(stream->fd, iov, iovcnt);
+        if (rc <= 0) {
+            stream->error = 1;
+            return EOF;
+        }
+        for (n = (size_t)rc; n > 0 && n >= iov->iov_len; iov++, iovcnt--) {
+            n -= iov->iov_len;
+        }
+        if (n > 0) {
+            iov->iov_base = (char *)iov->iov_base + n;
+            iov->iov_len -= n;
+        }
+    }
+}
+
+int fflush(FILE *stream)
+{
+    struct iovec iov;
+    int rc = 0;
+
+    if (stream == NULL) {
+        rc |= fflush(stdout);
+        rc |= fflush(stderr);
+        return rc;
+    }
+    if (stream->buflen > 0) {
+        iov = (struct iovec) { .iov_base = stream->buf,
+            .iov_len = stream->buflen };
+        rc = writev_all(stream, &iov, 1);
+        /* Buffered data is discarded even on error, so that the stream can
+         * be used again after clearerr(). */
+        stream->buflen = 0;
+    }
+    return rc;
+}
+
+size_t stream_writev(FILE *stream, const struct iovec *iov, int iovcnt)
+{
+    struct iovec vec[STREAM_IOV_MAX + 1];
+    size_t total = 0;
+    int nl = 0;
+
+    if (iovcnt > STREAM_IOV_MAX) {
+        /* Leave room for the buffered data in front of the vector. */
+        total = stream_writev(stream, iov, STREAM_IOV_MAX);
+        if (total == 0) {
+            return 0;
+        }
+        return total
+            + stream_writev(stream, iov + STREAM_IOV_MAX,
+                iovcnt - STREAM_IOV_MAX);
+    }
+    for (int i = 0; i < iovcnt; i++) {
+        total += iov[i].iov_len;
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    if (total > stream->bufsiz - stream->buflen) {
+        /* The data does not fit in the buffer (which is always the case
+         * when unbuffered), so write it right after the buffered data,
+         * without copying it and in a single call. */
+        vec[0] = (struct iovec) { .iov_base = stream->buf,
+            .iov_len = stream->buflen };
+        for (int i = 0; i < iovcnt; i++) {
+            vec[i + 1] = iov[i];
+        }
+        stream->buflen = 0;
+        return writev_all(stream, vec, iovcnt + 1) == 0 ? total : 0;
+    }
+
+    for (int i = 0; i < iovcnt; i++) {
+        const char *src = iov[i].iov_base;
+
+        for (size_t j = 0; j < iov[i].iov_len; j++) {
+            stream->buf[stream->buflen++] = src[j];
+        }
+        if (stream->mode == _IOLBF && !nl) {
+            /* Line-buffered streams are flushed once a newline is
+             * written. */
+            for (size_t j = iov[i].iov_len; j > 0 && !nl; j--) {
+                nl = src[j - 1] == '\n';
+            }
+        }
+    }
+    if (nl && fflush(stream) != 0) {
+        return 0;
+    }
+    return total;
+}
+
+size_t stream_write(FILE *stream, const char *src, size_t len)
+{
+    struct iovec iov = { .iov_base = (void *)src, .iov_len = len };
+
+    return stream_writev(stream, &iov, 1);
+}
+
+int setvbuf(FILE *restrict stream, char *restrict buf, int mode, size_t size)
+{
+    if (mode != _IOFBF && mode != _IOLBF && mode != _IONBF) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (fflush(stream) != 0) {
+        return -1;
+    }
+
+    stream->mode = mode;
+    if (mode == _IONBF) {
+        stream->buf = NULL;
+        stream->bufsiz = 0;
+    } else if (buf == NULL) {
+        stream->buf = stream->defbuf;
+        stream->bufsiz = stream->defbufsiz;
+    } else {
+        stream->buf = buf;
+        stream->bufsiz = size;
+    }
+    return 0;
+}
+
+size_t fwrite(const void *restrict ptr, size_t size, size_t nmemb,
+    FILE *restrict stream)
+{
+    size_t len = size * nmemb;
+
+    if (size == 0 || nmemb == 0) {
+        return 0;
+    }
+    if (len / nmemb != size) {
+        /* Total size overflows. */
+        errno = EINVAL;
+        return 0;
+    }
+    return stream_write(stream, ptr, len) / size;
+}
+
+int fputc(int val, FILE *stream)
+{
+    unsigned char c = (unsigned char)val;
+
+    if (stream->buflen < stream->bufsiz
+        && (c != '\n' || stream->mode == _IOFBF)) {
+        /* Fast path: the byte fits and no flush is needed. */
+        stream->buf[stream->buflen++] = (char)c;
+        return c;
+    }
+    if (stream_write(stream, (const char *)&c, 1) != 1) {
+        return EOF;
+    }
+    return c;
+}
+
+int putc(int val, FILE *stream) { return fputc(val, stream); }
+
+int fputs(const char *restrict str, FILE *restrict stream)
+{
+    size_t len = strlen(str);
+
+    if (stream_write(stream, str, len) != len) {
+        return EOF;
+    }
+    return 0;
+}
+
+int ferror(FILE *stream) { return stream->error; }
+
+void clearerr(FILE *stream) { stream->error = 0; }
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdio.h>
+#include <sys/uio.h>
+
+/* Maximum number of buffers that can be passed to stream_writev(). */
+#define STREAM_IOV_MAX 16
+
+/* An output stream. */
+struct _FILE {
+    int fd; /* Destination file descriptor. */
+    int mode; /* Buffering mode (_IOFBF, _IOLBF or _IONBF). */
+    int error; /* Error indicator. */
+    char *buf; /* Buffer, or NULL if unbuffered. */
+    size_t bufsiz; /* Capacity of @ref buf. */
+    size_t buflen; /* Number of bytes stored in @ref buf. */
+    char *defbuf; /* Buffer used when setvbuf() is given none. */
+    size_t defbufsiz; /* Capacity of @ref defbuf. */
+};
+
+/**
+ * @brief      Writes a list of buffers to a stream, honoring its buffering
+ *             mode. Data that does not fit in the stream buffer is written
+ *             along with it in a single writev() call instead of being
+ *             copied.
+ *
+ * @param[in]  stream  The stream.
+ * @param[in]  iov     The buffers to be written.
+ * @param[in]  iovcnt  The number of buffers, no greater than
+ *                     @ref STREAM_IOV_MAX.
+ *
+ * @return     On success, the total length of the buffers. On error, 0 is
+ *             returned and the error indicator of the stream is set.
+ */
+size_t stream_writev(FILE *stream, const struct iovec *iov, int iovcnt);
+
+/**
+ * @brief      Writes data to a stream, honoring its buffering mode.
+ *
+ * @param[in]  stream  The stream.
+ * @param[in]  src     The data to be written.
+ * @param[in]  len     The number of bytes to be written.
+ *
+ * @return     On success, @p len. On error, 0 is returned and the error
+ *             indicator of the stream is set.
+ */
+size_t stream_write(FILE *stream, const char *src, size_t len);
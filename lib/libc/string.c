@@ -15,23 +15,132 @@
  * this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "string_impl.h"
 #include <string.h>
+#include <sys/init.h>
+#include <sys/hwcap.h>
 
-size_t strlen(const char *str)
+static size_t strlen_generic(const char *str)
 {
+#ifdef STRING_WORD
+    const string_word *w
+        = (const string_word *)(str - (uintptr_t)str % WORD_SIZE);
+    uint64_t mask = word_zero(word_head(str, 0));
+    while (mask == 0) {
+        mask = word_zero(*++w);
+    }
+    return (size_t)((const char *)w - str) + word_index(mask);
+#else
     size_t len = 0;
     while (*str++) {
         len++;
     }
     return len;
+#endif
 }
 
-int strcmp(const char *str1, const char *str2)
+static int strcmp_generic(const char *str1, const char *str2)
+{
+    const unsigned char *s1 = (const unsigned char *)str1;
+    const unsigned char *s2 = (const unsigned char *)str2;
+#ifdef STRING_WORD
+    /* Words can only be compared when both strings share their alignment,
+     * since an unaligned load could cross into an unmapped page. */
+    if ((uintptr_t)s1 % WORD_SIZE == (uintptr_t)s2 % WORD_SIZE) {
+        while ((uintptr_t)s1 % WORD_SIZE != 0) {
+            if (*s1 == '\0' || *s1 != *s2) {
+                return *s1 - *s2;
+            }
+            ++s1, ++s2;
+        }
+        for (;;) {
+            uint64_t w1 = *(const string_word *)s1;
+            if (w1 != *(const string_word *)s2 || word_zero(w1) != 0) {
+                break;
+            }
+            s1 += WORD_SIZE, s2 += WORD_SIZE;
+        }
+    }
+#endif
+    while (*s1 != '\0' && *s1 == *s2) {
+        ++s1, ++s2;
+    }
+    return *s1 - *s2;
+}
+
+char *strchr(const char *str, int c)
 {
-    while (*str1 != '\0' && *str1 == *str2) {
-        ++str1, ++str2;
+    unsigned char ch = (unsigned char)c;
+#ifdef STRING_WORD
+    const string_word *w
+        = (const string_word *)(str - (uintptr_t)str % WORD_SIZE);
+    uint64_t rep = word_repeat(ch);
+    uint64_t head = word_head(str, ch);
+    uint64_t mask = word_zero(head) | word_zero(head ^ rep);
+    while (mask == 0) {
+        ++w;
+        mask = word_zero(*w) | word_zero(*w ^ rep);
+    }
+    str = (const char *)w + word_index(mask);
+#else
+    while (*str != '\0' && (unsigned char)*str != ch) {
+        str++;
     }
-    return *str1 - *str2;
+#endif
+    return (unsigned char)*str == ch ? (char *)str : NULL;
+}
+
+static void *memchr_generic(const void *src, int c, size_t len)
+{
+    const unsigned char *p = src;
+    unsigned char ch = (unsigned char)c;
+#ifdef STRING_WORD
+    uint64_t rep = word_repeat(ch);
+    while (len > 0 && (uintptr_t)p % WORD_SIZE != 0) {
+        if (*p == ch) {
+            return (void *)p;
+        }
+        p++, len--;
+    }
+    while (len >= WORD_SIZE && word_zero(*(const string_word *)p ^ rep) == 0) {
+        p += WORD_SIZE, len -= WORD_SIZE;
+    }
+#endif
+    while (len > 0) {
+        if (*p == ch) {
+            return (void *)p;
+        }
+        p++, len--;
+    }
+    return NULL;
+}
+
+size_t strspn(const char *str, const char *accept)
+{
+    uint64_t map[4] = { 0 };
+    const unsigned char *s = (const unsigned char *)str;
+    /* The terminator is never in the set, so the scan stops there. */
+    for (const unsigned char *a = (const unsigned char *)accept; *a; a++) {
+        map[*a / 64U] |= 1ULL << (*a % 64U);
+    }
+    while (map[*s / 64U] & (1ULL << (*s % 64U))) {
+        s++;
+    }
+    return (size_t)(s - (const unsigned char *)str);
+}
+
+size_t strcspn(const char *str, const char *reject)
+{
+    uint64_t map[4] = { 1 };
+    const unsigned char *s = (const unsigned char *)str;
+    /* The terminator is always in the set, so the scan stops there. */
+    for (const unsigned char *r = (const unsigned char *)reject; *r; r++) {
+        map[*r / 64U] |= 1ULL << (*r % 64U);
+    }
+    while (!(map[*s / 64U] & (1ULL << (*s % 64U)))) {
+        s++;
+    }
+    return (size_t)(s - (const unsigned char *)str);
 }
 
 char *strcat(char *restrict dst, const char *restrict src)
@@ -50,11 +159,276 @@ char *strncat(char *restrict dst, const char *restrict src, size_t n)
     return dst_orig;
 }
 
-void *memset(void *dst, int v, size_t len)
+#ifdef STRING_WORD
+/* Copies eight aligned words, loading all of them before storing any so that
+ * the copy is safe in both directions when the buffers overlap. */
+static void copy_block(string_word *dw, const string_word *sw)
+{
+    uint64_t w0 = sw[0], w1 = sw[1], w2 = sw[2], w3 = sw[3];
+    uint64_t w4 = sw[4], w5 = sw[5], w6 = sw[6], w7 = sw[7];
+    dw[0] = w0, dw[1] = w1, dw[2] = w2, dw[3] = w3;
+    dw[4] = w4, dw[5] = w5, dw[6] = w6, dw[7] = w7;
+}
+#endif
+
+/**
+ * @brief      Copies a buffer from its first byte to its last one. The buffers
+ *             may overlap as long as the destination precedes the source.
+ *
+ * @param      d     Destination buffer.
+ * @param[in]  s     Source buffer.
+ * @param[in]  len   Number of bytes to be copied.
+ */
+static void copy_forward(unsigned char *d, const unsigned char *s, size_t len)
+{
+#ifdef STRING_WORD
+    if (len >= 2 * WORD_SIZE) {
+        string_word *dw;
+        size_t off;
+        while ((uintptr_t)d % WORD_SIZE != 0) {
+            *d++ = *s++, len--;
+        }
+        dw = (string_word *)d;
+        off = (uintptr_t)s % WORD_SIZE;
+        if (off == 0) {
+            const string_word *sw = (const string_word *)s;
+            for (; len >= 8 * WORD_SIZE; len -= 8 * WORD_SIZE) {
+                copy_block(dw, sw);
+                dw += 8, sw += 8;
+            }
+            for (; len >= WORD_SIZE; len -= WORD_SIZE) {
+                *dw++ = *sw++;
+            }
+            s = (const unsigned char *)sw;
+        } else {
+            /* Each destination word is merged from the two aligned source
+             * words it straddles. */
+            const string_word *sw = (const string_word *)(s - off);
+            unsigned shr = off * 8U, shl = 64U - shr;
+            uint64_t lo = *sw++;
+            for (; len >= WORD_SIZE; len -= WORD_SIZE) {
+                uint64_t hi = *sw++;
+                *dw++ = (lo >> shr) | (hi << shl);
+                lo = hi;
+            }
+            s = (const unsigned char *)(sw - 1) + off;
+        }
+        d = (unsigned char *)dw;
+    }
+#endif
+    while (len-- > 0) {
+        *d++ = *s++;
+    }
+}
+
+/**
+ * @brief      Copies a buffer from its last byte to its first one. The buffers
+ *             may overlap as long as the source precedes the destination.
+ *
+ * @param      d     End of the destination buffer.
+ * @param[in]  s     End of the source buffer.
+ * @param[in]  len   Number of bytes to be copied.
+ */
+static void copy_backward(unsigned char *d, const unsigned char *s, size_t len)
+{
+#ifdef STRING_WORD
+    if (len >= 2 * WORD_SIZE) {
+        string_word *dw;
+        size_t off;
+        while ((uintptr_t)d % WORD_SIZE != 0) {
+            *--d = *--s, len--;
+        }
+        dw = (string_word *)d;
+        off = (uintptr_t)s % WORD_SIZE;
+        if (off == 0) {
+            const string_word *sw = (const string_word *)s;
+            for (; len >= 8 * WORD_SIZE; len -= 8 * WORD_SIZE) {
+                dw -= 8, sw -= 8;
+                copy_block(dw, sw);
+            }
+            for (; len >= WORD_SIZE; len -= WORD_SIZE) {
+                *--dw = *--sw;
+            }
+            s = (const unsigned char *)sw;
+        } else {
+            const string_word *sw = (const string_word *)(s - off);
+            unsigned shr = off * 8U, shl = 64U - shr;
+            uint64_t hi = *sw;
+            for (; len >= WORD_SIZE; len -= WORD_SIZE) {
+                uint64_t lo = *--sw;
+                *--dw = (lo >> shr) | (hi << shl);
+                hi = lo;
+            }
+            s = (const unsigned char *)sw + off;
+        }
+        d = (unsigned char *)dw;
+    }
+#endif
+    while (len-- > 0) {
+        *--d = *--s;
+    }
+}
+
+static void *memcpy_generic(
+    void *restrict dst, const void *restrict src, size_t len)
+{
+    copy_forward(dst, src, len);
+    return dst;
+}
+
+void *memmove(void *dst, const void *src, size_t len)
+{
+    unsigned char *d = dst;
+    const unsigned char *s = src;
+    /* Copying forward is only unsafe when the destination starts inside the
+     * source. */
+    if ((uintptr_t)d - (uintptr_t)s >= len) {
+        copy_forward(d, s, len);
+    } else if (d != s) {
+        copy_backward(d + len, s + len, len);
+    }
+    return dst;
+}
+
+static int memcmp_generic(const void *src1, const void *src2, size_t len)
+{
+    const unsigned char *s1 = src1;
+    const unsigned char *s2 = src2;
+#ifdef STRING_WORD
+    if (len >= 2 * WORD_SIZE) {
+        const string_word *sw;
+        size_t off;
+        unsigned shr, shl;
+        while ((uintptr_t)s1 % WORD_SIZE != 0) {
+            if (*s1 != *s2) {
+                return *s1 - *s2;
+            }
+            s1++, s2++, len--;
+        }
+        /* Words of the second buffer are merged as in copy_forward() when it
+         * is not aligned like the first one. */
+        off = (uintptr_t)s2 % WORD_SIZE;
+        sw = (const string_word *)(s2 - off);
+        shr = off * 8U, shl = 64U - shr;
+        for (; len >= WORD_SIZE; len -= WORD_SIZE, sw++) {
+            uint64_t w2 = sw[0];
+            if (off != 0) {
+                w2 = (w2 >> shr) | (sw[1] << shl);
+            }
+            if (*(const string_word *)s1 != w2) {
+                break;
+            }
+            s1 += WORD_SIZE, s2 += WORD_SIZE;
+        }
+    }
+#endif
+    for (; len > 0; s1++, s2++, len--) {
+        if (*s1 != *s2) {
+            return *s1 - *s2;
+        }
+    }
+    return 0;
+}
+
+static void *memset_generic(void *dst, int v, size_t len)
 {
     unsigned char *buf = ((unsigned char *)dst);
-    for (size_t i = 0; i < len; i++) {
-        buf[i] = (unsigned char)v & 0xFFU;
+    unsigned char c = (unsigned char)v & 0xFFU;
+#ifdef STRING_WORD
+    if (len >= 2 * WORD_SIZE) {
+        uint64_t rep = word_repeat(c);
+        string_word *w;
+        while ((uintptr_t)buf % WORD_SIZE != 0) {
+            *buf++ = c, len--;
+        }
+        w = (string_word *)buf;
+        for (; len >= 8 * WORD_SIZE; len -= 8 * WORD_SIZE, w += 8) {
+            w[0] = rep, w[1] = rep, w[2] = rep, w[3] = rep;
+            w[4] = rep, w[5] = rep, w[6] = rep, w[7] = rep;
+        }
+        for (; len >= WORD_SIZE; len -= WORD_SIZE) {
+            *w++ = rep;
+        }
+        buf = (unsigned char *)w;
+    }
+#endif
+    while (len-- > 0) {
+        *buf++ = c;
     }
     return dst;
 }
+
+/* Implementations in use, chosen by string_init(). */
+static struct string_ops string_ops __ro_after_init = {
+    .memcpy = memcpy_generic,
+    .memset = memset_generic,
+    .memcmp = memcmp_generic,
+    .memchr = memchr_generic,
+    .strlen = strlen_generic,
+    .strcmp = strcmp_generic,
+};
+
+void string_init(unsigned long hwcap)
+{
+#ifdef STRING_RISCV64
+    if (hwcap & HWCAP_ZBB) {
+        string_ops.memchr = memchr_zbb;
+        string_ops.strlen = strlen_zbb;
+        string_ops.strcmp = strcmp_zbb;
+    }
+    /* Vector loops outpace Zbb ones, so they take precedence. */
+    if (hwcap & HWCAP_ISA_V) {
+        string_ops.memcpy = memcpy_rvv;
+        string_ops.memset = memset_rvv;
+        string_ops.memcmp = memcmp_rvv;
+        string_ops.memchr = memchr_rvv;
+        string_ops.strlen = strlen_rvv;
+        string_ops.strcmp = strcmp_rvv;
+    }
+#endif
+}
+
+size_t strlen(const char *str) { return string_ops.strlen(str); }
+
+int strcmp(const char *str1, const char *str2)
+{
+    return string_ops.strcmp(str1, str2);
+}
+
+void *memchr(const void *src, int c, size_t len)
+{
+    return string_ops.memchr(src, c, len);
+}
+
+void *memcpy(void *restrict dst, const void *restrict src, size_t len)
+{
+    return string_ops.memcpy(dst, src, len);
+}
+
+int memcmp(const void *src1, const void *src2, size_t len)
+{
+    return string_ops.memcmp(src1, src2, len);
+}
+
+void *memset(void *dst, int v, size_t len)
+{
+    return string_ops.memset(dst, v, len);
+}
+
+char *strrchr(const char *str, int c)
+{
+    const char *last = NULL;
+    if ((unsigned char)c == '\0') {
+        return (char *)str + strlen(str);
+    }
+    while ((str = strchr(str, c)) != NULL) {
+        last = str++;
+    }
+    return (char *)last;
+}
+
+size_t strnlen(const char *str, size_t maxlen)
+{
+    const char *end = memchr(str, '\0', maxlen);
+    return end != NULL ? (size_t)(end - str) : maxlen;
+}
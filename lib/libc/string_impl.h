@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define STRING_WORD 1
+
+/* A word of memory that may alias any object. Aligned word loads never cross
+ * a page boundary, so they may safely read past the end of a string as long
+ * as the bytes that do not belong to it are ignored. */
+typedef uint64_t __attribute__((__may_alias__)) string_word;
+
+#define WORD_SIZE sizeof(string_word)
+#define WORD_ONES 0x0101010101010101ULL
+#define WORD_HIGHS 0x8080808080808080ULL
+
+/**
+ * @brief      Flags the zero bytes of a word. The lowest flag is always exact;
+ *             flags above it may be spurious.
+ *
+ * @param[in]  w     The word.
+ *
+ * @return     A mask with the high bit of each zero byte set, or 0 if the word
+ *             has no zero byte.
+ */
+static inline uint64_t word_zero(uint64_t w)
+{
+    return (w - WORD_ONES) & ~w & WORD_HIGHS;
+}
+
+/**
+ * @brief      Copies a byte to every byte of a word.
+ *
+ * @param[in]  c     The byte.
+ *
+ * @return     The word.
+ */
+static inline uint64_t word_repeat(unsigned char c) { return WORD_ONES * c; }
+
+/**
+ * @brief      Obtains the index of the first flagged byte of a word.
+ *
+ * @param[in]  mask  A non-zero mask as returned by word_zero().
+ *
+ * @return     The index, in memory order, of the lowest flagged byte.
+ */
+static inline size_t word_index(uint64_t mask)
+{
+    /* Each byte below the flag, and the flagged one, contributes a one to
+     * the sum accumulated by the multiplication in the top byte. */
+    return (size_t)(((((mask & -mask) - 1) & WORD_ONES) * WORD_ONES) >> 56U)
+        - 1;
+}
+
+/**
+ * @brief      Obtains the aligned word that holds the first byte of a string,
+ *             with the bytes before the string set to a non-zero value.
+ *
+ * @param[in]  str   The string.
+ * @param[in]  c     A byte that the padding bytes must also differ from.
+ *
+ * @return     The word.
+ */
+static inline uint64_t word_head(const char *str, unsigned char c)
+{
+    size_t off = (uintptr_t)str % WORD_SIZE;
+    uint64_t w = *(const string_word *)(str - off);
+    uint64_t pad = ((uint64_t)1 << (off * 8U)) - 1;
+    /* Either 0x01 or 0x02 differs from both '\0' and c. */
+    return (w & ~pad) | (pad & word_repeat(c == 1 ? 2 : 1));
+}
+#endif
+
+#if defined(__riscv) && __riscv_xlen == 64
+#define STRING_RISCV64 1
+
+/* Implementations for harts with the Zbb extension, in arch/riscv64. */
+size_t strlen_zbb(const char *str);
+int strcmp_zbb(const char *str1, const char *str2);
+void *memchr_zbb(const void *src, int c, size_t len);
+
+/* Implementations for harts with the V extension, in arch/riscv64. */
+void *memcpy_rvv(void *restrict dst, const void *restrict src, size_t len);
+void *memset_rvv(void *dst, int v, size_t len);
+int memcmp_rvv(const void *src1, const void *src2, size_t len);
+void *memchr_rvv(const void *src, int c, size_t len);
+size_t strlen_rvv(const char *str);
+int strcmp_rvv(const char *str1, const char *str2);
+#endif
+
+/* Implementations of the string functions that depend on the hardware. */
+struct string_ops {
+    void *(*memcpy)(void *restrict dst, const void *restrict src, size_t len);
+    void *(*memset)(void *dst, int v, size_t len);
+    int (*memcmp)(const void *src1, const void *src2, size_t len);
+    void *(*memchr)(const void *src, int c, size_t len);
+    size_t (*strlen)(const char *str);
+    int (*strcmp)(const char *str1, const char *str2);
+};
+
+/**
+ * @brief      Chooses the best implementation of each string function for the
+ *             given hardware capabilities.
+ *
+ * @param[in]  hwcap  The hardware capabilities, as HWCAP_* flags.
+ */
+void string_init(unsigned long hwcap);
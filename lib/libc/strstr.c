@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/param.h>
+
+#include "string_impl.h"
+
+/* Needles up to this length are found by filtering candidate positions on
+ * their first and last bytes. Longer ones use the Two-Way algorithm, whose
+ * setup cost only pays off when naive comparisons could get expensive. */
+#define SHORT_NEEDLE 16
+
+/**
+ * @brief      Tells whether a needle occurs at a position of the haystack,
+ *             given that its first and last bytes already match.
+ *
+ * @param[in]  h     The position in the haystack.
+ * @param[in]  n     The needle.
+ * @param[in]  len   The length of the needle, at least 2.
+ *
+ * @return     1 if the needle occurs, or 0 otherwise.
+ */
+static int match_inner(
+    const unsigned char *h, const unsigned char *n, size_t len)
+{
+    for (size_t i = 1; i < len - 1; i++) {
+        if (h[i] != n[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief      Finds a short needle by looking for positions where both its
+ *             first and its last byte match, eight positions at a time.
+ *
+ * @param[in]  h     The haystack.
+ * @param[in]  end   The end of the haystack.
+ * @param[in]  n     The needle.
+ * @param[in]  len   The length of the needle, from 2 to @ref SHORT_NEEDLE.
+ *
+ * @return     The first occurrence of the needle, or NULL.
+ */
+static const unsigned char *find_short(const unsigned char *h,
+    const unsigned char *end, const unsigned char *n, size_t len)
+{
+    unsigned char first = n[0], last = n[len - 1];
+    /* Last position at which the needle fits in the haystack. */
+    const unsigned char *stop = end - len;
+
+#ifdef STRING_WORD
+    uint64_t rep_first = word_repeat(first), rep_last = word_repeat(last);
+    size_t off = (len - 1) % WORD_SIZE;
+    unsigned shr = off * 8U, shl = 64U - shr;
+
+    while (h <= stop && (uintptr_t)h % WORD_SIZE != 0) {
+        if (h[0] == first && h[len - 1] == last && match_inner(h, n, len)) {
+            return h;
+        }
+        h++;
+    }
+    /* Test the eight positions of an aligned word at once. The bytes that
+     * end the needle at those positions are merged from the two aligned
+     * words they straddle. All words read hold at least one byte of the
+     * haystack, so no read crosses into a page it does not touch. */
+    for (; h <= stop && (size_t)(stop - h) >= WORD_SIZE - 1; h += WORD_SIZE) {
+        const string_word *lw = (const string_word *)(h + len - 1 - off);
+        uint64_t lasts = lw[0];
+        uint64_t mask;
+        if (off != 0) {
+            lasts = (lasts >> shr) | (lw[1] << shl);
+        }
+        /* word_zero() may flag spurious bytes, but never misses one, which
+         * is fine for a filter. */
+        mask = word_zero(*(const string_word *)h ^ rep_first)
+            & word_zero(lasts ^ rep_last);
+        for (; mask != 0; mask &= mask - 1) {
+            const unsigned char *p = h + word_index(mask);
+            if (p[0] == first && p[len - 1] == last
+                && match_inner(p, n, len)) {
+                return p;
+            }
+        }
+    }
+#endif
+    for (; h <= stop; h++) {
+        if (h[0] == first && h[len - 1] == last && match_inner(h, n, len)) {
+            return h;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief      Computes the maximal suffix of a needle for one of the two
+ *             orderings of the alphabet.
+ *
+ * @param[in]  n       The needle.
+ * @param[in]  len     The length of the needle.
+ * @param[in]  rev     Whether to reverse the ordering.
+ * @param[out] period  Where to store the period of the suffix.
+ *
+ * @return     The position before the start of the suffix, which is SIZE_MAX if
+ *             the suffix is the whole needle.
+ */
+static size_t max_suffix(
+    const unsigned char *n, size_t len, int rev, size_t *period)
+{
+    size_t ip = SIZE_MAX, jp = 0, k = 1, p = 1;
+
+    while (jp + k < len) {
+        unsigned char a = n[ip + k], b = n[jp + k];
+        if (a == b) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            } else {
+                k++;
+            }
+        } else if (rev ? a < b : a > b) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        } else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    *period = p;
+    return ip;
+}
+
+/**
+ * @brief      Finds a needle with the Two-Way algorithm, which runs in linear
+ *             time and constant space. Bytes that do not occur in the needle
+ *             let the window skip ahead, as in Boyer-Moore.
+ *
+ * @param[in]  h     The haystack.
+ * @param[in]  end   The end of the haystack.
+ * @param[in]  n     The needle.
+ * @param[in]  len   The length of the needle.
+ *
+ * @return     The first occurrence of the needle, or NULL.
+ */
+static const unsigned char *find_twoway(const unsigned char *h,
+    const unsigned char *end, const unsigned char *n, size_t len)
+{
+    uint64_t byteset[4] = { 0 };
+    size_t shift[256];
+    size_t ms, ms2, p, p2, mem, mem0;
+
+    for (size_t i = 0; i < len; i++) {
+        byteset[n[i] / 64U] |= 1ULL << (n[i] % 64U);
+        shift[n[i]] = i + 1;
+    }
+
+    /* The critical factorization splits the needle at the later of its two
+     * maximal suffixes. */
+    ms = max_suffix(n, len, 0, &p);
+    ms2 = max_suffix(n, len, 1, &p2);
+    if (ms2 + 1 > ms + 1) {
+        ms = ms2;
+        p = p2;
+    }
+    if (memcmp(n, n + p, ms + 1) != 0) {
+        /* Not periodic, so nothing can be remembered between windows. */
+        mem0 = 0;
+        p = MAX(ms, len - ms - 1) + 1;
+    } else {
+        /* After a full shift by the period, the start of the needle is
+         * already known to match. */
+        mem0 = len - p;
+    }
+
+    for (mem = 0; (size_t)(end - h) >= len;) {
+        unsigned char c = h[len - 1];
+        size_t k;
+
+        if (!(byteset[c / 64U] & (1ULL << (c % 64U)))) {
+            h += len;
+            mem = 0;
+            continue;
+        }
+        k = len - shift[c];
+        if (k != 0) {
+            h += MAX(k, mem);
+            mem = 0;
+            continue;
+        }
+        /* Compare the right half, then the left one. */
+        for (k = MAX(ms + 1, mem); k < len && n[k] == h[k]; k++) { }
+        if (k < len) {
+            h += k - ms;
+            mem = 0;
+            continue;
+        }
+        for (k = ms + 1; k > mem && n[k - 1] == h[k - 1]; k--) { }
+        if (k <= mem) {
+            return h;
+        }
+        h += p;
+        mem = mem0;
+    }
+    return NULL;
+}
+
+void *memmem(const void *haystack, size_t hlen, const void *needle, size_t nlen)
+{
+    const unsigned char *h = haystack, *n = needle;
+
+    if (nlen == 0) {
+        return (void *)h;
+    }
+    if (hlen < nlen) {
+        return NULL;
+    }
+    if (nlen == 1) {
+        return memchr(h, n[0], hlen);
+    }
+    if (nlen <= SHORT_NEEDLE) {
+        return (void *)find_short(h, h + hlen, n, nlen);
+    }
+    return (void *)find_twoway(h, h + hlen, n, nlen);
+}
+
+char *strstr(const char *haystack, const char *needle)
+{
+    size_t nlen = strlen(needle);
+
+    if (nlen == 0) {
+        return (char *)haystack;
+    }
+    if (nlen == 1) {
+        return strchr(haystack, needle[0]);
+    }
+    if (nlen <= SHORT_NEEDLE) {
+        /* Candidates are found by strchr(), which avoids measuring the
+         * haystack. The comparison stops at its terminator, since the
+         * needle has none. */
+        for (const char *h = strchr(haystack, needle[0]); h != NULL;
+             h = strchr(h + 1, needle[0])) {
+            size_t i = 1;
+            while (i < nlen && h[i] == needle[i]) {
+                i++;
+            }
+            if (i == nlen) {
+                return (char *)h;
+            }
+            if (h[i] == '\0') {
+                break;
+            }
+        }
+        return NULL;
+    }
+    return memmem(haystack, strlen(haystack), needle, nlen);
+}
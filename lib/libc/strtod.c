@@ -0,0 +1,817 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/bitops.h>
+
+#include "strtod.h"
+#include "strtod_table.h"
+#include "strtoint.h"
+#include "umul128.h"
+
+/* Number of decimal digits that always fit in a uint64_t. */
+#define FAST_DIGITS_MAX 19
+/* Number of significant digits kept by the slow path. Any digit after these
+ * can only break a tie between two floating-point values. */
+#define DEC_DIGITS_MAX 768
+/* Number of digits that a single shift may add in front of a decimal. */
+#define DEC_SLACK 19
+/* Largest shift applied to a decimal at once, so that it fits in 64 bits. */
+#define DEC_SHIFT_MAX 60
+/* Decimal points beyond this are either zero or infinity in any format. */
+#define DEC_POINT_RANGE 2047
+/* Exponents are clamped to this so that they cannot overflow. */
+#define EXP_CLAMP 1000000000
+
+/* Description of a binary floating-point format. */
+struct binary_fmt {
+    /* Number of explicit mantissa bits. */
+    int mantissa_bits;
+    /* Number of exponent bits. */
+    int exponent_bits;
+    /* Exponent of the smallest normal value, minus one. */
+    int min_exponent;
+    /* Decimal exponents for which round-to-nearest-even must be handled
+     * explicitly by the fast path. */
+    int min_round_even;
+    int max_round_even;
+    /* Decimal exponents beyond which any 19-digit mantissa is either zero or
+     * infinity. */
+    int min_pow10;
+    int max_pow10;
+};
+
+static const struct binary_fmt binary64 = {
+    .mantissa_bits = 52,
+    .exponent_bits = 11,
+    .min_exponent = -1023,
+    .min_round_even = -4,
+    .max_round_even = 23,
+    .min_pow10 = -342,
+    .max_pow10 = 308,
+};
+
+static const struct binary_fmt binary32 = {
+    .mantissa_bits = 23,
+    .exponent_bits = 8,
+    .min_exponent = -127,
+    .min_round_even = -17,
+    .max_round_even = 10,
+    .min_pow10 = -64,
+    .max_pow10 = 38,
+};
+
+/* A value of a binary format, as its explicit mantissa bits and its biased
+ * exponent. A negative exponent means the value could not be computed. */
+struct binary_val {
+    uint64_t mantissa;
+    int32_t power2;
+};
+
+/* A decimal floating-point number: 0.digits * 10^point. */
+struct bigdec {
+    int ndigits;
+    int32_t point;
+    /* Whether non-zero digits were dropped after the last one. */
+    int truncated;
+    uint8_t digits[DEC_DIGITS_MAX + DEC_SLACK];
+};
+
+/* Result of scanning a decimal floating-point string. */
+struct dec_scan {
+    /* First FAST_DIGITS_MAX significant digits, and the power of ten they
+     * are scaled by. */
+    uint64_t w;
+    int32_t q;
+    /* Whether non-zero digits were dropped from w. */
+    int truncated;
+    /* Start and end of the digits, and the value of the exponent part. */
+    const char *digits;
+    const char *end;
+    int64_t exp;
+};
+
+static inline int infinite_power(const struct binary_fmt *fmt)
+{
+    return (1 << fmt->exponent_bits) - 1;
+}
+
+static inline int32_t clamp_exp(int64_t exp)
+{
+    return exp < -EXP_CLAMP ? -EXP_CLAMP : exp > EXP_CLAMP ? EXP_CLAMP : exp;
+}
+
+static inline int clz64(uint64_t val) { return 64 - (int)fls64(val); }
+
+/**
+ * @brief      Computes w * 10^q with the Eisel-Lemire algorithm.
+ *
+ * @param[in]  fmt   Binary format of the result.
+ * @param[in]  q     Decimal exponent.
+ * @param[in]  w     Decimal mantissa.
+ *
+ * @return     The value, or a negative power2 if it could not be determined
+ *             without a slower algorithm.
+ */
+static struct binary_val eisel_lemire(
+    const struct binary_fmt *fmt, int32_t q, uint64_t w)
+{
+    struct binary_val val = { 0, 0 };
+    uint64_t hi, lo, hi2;
+    uint64_t mask = UINT64_MAX >> (fmt->mantissa_bits + 3);
+    const uint64_t *pow5;
+    int lz, upperbit, shift;
+
+    if (w == 0 || q < fmt->min_pow10) {
+        return val;
+    }
+    if (q > fmt->max_pow10) {
+        val.power2 = infinite_power(fmt);
+        return val;
+    }
+
+    /* Multiply the normalized mantissa by the 128-bit approximation of 5^q.
+     * The low half of the table entry only matters when the high half of
+     * the product is too close to a rounding boundary. */
+    lz = clz64(w);
+    w <<= lz;
+    pow5 = pow5_128[q - POW5_128_MIN];
+    lo = umul128(w, pow5[1], &hi);
+    if ((hi & mask) == mask) {
+        umul128(w, pow5[0], &hi2);
+        lo += hi2;
+        if (hi2 > lo) {
+            hi++;
+        }
+        if (lo == UINT64_MAX && (q < -27 || q > 55)) {
+            /* The product is only exact for these exponents. */
+            val.power2 = -1;
+            return val;
+        }
+    }
+
+    upperbit = (int)(hi >> 63);
+    shift = upperbit + 64 - fmt->mantissa_bits - 3;
+    val.mantissa = hi >> shift;
+    /* floor(log2(10^q)) + 63, computed as in the Eisel-Lemire paper. */
+    val.power2 = ((((152170 + 65536) * q) >> 16) + 63) + upperbit - lz
+        - fmt->min_exponent;
+
+    if (val.power2 <= 0) {
+        /* Subnormal value. */
+        if (-val.power2 + 1 >= 64) {
+            val.mantissa = 0;
+            val.power2 = 0;
+            return val;
+        }
+        val.mantissa >>= -val.power2 + 1;
+        val.mantissa += val.mantissa & 1;
+        val.mantissa >>= 1;
+        val.power2 = val.mantissa < (1ULL << fmt->mantissa_bits) ? 0 : 1;
+        return val;
+    }
+
+    if (lo <= 1 && q >= fmt->min_round_even && q <= fmt->max_round_even
+        && (val.mantissa & 3) == 1 && (val.mantissa << shift) == hi) {
+        /* Exactly halfway between two values: round to even. */
+        val.mantissa &= ~1ULL;
+    }
+    val.mantissa += val.mantissa & 1;
+    val.mantissa >>= 1;
+    if (val.mantissa >= (2ULL << fmt->mantissa_bits)) {
+        val.mantissa = 1ULL << fmt->mantissa_bits;
+        val.power2++;
+    }
+    val.mantissa &= ~(1ULL << fmt->mantissa_bits);
+    if (val.power2 >= infinite_power(fmt)) {
+        val.mantissa = 0;
+        val.power2 = infinite_power(fmt);
+    }
+    return val;
+}
+
+static void dec_trim(struct bigdec *d)
+{
+    while (d->ndigits > 0 && d->digits[d->ndigits - 1] == 0) {
+        d->ndigits--;
+    }
+}
+
+/**
+ * @brief      Divides a decimal by 2^shift.
+ *
+ * @param      d      Decimal.
+ * @param[in]  shift  Shift amount, up to DEC_SHIFT_MAX.
+ */
+static void dec_shr(struct bigdec *d, unsigned shift)
+{
+    uint64_t mask = (1ULL << shift) - 1;
+    uint64_t n = 0;
+    int r = 0, w = 0;
+
+    /* Read enough digits for the first digit of the quotient. */
+    while ((n >> shift) == 0) {
+        if (r < d->ndigits) {
+            n = 10 * n + d->digits[r++];
+        } else if (n == 0) {
+            return;
+        } else {
+            while ((n >> shift) == 0) {
+                n = 10 * n;
+                r++;
+            }
+        }
+    }
+    d->point -= r - 1;
+    if (d->point < -DEC_POINT_RANGE) {
+        d->ndigits = 0;
+        d->point = 0;
+        d->truncated = 0;
+        return;
+    }
+
+    while (r < d->ndigits) {
+        uint8_t digit = (uint8_t)(n >> shift);
+
+        n = 10 * (n & mask) + d->digits[r++];
+        d->digits[w++] = digit;
+    }
+    while (n > 0) {
+        uint8_t digit = (uint8_t)(n >> shift);
+
+        n = 10 * (n & mask);
+        if (w < DEC_DIGITS_MAX) {
+            d->digits[w++] = digit;
+        } else if (digit > 0) {
+            d->truncated = 1;
+        }
+    }
+    d->ndigits = w;
+    dec_trim(d);
+}
+
+/**
+ * @brief      Multiplies a decimal by 2^shift.
+ *
+ * @param      d      Decimal.
+ * @param[in]  shift  Shift amount, up to DEC_SHIFT_MAX.
+ */
+static void dec_shl(struct bigdec *d, unsigned shift)
+{
+    uint64_t n = 0;
+    int r = d->ndigits, w = d->ndigits + DEC_SLACK, len;
+
+    if (d->ndigits == 0) {
+        return;
+    }
+
+    /* Work from the least significant digit, writing the product DEC_SLACK
+     * digits to the right so that it never overwrites unread digits. */
+    while (r > 0) {
+        n += (uint64_t)d->digits[--r] << shift;
+        d->digits[--w] = (uint8_t)(n % 10);
+        n /= 10;
+    }
+    while (n > 0) {
+        d->digits[--w] = (uint8_t)(n % 10);
+        n /= 10;
+    }
+
+    len = d->ndigits + DEC_SLACK - w;
+    d->point += len - d->ndigits;
+    if (len > DEC_DIGITS_MAX) {
+        for (int i = w + DEC_DIGITS_MAX; i < w + len; i++) {
+            d->truncated |= d->digits[i] != 0;
+        }
+        len = DEC_DIGITS_MAX;
+    }
+    for (int i = 0; i < len; i++) {
+        d->digits[i] = d->digits[w + i];
+    }
+    d->ndigits = len;
+    dec_trim(d);
+}
+
+/**
+ * @brief      Rounds a decimal to the nearest integer, ties to even.
+ *
+ * @param[in]  d     Decimal, which must be below 2^64.
+ *
+ * @return     The integer.
+ */
+static uint64_t dec_round(const struct bigdec *d)
+{
+    uint64_t n = 0;
+    int up;
+
+    if (d->ndigits == 0 || d->point < 0) {
+        return 0;
+    }
+    for (int i = 0; i < d->point; i++) {
+        n = 10 * n + (i < d->ndigits ? d->digits[i] : 0);
+    }
+    if (d->point >= d->ndigits) {
+        return n;
+    }
+    up = d->digits[d->point] >= 5;
+    if (d->digits[d->point] == 5 && d->point + 1 == d->ndigits) {
+        up = d->truncated || (d->point > 0 && (d->digits[d->point - 1] & 1));
+    }
+    return n + up;
+}
+
+/**
+ * @brief      Converts a decimal into a binary format by scaling it by powers
+ *             of two until it can be rounded to an integer mantissa.
+ *
+ * @param[in]  fmt   Binary format of the result.
+ * @param      d     Decimal, which is destroyed.
+ *
+ * @return     The value.
+ */
+static struct binary_val dec_to_binary(
+    const struct binary_fmt *fmt, struct bigdec *d)
+{
+    /* Shift that brings a decimal with the given point below 1. */
+    static const uint8_t shifts[]
+        = { 0, 3, 6, 9, 13, 16, 19, 23, 26, 29, 33, 36, 39, 43, 46, 49, 53,
+              56, 59 };
+    const int nshifts = sizeof(shifts) / sizeof(*shifts);
+    struct binary_val inf = { 0, infinite_power(fmt) };
+    struct binary_val val = { 0, 0 };
+    int32_t exp2 = 0;
+    unsigned shift;
+
+    if (d->ndigits == 0 || d->point < -324) {
+        return val;
+    }
+    if (d->point >= 310) {
+        return inf;
+    }
+
+    /* Bring the value into [1/2, 1). */
+    while (d->point > 0) {
+        shift = d->point < nshifts ? shifts[d->point] : DEC_SHIFT_MAX;
+        dec_shr(d, shift);
+        if (d->ndigits == 0) {
+            return val;
+        }
+        exp2 += shift;
+    }
+    while (d->point <= 0) {
+        if (d->point == 0) {
+            if (d->digits[0] >= 5) {
+                break;
+            }
+            shift = d->digits[0] < 2 ? 2 : 1;
+        } else {
+            shift = -d->point < nshifts ? shifts[-d->point] : DEC_SHIFT_MAX;
+        }
+        dec_shl(d, shift);
+        if (d->point > DEC_POINT_RANGE) {
+            return inf;
+        }
+        exp2 -= shift;
+    }
+
+    /* The binary format uses [1, 2) instead, and subnormal values have a
+     * fixed exponent. */
+    exp2--;
+    while (fmt->min_exponent + 1 > exp2) {
+        shift = (unsigned)(fmt->min_exponent + 1 - exp2);
+        if (shift > DEC_SHIFT_MAX) {
+            shift = DEC_SHIFT_MAX;
+        }
+        dec_shr(d, shift);
+        exp2 += shift;
+    }
+    if (exp2 - fmt->min_exponent >= infinite_power(fmt)) {
+        return inf;
+    }
+
+    dec_shl(d, fmt->mantissa_bits + 1);
+    val.mantissa = dec_round(d);
+    if (val.mantissa >= (2ULL << fmt->mantissa_bits)) {
+        /* Rounding carried into a new bit. */
+        dec_shr(d, 1);
+        exp2++;
+        val.mantissa = dec_round(d);
+        if (exp2 - fmt->min_exponent >= infinite_power(fmt)) {
+            return inf;
+        }
+    }
+    val.power2 = exp2 - fmt->min_exponent;
+    if (val.mantissa < (1ULL << fmt->mantissa_bits)) {
+        val.power2--;
+    }
+    val.mantissa &= (1ULL << fmt->mantissa_bits) - 1;
+    return val;
+}
+
+/**
+ * @brief      Parses the optional exponent part of a floating-point string.
+ *
+ * @param      p     Pointer to the exponent character, updated past the
+ *                   exponent if there is one.
+ * @param[in]  end   End of the string, or NULL.
+ * @param[in]  c     Exponent character, in lower case.
+ *
+ * @return     The exponent, clamped to +/-EXP_CLAMP, or 0 if there is none.
+ */
+static int64_t scan_exp(const char **p, const char *end, char c)
+{
+    const char *s = *p;
+    int64_t exp = 0;
+    int sign = +1;
+
+    if (tolower(strto_peek(s, end)) != c) {
+        return 0;
+    }
+    s++;
+    if (strto_peek(s, end) == '-') {
+        sign = -1;
+        s++;
+    } else if (strto_peek(s, end) == '+') {
+        s++;
+    }
+    if (!isdigit(strto_peek(s, end))) {
+        /* Not an exponent, so the mantissa ends before it. */
+        return 0;
+    }
+    for (; isdigit(strto_peek(s, end)); s++) {
+        if (exp < EXP_CLAMP) {
+            exp = 10 * exp + (*s - '0');
+        }
+    }
+    *p = s;
+    return sign * exp;
+}
+
+/**
+ * @brief      Scans a decimal floating-point string.
+ *
+ * @param[in]  p     Start of the digits.
+ * @param[in]  end   End of the string, or NULL.
+ * @param[out] scan  Where to store the result.
+ *
+ * @return     A pointer past the string, or NULL if it has no digits.
+ */
+static const char *scan_decimal(
+    const char *p, const char *end, struct dec_scan *scan)
+{
+    uint64_t w = 0;
+    int64_t q = 0;
+    int n = 0, any = 0, frac = 0;
+
+    scan->digits = p;
+    scan->end = end;
+    scan->truncated = 0;
+    for (;; p++) {
+        char c = strto_peek(p, end);
+        unsigned digit = strto_digits[(unsigned char)c];
+
+        if (c == '.' && !frac) {
+            frac = 1;
+            continue;
+        }
+        if (digit >= 10) {
+            break;
+        }
+        any = 1;
+        if (n == 0 && digit == 0) {
+            /* Leading zeros are not significant. */
+            q -= frac;
+        } else if (n < FAST_DIGITS_MAX) {
+            w = 10 * w + digit;
+            n++;
+            q -= frac;
+        } else {
+            scan->truncated |= digit != 0;
+            q += !frac;
+        }
+    }
+    if (!any) {
+        return NULL;
+    }
+
+    scan->exp = scan_exp(&p, end, 'e');
+    scan->w = w;
+    scan->q = clamp_exp(q + scan->exp);
+    return p;
+}
+
+/**
+ * @brief      Reads all the significant digits of a decimal string.
+ *
+ * @param[in]  scan  Result of scan_decimal().
+ * @param[out] d     Where to store the decimal.
+ */
+static void read_decimal(const struct dec_scan *scan, struct bigdec *d)
+{
+    const char *p = scan->digits;
+    int64_t point = 0;
+    int frac = 0;
+
+    d->ndigits = 0;
+    d->truncated = 0;
+    for (;; p++) {
+        char c = strto_peek(p, scan->end);
+        unsigned digit = strto_digits[(unsigned char)c];
+
+        if (c == '.' && !frac) {
+            frac = 1;
+            continue;
+        }
+        if (digit >= 10) {
+            break;
+        }
+        if (d->ndigits == 0 && digit == 0) {
+            point -= frac;
+            continue;
+        }
+        if (d->ndigits < DEC_DIGITS_MAX) {
+            d->digits[d->ndigits++] = (uint8_t)digit;
+        } else {
+            d->truncated |= digit != 0;
+        }
+        point += !frac;
+    }
+    d->point = clamp_exp(point + scan->exp);
+    dec_trim(d);
+}
+
+/**
+ * @brief      Parses a decimal floating-point string, trying the Eisel-Lemire
+ *             algorithm on its first digits before falling back to all of them.
+ *
+ * @param[in]  fmt      Binary format of the result.
+ * @param[in]  p        Start of the digits.
+ * @param[in]  end      End of the string, or NULL.
+ * @param[out] val      Where to store the value.
+ * @param[out] nonzero  Set to whether any digit is not zero.
+ *
+ * @return     A pointer past the string, or NULL if it has no digits.
+ */
+static const char *parse_decimal(const struct binary_fmt *fmt, const char *p,
+    const char *end, struct binary_val *val, int *nonzero)
+{
+    struct dec_scan scan;
+    struct bigdec d;
+
+    p = scan_decimal(p, end, &scan);
+    if (p == NULL) {
+        return NULL;
+    }
+    *nonzero = scan.w != 0;
+    *val = eisel_lemire(fmt, scan.q, scan.w);
+    if (scan.truncated && val->power2 >= 0) {
+        /* The digits lie between w and w + 1, which must round to the same
+         * value for it to be the right one. */
+        struct binary_val next = eisel_lemire(fmt, scan.q, scan.w + 1);
+
+        if (next.mantissa != val->mantissa || next.power2 != val->power2) {
+            val->power2 = -1;
+        }
+    }
+    if (val->power2 < 0) {
+        read_decimal(&scan, &d);
+        *val = dec_to_binary(fmt, &d);
+    }
+    return p;
+}
+
+/**
+ * @brief      Scans a hexadecimal floating-point string and rounds it.
+ *
+ * @param[in]  fmt      Binary format of the result.
+ * @param[in]  p        Start of the digits, after the "0x" prefix.
+ * @param[in]  end      End of the string, or NULL.
+ * @param[out] val      Where to store the value.
+ * @param[out] nonzero  Set to whether any digit is not zero.
+ *
+ * @return     A pointer past the string, or NULL if it has no digits.
+ */
+static const char *scan_hex(const struct binary_fmt *fmt, const char *p,
+    const char *end, struct binary_val *val, int *nonzero)
+{
+    uint64_t m = 0, rem, half, q;
+    int64_t exp2 = 0, biased;
+    int any = 0, frac = 0, sticky = 0, keep, shift, lz;
+
+    for (;; p++) {
+        char c = strto_peek(p, end);
+        unsigned digit = strto_digits[(unsigned char)c];
+
+        if (c == '.' && !frac) {
+            frac = 1;
+            continue;
+        }
+        if (digit >= 16) {
+            break;
+        }
+        any = 1;
+        if ((m >> 60) == 0) {
+            m = (m << 4) | digit;
+            exp2 -= frac ? 4 : 0;
+        } else {
+            sticky |= digit != 0;
+            exp2 += frac ? 0 : 4;
+        }
+    }
+    if (!any) {
+        return NULL;
+    }
+    exp2 = clamp_exp(exp2 + scan_exp(&p, end, 'p'));
+
+    val->mantissa = 0;
+    val->power2 = 0;
+    *nonzero = m != 0;
+    if (m == 0) {
+        return p;
+    }
+
+    /* The value is m / 2^63 * 2^(exp2 + 63) once m is normalized. Keep as
+     * many bits as the format allows at that exponent and round the rest to
+     * nearest, ties to even. */
+    lz = clz64(m);
+    m <<= lz;
+    biased = exp2 - lz + 63 - fmt->min_exponent;
+    if (biased >= infinite_power(fmt)) {
+        val->power2 = infinite_power(fmt);
+        return p;
+    }
+    keep = fmt->mantissa_bits + (biased < 1 ? (int)biased : 1);
+    shift = 64 - keep;
+    if (shift > 64) {
+        return p;
+    } else if (shift == 64) {
+        q = 0;
+        rem = m;
+        half = 1ULL << 63;
+    } else {
+        q = m >> shift;
+        rem = m & ((1ULL << shift) - 1);
+        half = 1ULL << (shift - 1);
+    }
+    if (rem > half || (rem == half && (sticky || (q & 1)))) {
+        q++;
+    }
+
+    /* Carries out of the mantissa end up in the exponent. */
+    if (biased > 0) {
+        q += (uint64_t)(biased - 1) << fmt->mantissa_bits;
+    }
+    val->mantissa = q & ((1ULL << fmt->mantissa_bits) - 1);
+    val->power2 = (int32_t)(q >> fmt->mantissa_bits);
+    return p;
+}
+
+/**
+ * @brief      Checks whether a string starts with a word, ignoring case.
+ *
+ * @param[in]  p     String.
+ * @param[in]  end   End of the string, or NULL.
+ * @param[in]  word  Lower case word.
+ *
+ * @return     The length of the word if it matches, or 0 otherwise.
+ */
+static size_t match_word(const char *p, const char *end, const char *word)
+{
+    size_t n = 0;
+
+    for (; word[n] != '\0'; n++) {
+        if (tolower(strto_peek(p + n, end)) != word[n]) {
+            return 0;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief      Converts a string to the bit pattern of a binary floating-point
+ *             value, as specified for strtod().
+ *
+ * @param[in]  fmt     Binary format of the result.
+ * @param[in]  nptr    String.
+ * @param[in]  end     End of the string, or NULL.
+ * @param      endptr  If not NULL, where to store a pointer past the
+ *                     conversion.
+ *
+ * @return     The bit pattern of the value.
+ */
+static uint64_t strtofp(const struct binary_fmt *fmt, const char *nptr,
+    const char *end, char **endptr)
+{
+    struct binary_val val = { 0, 0 };
+    const char *p, *next;
+    int sign, nonzero = 0, finite = 1;
+    size_t n;
+
+    p = strto_prefix(nptr, end, &sign);
+    if ((n = match_word(p, end, "inf")) > 0) {
+        next = p + (match_word(p, end, "infinity") ? 8 : n);
+        val.power2 = infinite_power(fmt);
+        finite = 0;
+    } else if ((n = match_word(p, end, "nan")) > 0) {
+        next = p + n;
+        if (strto_peek(next, end) == '(') {
+            /* Skip the n-char-sequence, which selects no particular NaN. */
+            const char *s = next + 1;
+
+            while (strto_digits[(unsigned char)strto_peek(s, end)] < 36
+                || strto_peek(s, end) == '_') {
+                s++;
+            }
+            if (strto_peek(s, end) == ')') {
+                next = s + 1;
+            }
+        }
+        val.mantissa = 1ULL << (fmt->mantissa_bits - 1);
+        val.power2 = infinite_power(fmt);
+        finite = 0;
+    } else {
+        next = NULL;
+        if (strto_peek(p, end) == '0'
+            && tolower(strto_peek(p + 1, end)) == 'x') {
+            next = scan_hex(fmt, p + 2, end, &val, &nonzero);
+        }
+        if (next == NULL) {
+            /* This also parses the "0" of a "0x" prefix with no digits. */
+            next = parse_decimal(fmt, p, end, &val, &nonzero);
+        }
+        if (next == NULL) {
+            /* No conversion could be performed. */
+            if (endptr != NULL) {
+                *endptr = (char *)nptr;
+            }
+            errno = EINVAL;
+            return 0;
+        }
+    }
+
+    if (endptr != NULL) {
+        *endptr = (char *)next;
+    }
+    if (finite && nonzero && val.mantissa == 0
+        && (val.power2 == 0 || val.power2 == infinite_power(fmt))) {
+        /* The value underflowed to zero or overflowed to infinity. */
+        errno = ERANGE;
+    }
+    return val.mantissa | ((uint64_t)val.power2 << fmt->mantissa_bits)
+        | ((uint64_t)(sign < 0) << (fmt->mantissa_bits + fmt->exponent_bits));
+}
+
+double strtod_range(const char *nptr, const char *end, char **endptr)
+{
+    union {
+        double d;
+        uint64_t u;
+    } bits;
+
+    bits.u = strtofp(&binary64, nptr, end, endptr);
+    return bits.d;
+}
+
+float strtof_range(const char *nptr, const char *end, char **endptr)
+{
+    union {
+        float f;
+        uint32_t u;
+    } bits;
+
+    bits.u = (uint32_t)strtofp(&binary32, nptr, end, endptr);
+    return bits.f;
+}
+
+double strtod(const char *restrict nptr, char **restrict endptr)
+{
+    return strtod_range(nptr, NULL, endptr);
+}
+
+float strtof(const char *restrict nptr, char **restrict endptr)
+{
+    return strtof_range(nptr, NULL, endptr);
+}
+
+double atof(const char *nptr)
+{
+    return strtod(nptr, NULL);
+}
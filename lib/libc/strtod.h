@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/**
+ * @brief      Converts a string to a double value, as specified for strtod(),
+ *             without reading past a given end.
+ *
+ * @param[in]  nptr    The string to be converted.
+ * @param[in]  end     End of the string, or NULL if it ends at its NUL
+ *                     terminator. This bounds a field without copying it.
+ * @param      endptr  If not NULL, where to store a pointer past the
+ *                     conversion.
+ *
+ * @return     The parsed value.
+ */
+double strtod_range(const char *nptr, const char *end, char **endptr);
+
+/**
+ * @brief      Converts a string to a float value, as specified for strtof(),
+ *             without reading past a given end.
+ *
+ * @param[in]  nptr    The string to be converted.
+ * @param[in]  end     End of the string, or NULL.
+ * @param      endptr  If not NULL, where to store a pointer past the
+ *                     conversion.
+ *
+ * @return     The parsed value.
+ */
+float strtof_range(const char *nptr, const char *end, char **endptr);
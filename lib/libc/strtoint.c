@@ -22,26 +22,148 @@
 #include <stdint.h>
 #include <stdlib.h>
 
-struct strtoint_opts {
-    intmax_t min;
-    uintmax_t max;
+#include "strtoint.h"
+
+#define XX STRTO_NODIGIT
+
+const uint8_t strto_digits[256] = {
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, /* 0x00 */
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, /* 0x10 */
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, /* 0x20 */
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, XX, XX, XX, XX, XX, XX, /* 0x30 */
+    XX, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, /* 0x40 */
+    25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, XX, XX, XX, XX, XX, /* 0x50 */
+    XX, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, /* 0x60 */
+    25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, XX, XX, XX, XX, XX, /* 0x70 */
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, /* 0x80 */
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, /* 0x90 */
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, /* 0xa0 */
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, /* 0xb0 */
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, /* 0xc0 */
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, /* 0xd0 */
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, /* 0xe0 */
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, /* 0xf0 */
 };
 
-static int parse_base(char *nptr, int *base)
+#undef XX
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define STRTOINT_SWAR 1
+
+/* Aligned 8-byte loads never cross a page boundary, so they may safely read
+ * past the end of the string. */
+typedef uint64_t __attribute__((__may_alias__)) strtoint_word;
+
+#define ONES 0x0101010101010101ULL
+#define HIGHS 0x8080808080808080ULL
+
+/* Sets the high bit of each byte of x (which must be below 0x80) that lies
+ * strictly between lo and hi. */
+#define BETWEEN(x, lo, hi)                                                   \
+    (((ONES * (127 + (hi)) - (x)) & ~(x) & ((x) + ONES * (127 - (lo))))      \
+        & HIGHS)
+
+/**
+ * @brief      Converts a word of eight decimal digits, most significant first.
+ *
+ * @param[in]  w     Word as loaded from memory.
+ * @param[out] val   Where to store the value of the digits.
+ *
+ * @return     1 if all eight bytes are decimal digits, or 0 otherwise.
+ */
+static int swar_dec8(uint64_t w, uint64_t *val)
+{
+    if ((((w & 0xf0f0f0f0f0f0f0f0ULL)
+             | (((w + 0x0606060606060606ULL) & 0xf0f0f0f0f0f0f0f0ULL) >> 4))
+        != 0x3333333333333333ULL)) {
+        return 0;
+    }
+    w -= 0x3030303030303030ULL;
+    /* Combine adjacent digits into 2, 4 and then 8-digit lanes. */
+    w = (w * 10) + (w >> 8);
+    w = (((w & 0x000000ff000000ffULL) * (100 + (1000000ULL << 32)))
+            + (((w >> 16) & 0x000000ff000000ffULL) * (1 + (10000ULL << 32))))
+        >> 32;
+    *val = w & 0xffffffff;
+    return 1;
+}
+
+/**
+ * @brief      Converts a word of eight hexadecimal digits, most significant
+ *             first.
+ *
+ * @param[in]  w     Word as loaded from memory.
+ * @param[out] val   Where to store the value of the digits.
+ *
+ * @return     1 if all eight bytes are hexadecimal digits, or 0 otherwise.
+ */
+static int swar_hex8(uint64_t w, uint64_t *val)
+{
+    uint64_t digit, alpha;
+
+    if (w & HIGHS) {
+        return 0;
+    }
+    /* Digits are told apart before folding upper case into lower case,
+     * which would turn control bytes 0x10 to 0x19 into digits too. */
+    digit = BETWEEN(w, 0x2f, 0x3a);
+    alpha = BETWEEN(w | 0x2020202020202020ULL, 0x60, 0x67);
+    if ((digit | alpha) != HIGHS) {
+        return 0;
+    }
+    w = (w & 0x0f0f0f0f0f0f0f0fULL) + (alpha >> 7) * 9;
+    /* Combine adjacent nibbles into 8, 16 and then 32-bit lanes. */
+    w = ((w & 0x0f000f000f000f00ULL) >> 8)
+        | ((w & 0x000f000f000f000fULL) << 4);
+    w = ((w & 0x00ff000000ff0000ULL) >> 16)
+        | ((w & 0x000000ff000000ffULL) << 8);
+    *val = ((w & 0x0000ffff00000000ULL) >> 32) | ((w & 0xffff) << 16);
+    return 1;
+}
+
+/**
+ * @brief      Converts a word of eight digits in base 10 or 16.
+ *
+ * @param[in]  p     Pointer to the digits, aligned to 8 bytes.
+ * @param[in]  base  Base of the digits.
+ * @param[out] val   Where to store the value of the digits.
+ *
+ * @return     1 if all eight bytes are digits, or 0 otherwise.
+ */
+static int swar_digits8(const char *p, int base, uint64_t *val)
+{
+    uint64_t w = *(const strtoint_word *)p;
+
+    return base == 10 ? swar_dec8(w, val) : swar_hex8(w, val);
+}
+
+#undef ONES
+#undef HIGHS
+#undef BETWEEN
+#endif
+
+/* Whether a string starts with a "0x" or "0X" prefix followed by a digit. */
+static int has_hex_prefix(const char *nptr, const char *end)
+{
+    return strto_peek(nptr, end) == '0'
+        && (strto_peek(nptr + 1, end) == 'x'
+            || strto_peek(nptr + 1, end) == 'X')
+        && strto_digits[(unsigned char)strto_peek(nptr + 2, end)] < 16;
+}
+
+static int parse_base(const char *nptr, const char *end, int *base)
 {
     int rc = 0;
 
-    if (*nptr == '0') {
-        nptr++, rc++;
-        if (*nptr == 'x' || *nptr == 'X') {
-            /* Hexadecimal base specified by preceding "0x" or "0X".*/
-            nptr++, rc++;
-            *base = 16;
-        } else if (isdigit(*nptr)) {
-            /* Octal base specified by preceding "0". */
-            *base = 8;
-        }
-    } else if (isdigit(*nptr)) {
+    if (has_hex_prefix(nptr, end)) {
+        /* Hexadecimal base specified by preceding "0x" or "0X".*/
+        rc = 2;
+        *base = 16;
+    } else if (strto_peek(nptr, end) == '0') {
+        /* Octal base specified by preceding "0", which is also the only
+         * digit of a plain zero. */
+        *base = 8;
+    } else if (isdigit(strto_peek(nptr, end))) {
         /* Decimal base specified by at least one preceding non-zero decimal
          * digit. */
         *base = 10;
@@ -53,39 +175,30 @@ static int parse_base(char *nptr, int *base)
     return rc;
 }
 
-static intmax_t strtoint(const char *restrict nptr, char **restrict endptr,
-    int base, struct strtoint_opts opts)
+uintmax_t strtoint(const char *nptr, const char *end, char **endptr, int base,
+    struct strtoint_opts opts)
 {
+    const char *start = nptr, *digits;
     int is_signed = (opts.min < 0);
-    int sign = +1;
+    int sign;
 
-    while (isspace(*nptr)) {
-        /* Skip whitespace. */
-        nptr++;
-    }
-
-    if (*nptr == '-') {
-        if (!is_signed) {
-            /* Function does not allow negative values. */
-            if (endptr != NULL) {
-                *endptr = (char *)nptr;
-            }
-            errno = EINVAL;
-            return 0;
+    nptr = strto_prefix(nptr, end, &sign);
+    if (sign == -1 && !is_signed) {
+        /* Function does not allow negative values. */
+        if (endptr != NULL) {
+            *endptr = (char *)nptr - 1;
         }
-        sign = -1;
-        nptr++;
-    } else if (*nptr == '+') {
-        nptr++;
+        errno = EINVAL;
+        return 0;
     }
 
     if (base == 0) {
         /* Try to guess the base. */
-        nptr += parse_base((char *)nptr, &base);
+        nptr += parse_base(nptr, end, &base);
         if (base == 0) {
             /* Could not guess base. */
             if (endptr != NULL) {
-                *endptr = (char *)nptr;
+                *endptr = (char *)start;
             }
             errno = EINVAL;
             return 0;
@@ -94,55 +207,62 @@ static intmax_t strtoint(const char *restrict nptr, char **restrict endptr,
         /* Invalid value for base. */
         errno = EINVAL;
         return 0;
+    } else if (base == 16 && has_hex_prefix(nptr, end)) {
+        /* The prefix is optional for an explicit base 16. */
+        nptr += 2;
     }
 
-    intmax_t val = 0;
-    for (int digit;; nptr++) {
-        if (isdigit(*nptr)) {
-            digit = *nptr - '0';
-        } else if (*nptr >= 'a' && *nptr <= 'z') {
-            digit = *nptr - 'a' + 10;
-        } else if (*nptr >= 'A' && *nptr <= 'z') {
-            digit = *nptr - 'A' + 10;
-        } else {
-            /* Set invalid value for overflowing. */
-            digit = -1;
-        }
+    /* Largest magnitude that can be represented, and the largest value that
+     * can take one more digit without exceeding it. */
+    uintmax_t limit
+        = sign == -1 ? (uintmax_t)-(opts.min + 1) + 1 : (uintmax_t)opts.max;
+    uintmax_t cutoff = limit / (unsigned)base;
+    unsigned cutlim = limit % (unsigned)base;
+    uintmax_t val = 0;
+    unsigned digit;
 
-        if (digit < 0 || digit >= base) {
-            /* Invalid value for the digit -- finished conversion. */
-            if (endptr != NULL) {
-                *endptr = (char *)nptr;
-            }
-            break;
-        }
+    digits = nptr;
+    for (;; nptr++) {
+#ifdef STRTOINT_SWAR
+        if ((base == 10 || base == 16) && ((uintptr_t)nptr & 7) == 0) {
+            uint64_t chunk;
+            uintmax_t scale = base == 10 ? 100000000 : 0x100000000;
 
-        if (sign == +1 && (intmax_t)(base * val + digit) < (intmax_t)val) {
-            errno = ERANGE;
-            if (endptr != NULL) {
-                *endptr = (char *)nptr;
+            /* Consume whole words of digits while they cannot overflow.
+             * Whatever is left is handled one digit at a time. */
+            while ((end == NULL || end - nptr >= 8)
+                && swar_digits8(nptr, base, &chunk) && chunk <= limit
+                && val <= (limit - chunk) / scale) {
+                val = val * scale + chunk;
+                nptr += 8;
             }
-            return (intmax_t)opts.max;
         }
-        if (sign == -1 && (intmax_t)(base * val + digit) < (intmax_t)val) {
+#endif
+        digit = strto_digits[(unsigned char)strto_peek(nptr, end)];
+        if (digit >= (unsigned)base) {
+            /* Invalid value for the digit -- finished conversion. */
+            break;
+        }
+        if (val > cutoff || (val == cutoff && digit > cutlim)) {
             errno = ERANGE;
             if (endptr != NULL) {
                 *endptr = (char *)nptr;
             }
-            return opts.min;
+            return sign == -1 ? (uintmax_t)opts.min : opts.max;
         }
-        val = base * val + digit;
+        val = val * (unsigned)base + digit;
     }
 
     if (endptr != NULL) {
-        *endptr = (char *)nptr;
+        /* Without any digit, nothing was converted. */
+        *endptr = (char *)(nptr == digits ? start : nptr);
     }
-    return sign * val;
+    return sign == -1 ? 0 - val : val;
 }
 
 long int strtol(const char *restrict nptr, char **restrict endptr, int base)
 {
-    return (long int)strtoint(nptr, endptr, base,
+    return (long int)strtoint(nptr, NULL, endptr, base,
         (struct strtoint_opts) {
             .min = LONG_MIN,
             .max = LONG_MAX,
@@ -152,7 +272,7 @@ long int strtol(const char *restrict nptr, char **restrict endptr, int base)
 long long int strtoll(
     const char *restrict nptr, char **restrict endptr, int base)
 {
-    return (long long int)strtoint(nptr, endptr, base,
+    return (long long int)strtoint(nptr, NULL, endptr, base,
         (struct strtoint_opts) {
             .min = LLONG_MIN,
             .max = LLONG_MAX,
@@ -162,7 +282,7 @@ long long int strtoll(
 unsigned long int strtoul(
     const char *restrict nptr, char **restrict endptr, int base)
 {
-    return strtoint(nptr, endptr, base,
+    return (unsigned long int)strtoint(nptr, NULL, endptr, base,
         (struct strtoint_opts) {
             .min = 0,
             .max = ULONG_MAX,
@@ -172,7 +292,7 @@ unsigned long int strtoul(
 unsigned long long int strtoull(
     const char *restrict nptr, char **restrict endptr, int base)
 {
-    return strtoint(nptr, endptr, base,
+    return (unsigned long long int)strtoint(nptr, NULL, endptr, base,
         (struct strtoint_opts) {
             .min = 0,
             .max = ULLONG_MAX,
@@ -181,7 +301,7 @@ unsigned long long int strtoull(
 
 intmax_t strtoimax(const char *restrict nptr, char **restrict endptr, int base)
 {
-    return strtoint(nptr, endptr, base,
+    return (intmax_t)strtoint(nptr, NULL, endptr, base,
         (struct strtoint_opts) {
             .min = INTMAX_MIN,
             .max = INTMAX_MAX,
@@ -190,7 +310,7 @@ intmax_t strtoimax(const char *restrict nptr, char **restrict endptr, int base)
 
 uintmax_t strtoumax(const char *restrict nptr, char **restrict endptr, int base)
 {
-    return (uintmax_t)strtoint(nptr, endptr, base,
+    return strtoint(nptr, NULL, endptr, base,
         (struct strtoint_opts) {
             .min = 0,
             .max = UINTMAX_MAX,
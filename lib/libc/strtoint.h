@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <ctype.h>
+#include <stdint.h>
+
+/* Value of a character that is not a digit in any base. */
+#define STRTO_NODIGIT 0xff
+
+/* Value of each character as a digit in bases up to 36, or STRTO_NODIGIT. */
+extern const uint8_t strto_digits[256];
+
+/* Bounds of the values accepted by strtoint(). */
+struct strtoint_opts {
+    intmax_t min;
+    uintmax_t max;
+};
+
+/**
+ * @brief      Reads a character of a string that may end before its NUL
+ *             terminator.
+ *
+ * @param[in]  p    Pointer to the character.
+ * @param[in]  end  End of the string, or NULL if it ends at its NUL
+ *                  terminator.
+ *
+ * @return     The character, or '\0' if @p p is at @p end.
+ */
+static inline char strto_peek(const char *p, const char *end)
+{
+    return p == end ? '\0' : *p;
+}
+
+/**
+ * @brief      Skips the leading whitespace and optional sign of a numeric
+ *             string, as accepted by the strto*() family.
+ *
+ * @param[in]  nptr  The string to be scanned.
+ * @param[in]  end   End of the string, or NULL.
+ * @param[out] sign  Set to -1 if a minus sign was found, or +1 otherwise.
+ *
+ * @return     A pointer to the first character after the sign.
+ */
+static inline const char *strto_prefix(
+    const char *nptr, const char *end, int *sign)
+{
+    while (isspace(strto_peek(nptr, end))) {
+        nptr++;
+    }
+    *sign = +1;
+    if (strto_peek(nptr, end) == '-') {
+        *sign = -1;
+        nptr++;
+    } else if (strto_peek(nptr, end) == '+') {
+        nptr++;
+    }
+    return nptr;
+}
+
+/**
+ * @brief      Converts a string to an integer, as specified for strtoimax()
+ *             and strtoumax() but with arbitrary bounds.
+ *
+ * @param[in]  nptr    The string to be converted.
+ * @param[in]  end     End of the string, or NULL if it ends at its NUL
+ *                     terminator. This bounds a field without copying it.
+ * @param      endptr  If not NULL, where to store a pointer past the last
+ *                     digit.
+ * @param[in]  base    The base, or 0 to guess it from the prefix.
+ * @param[in]  opts    Bounds of the value. Negative values are rejected with
+ *                     EINVAL if the lower bound is not negative.
+ *
+ * @return     The value, converted to uintmax_t.
+ */
+uintmax_t strtoint(const char *nptr, const char *end, char **endptr, int base,
+    struct strtoint_opts opts);
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief      Multiplies two 64-bit values into a 128-bit product.
+ *
+ * @param[in]  a     The first factor.
+ * @param[in]  b     The second factor.
+ * @param[out] hi    The most significant 64 bits of the product.
+ *
+ * @return     The least significant 64 bits of the product.
+ */
+static inline uint64_t umul128(uint64_t a, uint64_t b, uint64_t *hi)
+{
+#if defined(__riscv) && __riscv_xlen == 64
+    uint64_t h;
+    __asm__("mulhu %0, %1, %2" : "=r"(h) : "r"(a), "r"(b));
+    *hi = h;
+    return a * b;
+#else
+    /* Portable version using 32x32->64-bit multiplications. */
+    uint64_t a_lo = (uint32_t)a;
+    uint64_t a_hi = a >> 32U;
+    uint64_t b_lo = (uint32_t)b;
+    uint64_t b_hi = b >> 32U;
+
+    uint64_t b00 = a_lo * b_lo;
+    uint64_t b01 = a_lo * b_hi;
+    uint64_t b10 = a_hi * b_lo;
+    uint64_t b11 = a_hi * b_hi;
+
+    /* None of these can overflow. */
+    uint64_t mid1 = b10 + (b00 >> 32U);
+    uint64_t mid2 = b01 + (uint32_t)mid1;
+
+    *hi = b11 + (mid1 >> 32U) + (mid2 >> 32U);
+    return (mid2 << 32U) | (uint32_t)b00;
+#endif
+}
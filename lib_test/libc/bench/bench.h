@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+
+/* Number of bytes processed by each measurement. */
+#define BENCH_BYTES (256UL << 20U)
+
+/* Sink for results that must not be optimized out. */
+static volatile size_t bench_sink;
+
+/**
+ * @brief      Obtains the value of a monotonic clock.
+ *
+ * @return     The time, in seconds.
+ */
+static inline double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief      Prints the throughput of a measurement.
+ *
+ * @param[in]  name   Name of the measured function.
+ * @param[in]  size   Size of each input, in bytes.
+ * @param[in]  start  Time at which the measurement started, as returned by
+ *                    bench_now().
+ */
+static inline void bench_report(const char *name, size_t size, double start)
+{
+    double secs = bench_now() - start;
+    printf("%-16s %8zu B %10.1f MiB/s\n", name, size,
+        (double)BENCH_BYTES / secs / (1 << 20U));
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+
+#include <stdlib.h>
+
+#include "../../../lib/libc/crc32c.c"
+#include "../../../lib/libc/hash.c"
+
+/* Table-driven CRC one byte at a time, as a baseline. */
+static uint32_t byte_crc32c(uint32_t crc, const unsigned char *buf, size_t len)
+{
+    while (len-- > 0) {
+        crc = (crc >> 8U) ^ crc32c_table[0][(crc ^ *buf++) & 0xffU];
+    }
+    return crc;
+}
+
+static const size_t sizes[] = { 8, 16, 64, 256, 4096, 65536 };
+
+int main(int argc, char **argv)
+{
+    size_t max = sizes[sizeof(sizes) / sizeof(*sizes) - 1];
+    unsigned char *buf = malloc(max);
+    char name[32];
+
+    for (size_t i = 0; i < max; i++) {
+        buf[i] = (unsigned char)(i * 167);
+    }
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+        size_t size = sizes[i];
+        size_t iters = BENCH_BYTES / size;
+        double start;
+
+        start = bench_now();
+        for (size_t k = 0; k < iters; k++) {
+            bench_sink += byte_crc32c((uint32_t)k, buf, size);
+        }
+        bench_report("crc32c/byte", size, start);
+
+        start = bench_now();
+        for (size_t k = 0; k < iters; k++) {
+            bench_sink += crc32c_generic((uint32_t)k, buf, size);
+        }
+        bench_report("crc32c/slice8", size, start);
+
+        start = bench_now();
+        for (size_t k = 0; k < iters; k++) {
+            bench_sink += hash64(buf, size, k);
+        }
+        bench_report("hash64", size, start);
+    }
+    free(buf);
+    return 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "bench.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define malloc uut_malloc
+#define calloc uut_calloc
+#define aligned_alloc uut_aligned_alloc
+#define realloc uut_realloc
+#define free uut_free
+#include "../../../lib/libc/malloc.c"
+#undef malloc
+#undef calloc
+#undef aligned_alloc
+#undef realloc
+#undef free
+
+/* Number of allocations made by each measurement, and of those live at once
+ * in the random ones. Allocations too large for a size class take a few
+ * system calls each, so fewer of them are made. */
+#define BENCH_OPS (8UL << 20U)
+#define BENCH_LARGE_OPS (BENCH_OPS >> 8U)
+#define BENCH_LIVE 4096U
+#define BENCH_THREADS 4U
+/* Number of allocations made, and fraction of them kept, to measure
+ * fragmentation. */
+#define FRAG_OBJS (256UL << 10U)
+#define FRAG_KEEP 4U
+
+static const struct impl {
+    const char *name;
+    void *(*malloc)(size_t);
+    void (*free)(void *);
+} impls[] = {
+    { "libc", uut_malloc, uut_free },
+    { "host", malloc, free },
+};
+
+static const size_t sizes[] = { 16, 64, 256, 1024, 4096, 16384, 65536 };
+
+/* Pseudo-random sizes, most of them small. */
+static size_t random_size(uint64_t *state)
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (*state >> 60U) == 0 ? 1 + (*state >> 32U) % 8192
+                                : 1 + (*state >> 32U) % 512;
+}
+
+/* Replaces random allocations out of a window of live ones. */
+static void *random_ops(void *arg)
+{
+    const struct impl *impl = arg;
+    void **live = calloc(BENCH_LIVE, sizeof(*live));
+    uint64_t state = (uintptr_t)&state;
+    size_t i;
+
+    for (size_t k = 0; k < BENCH_OPS / BENCH_THREADS; k++) {
+        i = (state >> 33U) % BENCH_LIVE;
+        impl->free(live[i]);
+        live[i] = impl->malloc(random_size(&state));
+        *(char *)live[i] = (char)k;
+    }
+    for (i = 0; i < BENCH_LIVE; i++) {
+        impl->free(live[i]);
+    }
+    free(live);
+    return NULL;
+}
+
+static void report_ops(const char *name, size_t size, size_t ops, double start)
+{
+    double secs = bench_now() - start;
+    printf("%-20s %8zu B %10.2f Mops/s\n", name, size,
+        (double)ops / secs * 1e-6);
+}
+
+/* Obtains the resident set size of the process, in bytes. */
+static size_t rss(void)
+{
+    FILE *f = fopen("/proc/self/statm", "r");
+    size_t size = 0, pages = 0;
+
+    if (f != NULL) {
+        if (fscanf(f, "%zu %zu", &size, &pages) != 2) {
+            pages = 0;
+        }
+        fclose(f);
+    }
+    return pages * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+/* Makes random allocations, frees most of them, and prints how much memory
+ * is resident per byte still in use. It runs in a process of its own so
+ * that neither allocator sees what the other left behind. */
+static void fragmentation(const struct impl *impl)
+{
+    void **objs = calloc(FRAG_OBJS, sizeof(*objs));
+    uint64_t state = 0x25;
+    size_t base = rss(), live = 0, size;
+    pid_t pid = fork();
+
+    if (pid != 0) {
+        waitpid(pid, NULL, 0);
+        free(objs);
+        return;
+    }
+    for (size_t k = 0; k < FRAG_OBJS; k++) {
+        objs[k] = impl->malloc(size = random_size(&state));
+        memset(objs[k], 1, size);
+        if (k % FRAG_KEEP == 0) {
+            live += size;
+        }
+    }
+    printf("%-20s %8.2f MiB live %8.2f MiB resident at peak\n", impl->name,
+        (double)live / (1 << 20U), (double)(rss() - base) / (1 << 20U));
+    for (size_t k = 0; k < FRAG_OBJS; k++) {
+        if (k % FRAG_KEEP != 0) {
+            impl->free(objs[k]);
+        }
+    }
+    printf("%-20s %8.2f bytes resident per live byte\n", impl->name,
+        (double)(rss() - base) / (double)live);
+    fflush(stdout);
+    _exit(0);
+}
+
+int main(int argc, char **argv)
+{
+    pthread_t threads[BENCH_THREADS];
+    char name[32];
+
+    for (size_t m = 0; m < sizeof(impls) / sizeof(*impls); m++) {
+        const struct impl *impl = &impls[m];
+        double start;
+
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+            size_t ops = sizes[i] > SMALL_MAX ? BENCH_LARGE_OPS : BENCH_OPS;
+
+            snprintf(name, sizeof(name), "pair/%s", impl->name);
+            start = bench_now();
+            for (size_t k = 0; k < ops; k++) {
+                void *p = impl->malloc(sizes[i]);
+                *(volatile char *)p = 0;
+                impl->free(p);
+            }
+            report_ops(name, sizes[i], ops, start);
+        }
+
+        snprintf(name, sizeof(name), "random/%s", impl->name);
+        start = bench_now();
+        for (unsigned t = 0; t < BENCH_THREADS; t++) {
+            random_ops((void *)impl);
+        }
+        report_ops(name, 0, BENCH_OPS, start);
+
+        snprintf(name, sizeof(name), "random/%s/%ut", impl->name,
+            BENCH_THREADS);
+        start = bench_now();
+        for (unsigned t = 0; t < BENCH_THREADS; t++) {
+            pthread_create(&threads[t], NULL, random_ops, (void *)impl);
+        }
+        for (unsigned t = 0; t < BENCH_THREADS; t++) {
+            pthread_join(threads[t], NULL);
+        }
+        report_ops(name, 0, BENCH_OPS, start);
+    }
+    fflush(stdout);
+    for (size_t m = 0; m < sizeof(impls) / sizeof(*impls); m++) {
+        fragmentation(&impls[m]);
+    }
+    return 0;
+}
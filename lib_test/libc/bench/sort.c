@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define qsort uut_qsort
+#define bsearch uut_bsearch
+#include "../../../lib/libc/sort.c"
+#undef qsort
+#undef bsearch
+
+/* Number of elements sorted or searched by each measurement. */
+#define BENCH_ELEMS (4UL << 20U)
+
+struct pair {
+    uint64_t key;
+    uint64_t val;
+};
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static const struct impl {
+    const char *name;
+    void (*qsort)(void *, size_t, size_t, int (*)(const void *, const void *));
+    void *(*bsearch)(const void *, const void *, size_t, size_t,
+        int (*)(const void *, const void *));
+} impls[] = {
+    { "libc", uut_qsort, uut_bsearch },
+    { "host", qsort, bsearch },
+};
+
+static const struct type {
+    const char *name;
+    size_t size;
+    int (*cmp)(const void *, const void *);
+} types[] = {
+    { "u32", sizeof(uint32_t), cmp_u32 },
+    { "u64", sizeof(uint64_t), cmp_u64 },
+    { "pair", sizeof(struct pair), cmp_u64 },
+};
+
+static const size_t counts[] = { 8, 100, 10000, 1000000 };
+
+/* Prints the time taken per element by a measurement. */
+static void report(const char *name, size_t n, double start)
+{
+    double secs = bench_now() - start;
+    printf("%-20s %8zu %10.2f ns/elem\n", name, n,
+        secs * 1e9 / (double)BENCH_ELEMS);
+}
+
+int main(int argc, char **argv)
+{
+    size_t max = counts[sizeof(counts) / sizeof(*counts) - 1];
+    unsigned char *src = malloc(max * sizeof(struct pair));
+    unsigned char *dst = malloc(max * sizeof(struct pair));
+    char name[32];
+
+    srand(0x5027);
+    for (size_t i = 0; i < sizeof(types) / sizeof(*types); i++) {
+        const struct type *t = &types[i];
+        for (size_t j = 0; j < sizeof(counts) / sizeof(*counts); j++) {
+            size_t n = counts[j];
+            size_t iters = BENCH_ELEMS / n;
+            for (size_t k = 0; k < n * t->size; k++) {
+                src[k] = (unsigned char)rand();
+            }
+            for (size_t m = 0; m < sizeof(impls) / sizeof(*impls); m++) {
+                const struct impl *impl = &impls[m];
+                double start;
+
+                /* The copy is part of the measurement, for both. */
+                snprintf(name, sizeof(name), "qsort/%s/%s", t->name,
+                    impl->name);
+                start = bench_now();
+                for (size_t k = 0; k < iters; k++) {
+                    memcpy(dst, src, n * t->size);
+                    impl->qsort(dst, n, t->size, t->cmp);
+                }
+                report(name, n, start);
+
+                snprintf(name, sizeof(name), "bsearch/%s/%s", t->name,
+                    impl->name);
+                start = bench_now();
+                for (size_t k = 0; k < iters * n; k++) {
+                    const unsigned char *key = src + (k % n) * t->size;
+                    bench_sink += impl->bsearch(key, dst, n, t->size, t->cmp)
+                        != NULL;
+                }
+                report(name, n, start);
+            }
+        }
+    }
+    free(src);
+    free(dst);
+    return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define strlen uut_strlen
+#define strnlen uut_strnlen
+#define strcmp uut_strcmp
+#define strchr uut_strchr
+#define strrchr uut_strrchr
+#define strspn uut_strspn
+#define strcspn uut_strcspn
+#define strcat uut_strcat
+#define strncat uut_strncat
+#define memchr uut_memchr
+#define memcpy uut_memcpy
+#define memmove uut_memmove
+#define memcmp uut_memcmp
+#define memset uut_memset
+#include "../../../lib/libc/string.c"
+#undef strlen
+#undef strnlen
+#undef strcmp
+#undef strchr
+#undef strrchr
+#undef strspn
+#undef strcspn
+#undef strcat
+#undef strncat
+#undef memchr
+#undef memcpy
+#undef memmove
+#undef memcmp
+#undef memset
+
+/* Byte-at-a-time implementations, as a baseline. */
+static size_t byte_strlen(const char *str)
+{
+    size_t len = 0;
+    while (*str++) {
+        len++;
+    }
+    return len;
+}
+
+static int byte_strcmp(const char *str1, const char *str2)
+{
+    while (*str1 != '\0' && *str1 == *str2) {
+        ++str1, ++str2;
+    }
+    return *str1 - *str2;
+}
+
+static char *byte_strchr(const char *str, int c)
+{
+    while (*str != '\0' && *str != (char)c) {
+        str++;
+    }
+    return *str == (char)c ? (char *)str : NULL;
+}
+
+static void *byte_memchr(const void *src, int c, size_t len)
+{
+    const unsigned char *p = src;
+    for (; len > 0; p++, len--) {
+        if (*p == (unsigned char)c) {
+            return (void *)p;
+        }
+    }
+    return NULL;
+}
+
+static void *byte_memcpy(void *restrict dst, const void *restrict src,
+    size_t len)
+{
+    unsigned char *d = dst;
+    const unsigned char *s = src;
+    while (len-- > 0) {
+        *d++ = *s++;
+    }
+    return dst;
+}
+
+static void *byte_memset(void *dst, int v, size_t len)
+{
+    unsigned char *d = dst;
+    while (len-- > 0) {
+        *d++ = (unsigned char)v;
+    }
+    return dst;
+}
+
+struct impl {
+    const char *name;
+    size_t (*strlen)(const char *);
+    int (*strcmp)(const char *, const char *);
+    char *(*strchr)(const char *, int);
+    void *(*memchr)(const void *, int, size_t);
+    void *(*memcpy)(void *restrict, const void *restrict, size_t);
+    void *(*memset)(void *, int, size_t);
+};
+
+static const struct impl impls[] = {
+    { "byte", byte_strlen, byte_strcmp, byte_strchr, byte_memchr,
+        byte_memcpy, byte_memset },
+    { "word", uut_strlen, uut_strcmp, uut_strchr, uut_memchr, uut_memcpy,
+        uut_memset },
+    { "host", strlen, strcmp, strchr, memchr, memcpy, memset },
+};
+
+static const size_t sizes[] = { 16, 256, 4096, 65536 };
+
+int main(int argc, char **argv)
+{
+    size_t max = sizes[sizeof(sizes) / sizeof(*sizes) - 1];
+    char *str1 = malloc(max + 1);
+    char *str2 = malloc(max + 1);
+    char *dst = malloc(max + 1);
+    char name[32];
+
+    for (size_t i = 0; i < max; i++) {
+        str1[i] = str2[i] = (char)('a' + i % 26);
+    }
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+        size_t size = sizes[i];
+        size_t iters = BENCH_BYTES / size;
+        str1[size] = str2[size] = '\0';
+        for (size_t j = 0; j < sizeof(impls) / sizeof(*impls); j++) {
+            const struct impl *impl = &impls[j];
+            double start;
+
+            snprintf(name, sizeof(name), "strlen/%s", impl->name);
+            start = bench_now();
+            for (size_t k = 0; k < iters; k++) {
+                bench_sink += impl->strlen(str1);
+            }
+            bench_report(name, size, start);
+
+            snprintf(name, sizeof(name), "strcmp/%s", impl->name);
+            start = bench_now();
+            for (size_t k = 0; k < iters; k++) {
+                bench_sink += (size_t)impl->strcmp(str1, str2);
+            }
+            bench_report(name, size, start);
+
+            snprintf(name, sizeof(name), "strchr/%s", impl->name);
+            start = bench_now();
+            for (size_t k = 0; k < iters; k++) {
+                bench_sink += impl->strchr(str1, '#') == NULL;
+            }
+            bench_report(name, size, start);
+
+            snprintf(name, sizeof(name), "memchr/%s", impl->name);
+            start = bench_now();
+            for (size_t k = 0; k < iters; k++) {
+                bench_sink += impl->memchr(str1, '#', size) == NULL;
+            }
+            bench_report(name, size, start);
+
+            snprintf(name, sizeof(name), "memcpy/%s", impl->name);
+            start = bench_now();
+            for (size_t k = 0; k < iters; k++) {
+                bench_sink += (size_t)impl->memcpy(dst, str1, size);
+            }
+            bench_report(name, size, start);
+
+            /* Misaligned source, which takes the shift-merge path. */
+            snprintf(name, sizeof(name), "memcpy+1/%s", impl->name);
+            start = bench_now();
+            for (size_t k = 0; k < iters; k++) {
+                bench_sink += (size_t)impl->memcpy(dst, str1 + 1, size - 1);
+            }
+            bench_report(name, size, start);
+
+            snprintf(name, sizeof(name), "memset/%s", impl->name);
+            start = bench_now();
+            for (size_t k = 0; k < iters; k++) {
+                bench_sink += (size_t)impl->memset(dst, (int)k, size);
+            }
+            bench_report(name, size, start);
+        }
+        str1[size] = str2[size] = (char)('a' + size % 26);
+    }
+    free(str1);
+    free(str2);
+    free(dst);
+    return 0;
+}
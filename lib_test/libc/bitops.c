@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "../../include/sys/bitops.h"
+
+/* Reference implementations, one bit at a time. */
+static unsigned ref_popcount(uint64_t x)
+{
+    unsigned n = 0;
+    for (; x != 0; x >>= 1U) {
+        n += (unsigned)(x & 1U);
+    }
+    return n;
+}
+
+static unsigned ref_ffs(uint64_t x)
+{
+    for (unsigned i = 0; i < 64; i++) {
+        if (x & (1ULL << i)) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+static unsigned ref_fls(uint64_t x)
+{
+    unsigned n = 0;
+    for (; x != 0; x >>= 1U) {
+        n++;
+    }
+    return n;
+}
+
+static uint64_t ref_bswap(uint64_t x)
+{
+    uint64_t r = 0;
+    for (int i = 0; i < 8; i++, x >>= 8U) {
+        r = (r << 8U) | (x & 0xffU);
+    }
+    return r;
+}
+
+/* Checks both the software and the selected versions against the
+ * references. */
+static void check(uint64_t x)
+{
+    assert(popcount64_soft(x) == ref_popcount(x));
+    assert(popcount64(x) == ref_popcount(x));
+    assert(ffs64_soft(x) == ref_ffs(x));
+    assert(ffs64(x) == ref_ffs(x));
+    assert(fls64_soft(x) == ref_fls(x));
+    assert(fls64(x) == ref_fls(x));
+    assert(bswap64_soft(x) == ref_bswap(x));
+    assert(bswap64(x) == ref_bswap(x));
+    assert(bswap32((uint32_t)x) == (uint32_t)(ref_bswap(x) >> 32U));
+    assert(bswap16((uint16_t)x) == (uint16_t)(ref_bswap(x) >> 48U));
+}
+
+int main(int argc, char **argv)
+{
+    check(0);
+    check(UINT64_MAX);
+    for (unsigned i = 0; i < 64; i++) {
+        check(1ULL << i);
+        check((1ULL << i) - 1);
+        check(~(1ULL << i));
+        check(UINT64_MAX << i);
+    }
+    srand(0xb175);
+    for (int i = 0; i < 100000; i++) {
+        uint64_t x = (uint64_t)rand() << 42U ^ (uint64_t)rand() << 21U
+            ^ (uint64_t)rand();
+        check(x);
+        check(x >> (i % 64));
+    }
+    assert(bswap32(0x12345678U) == 0x78563412U);
+    assert(bswap16(0x1234U) == 0x3412U);
+    return 0;
+}
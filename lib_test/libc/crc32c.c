@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../lib/libc/crc32c.c"
+
+/* Carry-less multiplication in software, for the folding code. */
+static uint64_t clmul(uint64_t a, uint64_t b)
+{
+    uint64_t r = 0;
+    for (unsigned i = 0; i < 64; i++) {
+        if (a & (1ULL << i)) {
+            r ^= b << i;
+        }
+    }
+    return r;
+}
+
+static uint64_t clmulh(uint64_t a, uint64_t b)
+{
+    uint64_t r = 0;
+    for (unsigned i = 1; i < 64; i++) {
+        if (a & (1ULL << i)) {
+            r ^= b >> (64U - i);
+        }
+    }
+    return r;
+}
+
+#include "../../lib/libc/crc32c_clmul.h"
+
+#define BUF_MAX 4096
+
+/* Reference implementation, one bit at a time. */
+static uint32_t ref_crc32c(uint32_t crc, const unsigned char *buf, size_t len)
+{
+    crc = ~crc;
+    while (len-- > 0) {
+        crc ^= *buf++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1U) ^ (0x82f63b78U & -(crc & 1U));
+        }
+    }
+    return ~crc;
+}
+
+static void test_vectors(void)
+{
+    unsigned char buf[32];
+
+    /* Check values from RFC 3720, B.4. */
+    assert(crc32c(0, "123456789", 9) == 0xe3069283U);
+    assert(crc32c(0, "", 0) == 0);
+    memset(buf, 0, sizeof(buf));
+    assert(crc32c(0, buf, sizeof(buf)) == 0x8a9136aaU);
+    memset(buf, 0xff, sizeof(buf));
+    assert(crc32c(0, buf, sizeof(buf)) == 0x62a8ab43U);
+    for (int i = 0; i < 32; i++) {
+        buf[i] = (unsigned char)i;
+    }
+    assert(crc32c(0, buf, sizeof(buf)) == 0x46dd794eU);
+    for (int i = 0; i < 32; i++) {
+        buf[i] = (unsigned char)(31 - i);
+    }
+    assert(crc32c(0, buf, sizeof(buf)) == 0x113fdb5cU);
+}
+
+static void test_random(void)
+{
+    static unsigned char buf[BUF_MAX + 8];
+
+    srand(0xc32c);
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = (unsigned char)rand();
+    }
+    for (int n = 0; n < 2000; n++) {
+        size_t off = (size_t)rand() % 8;
+        size_t len = (size_t)rand() % (n < 1000 ? 300 : BUF_MAX);
+        size_t split = len == 0 ? 0 : (size_t)rand() % len;
+        uint32_t seed = (uint32_t)rand();
+        uint32_t crc = ref_crc32c(seed, buf + off, len);
+
+        assert(crc32c(seed, buf + off, len) == crc);
+        /* Checksums can be computed piecewise. */
+        assert(crc32c(crc32c(seed, buf + off, split), buf + off + split,
+                   len - split)
+            == crc);
+        /* Folding, the way harts with carry-less multiplication do it. */
+        assert(~crc32c_fold(~seed, buf + off, len) == crc);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    test_vectors();
+    test_random();
+    return 0;
+}
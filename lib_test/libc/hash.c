@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../lib/libc/hash.c"
+
+/* Length of the longest key. */
+#define KEY_MAX 4103
+
+/* XXH3-64 of the first bytes of key_bytes() for seeds 0, 1 and
+ * 0x0123456789abcdef, obtained from the reference implementation. */
+static const struct {
+    size_t len;
+    uint64_t hash[3];
+} vectors[] = {
+    { 0, { 0x2d06800538d394c2U, 0x4dc5b0cc826f6703U, 0xcc1ca35a1b089c5cU } },
+    { 1, { 0x929e358d27ae3ee2U, 0x7a80bce00884f339U, 0xbae297dd2a98effcU } },
+    { 2, { 0xf4861cd45aad8b47U, 0x8d2051816a1a31d8U, 0xab26e994b399e022U } },
+    { 3, { 0xd95f511cd1108231U, 0x9f99a5f361c20244U, 0x9f131c5f4646b71dU } },
+    { 4, { 0xca1c63ab788ab176U, 0x3deee9504315d4deU, 0x9816cbf60e50e01bU } },
+    { 5, { 0x949187e7326ee240U, 0xb23a24aaca51356eU, 0x016cb7678e63d1f0U } },
+    { 6, { 0xd310375267b00451U, 0x632346df03206f20U, 0x36bc86da5d305b8cU } },
+    { 7, { 0xd7280da47cd6d0ceU, 0x69b3c7bda66b1989U, 0x0bf12a72e5f83273U } },
+    { 8, { 0xf9e91f27291ff523U, 0x46d95ee2ac183f6eU, 0x590fae5003f408e3U } },
+    { 9, { 0xcaf43cf2dddbdf84U, 0x63fb4641b785736eU, 0xf5f7e7040afbb8f7U } },
+    { 10, { 0x0b0b43cbaf6860a9U, 0xb7f9c5dc1199a320U, 0xe16037796071ce50U } },
+    { 11, { 0xf1af08b5139ef38bU, 0xe7e6a8b950442628U, 0x89cf293eddb05ad3U } },
+    { 12, { 0xabc2f4fc05d4492aU, 0xdf468437f3e59b25U, 0x658ddbb0bd092882U } },
+    { 13, { 0x21f737da61529e40U, 0x80996a3a5562daf8U, 0x036df2ce4a23664cU } },
+    { 14, { 0x6e3df853779968baU, 0x6712bd1e8e39ff7bU, 0x84278f1072f9691eU } },
+    { 15, { 0xe9e51bedac6d49c6U, 0xf90465520e2ee42cU, 0xb3580702f871d887U } },
+    { 16, { 0x1fbdc0fc5c58a1e6U, 0xcf39f27346580d04U, 0x70cd8579fbeb0a5bU } },
+    { 17, { 0xfee0a1ba3ee6ade1U, 0x1b5293e50b3235c1U, 0x065f854033a04f0dU } },
+    { 18, { 0x99747be15697cb83U, 0xc664392a8c0c96a2U, 0xf5d589edaddae792U } },
+    { 19, { 0x9b0630e070628931U, 0x4c88948f8ef5c30cU, 0x1c69c4f2ca29e89aU } },
+    { 31, { 0x4b0449fbf02cb474U, 0xf59d2e53f53acfafU, 0x3a0674bc5215f035U } },
+    { 32, { 0x1adce08a0a2bccb1U, 0xfcb016c7860e480fU, 0x2f39df513be75facU } },
+    { 33, { 0x95572f4bf59a18b5U, 0x8c9019c3d27781fcU, 0x4375d47bcfe11ab4U } },
+    { 48, { 0x67056a73cd0eeb92U, 0x73bdaadfa4a6aaafU, 0x8650f0705e344232U } },
+    { 63, { 0xe4e9aff545ec0de3U, 0x11f2bddeb9140a17U, 0x864b30a84696d8eeU } },
+    { 64, { 0x90747d80b02e5d03U, 0xfe063f698506a710U, 0xdf26d504c7569e15U } },
+    { 65, { 0x86c27660247dacf6U, 0xdc0bf5cd12467764U, 0x529865a4f7ef2649U } },
+    { 96, { 0x3bef0ead69fab8e1U, 0x31f0eee08cf31b94U, 0x9302c5fad712a289U } },
+    { 97, { 0x8983a04553a1130cU, 0xa36b74fa3bd0b053U, 0x0b35e174c1ee0cafU } },
+    { 127, { 0xbd3b27f9358c4a57U, 0x4fd3f8d1001f880eU, 0x6069cfaf9ed60f32U } },
+    { 128, { 0x5852e3f29796b15dU, 0xa6c9fe49af0c7d1aU, 0x860995060e0ad6caU } },
+    { 129, { 0xccdd55e72fcbe19aU, 0x08d34dffbbf68f2fU, 0x8c725c2c7c475330U } },
+    { 160, { 0x932893ebd96eb1f9U, 0x61aa5bdc59664914U, 0xd4faad61819dfe3dU } },
+    { 239, { 0xc0c12958963c8f23U, 0x61e934841cefdf87U, 0x88b9cdf213c9b226U } },
+    { 240, { 0xfd89c11687b8b48aU, 0xa71f87101ef811a1U, 0xd8cb093beacb44ecU } },
+    { 241, { 0xae02df2598c4ffacU, 0x55c555725cd0dfafU, 0xf8bd0e5f5dc1909eU } },
+    { 255, { 0x72516c713c92e0e1U, 0xbf12cbe97cc6d4e7U, 0x398e89ff0de9ea86U } },
+    { 256, { 0x60cc644797e04413U, 0xab520fe5fe4ac026U, 0x0bc5290013744039U } },
+    { 500, { 0x8ec412c5f3dbd7f3U, 0x42fb5522c863246fU, 0x21b14322a2d1957aU } },
+    { 1023, { 0x253c9fb70332e769U, 0x37d858a48219d7a8U, 0xfbc4bd1966377404U } },
+    { 1024, { 0x5a487b950ce18bdaU, 0xa87cb4f8d0432d1dU, 0x4a36db47df87260fU } },
+    { 1025, { 0x1e0fb31a274c3954U, 0xd196565d8d0d3513U, 0x2f237cdcde05ac99U } },
+    { 1088, { 0xe1dfa7e61af4af81U, 0x6dccc7a72808a2cdU, 0xb7cc863daa5b4f8eU } },
+    { 2048, { 0x4af2f0321078031dU, 0x574cd7c69d11663aU, 0xcd0e58c803b52488U } },
+    { 4103, { 0x2d123b1f136f1a48U, 0x5a750312478bcb29U, 0xf4eca83a7c221914U } },
+};
+
+static const uint64_t seeds[] = { 0, 1, 0x0123456789abcdefU };
+
+static void key_bytes(unsigned char *key, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        key[i] = (unsigned char)(i * 167 + (i >> 8U) * 13 + 5);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static unsigned char key[KEY_MAX + 8];
+
+    key_bytes(key, KEY_MAX);
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        for (size_t j = 0; j < 3; j++) {
+            assert(
+                hash64(key, vectors[i].len, seeds[j]) == vectors[i].hash[j]);
+        }
+    }
+
+    /* The hash depends on the bytes only, not on their alignment. */
+    for (size_t off = 1; off < 8; off++) {
+        key_bytes(key + off, KEY_MAX);
+        for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+            assert(hash64(key + off, vectors[i].len, seeds[2])
+                == vectors[i].hash[2]);
+        }
+    }
+
+    /* Flipping any bit of a short key changes its hash. */
+    srand(0x4a54);
+    for (int n = 0; n < 10000; n++) {
+        size_t len = 1 + (size_t)rand() % 32;
+        size_t bit = (size_t)rand() % (len * 8);
+        uint64_t seed = (uint64_t)rand();
+        uint64_t h;
+
+        for (size_t i = 0; i < len; i++) {
+            key[i] = (unsigned char)rand();
+        }
+        h = hash64(key, len, seed);
+        key[bit / 8] ^= (unsigned char)(1U << (bit % 8));
+        assert(hash64(key, len, seed) != h);
+    }
+    return 0;
+}
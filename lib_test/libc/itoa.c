@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../lib/libc/itoa.c"
+
+/* Converts a value with the given function and NUL-terminates the result. */
+#define CONVERT(buf, fn, ...)                                                  \
+    do {                                                                       \
+        memset((buf), 0xcc, sizeof(buf));                                      \
+        (buf)[fn((buf), __VA_ARGS__)] = '\0';                                  \
+    } while (0)
+
+/* Test that decimal conversion works around every power of ten. */
+static void test_itoa_dec(void)
+{
+    char buf[ITOA_MAXLEN + 1];
+    char ref[ITOA_MAXLEN + 1];
+    uint64_t val = 1;
+
+    CONVERT(buf, itoa_dec, 0);
+    assert(!strcmp(buf, "0"));
+    assert(itoa_declen(0) == 1);
+
+    CONVERT(buf, itoa_dec, UINT64_MAX);
+    assert(!strcmp(buf, "18446744073709551615"));
+    assert(itoa_declen(UINT64_MAX) == 20);
+
+    for (int i = 0; i < 20; i++, val *= 10) {
+        uint64_t vals[] = { val - 1, val, val + 1 };
+        for (int j = 0; j < 3; j++) {
+            snprintf(ref, sizeof(ref), "%" PRIu64, vals[j]);
+            CONVERT(buf, itoa_dec, vals[j]);
+            assert(!strcmp(buf, ref));
+            assert(itoa_declen(vals[j]) == strlen(ref));
+        }
+    }
+}
+
+/* Test that hexadecimal and octal conversions work around every power of
+ * two. */
+static void test_itoa_hex_oct(void)
+{
+    char buf[ITOA_MAXLEN + 1];
+    char ref[ITOA_MAXLEN + 1];
+
+    CONVERT(buf, itoa_hex, 0, 0);
+    assert(!strcmp(buf, "0"));
+    CONVERT(buf, itoa_oct, 0);
+    assert(!strcmp(buf, "0"));
+
+    CONVERT(buf, itoa_hex, 0xDEADBEEFCAFEULL, 1);
+    assert(!strcmp(buf, "DEADBEEFCAFE"));
+    CONVERT(buf, itoa_oct, UINT64_MAX);
+    assert(!strcmp(buf, "1777777777777777777777"));
+    assert(strlen(buf) == ITOA_MAXLEN);
+
+    for (int i = 0; i < 64; i++) {
+        uint64_t vals[] = { (1ULL << i) - 1, 1ULL << i, (1ULL << i) + 1 };
+        for (int j = 0; j < 3; j++) {
+            snprintf(ref, sizeof(ref), "%" PRIx64, vals[j]);
+            CONVERT(buf, itoa_hex, vals[j], 0);
+            assert(!strcmp(buf, ref));
+            assert(itoa_hexlen(vals[j]) == strlen(ref));
+
+            snprintf(ref, sizeof(ref), "%" PRIo64, vals[j]);
+            CONVERT(buf, itoa_oct, vals[j]);
+            assert(!strcmp(buf, ref));
+            assert(itoa_octlen(vals[j]) == strlen(ref));
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    test_itoa_dec();
+    test_itoa_hex_oct();
+    return 0;
+}
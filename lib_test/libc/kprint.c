@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Rename the stream API so that it does not clash with that of the host. */
+typedef struct _FILE uut_FILE;
+#define FILE uut_FILE
+#undef stdout
+#undef stderr
+#define stdout uut_stdout
+#define stderr uut_stderr
+#define setvbuf uut_setvbuf
+#define fflush uut_fflush
+#define fwrite uut_fwrite
+#define fputc uut_fputc
+#undef putc
+#define putc uut_putc
+#define fputs uut_fputs
+#define ferror uut_ferror
+#define clearerr uut_clearerr
+#include "../../lib/libc/itoa.c"
+#include "../../lib/libc/kprint.c"
+#include "../../lib/libc/stdio.c"
+
+/* Test state. */
+struct state {
+    size_t write_calls;
+    char write_buf[1024];
+    size_t write_len;
+} g_state;
+
+static void prepare_test(struct state *state)
+{
+    memset(state, 0, sizeof(*state));
+    /* Make each call write its output straight away. */
+    uut_setvbuf(uut_stdout, NULL, _IONBF, 0);
+}
+
+ssize_t writev(int fd, const struct iovec *iov, int iovcnt)
+{
+    size_t count = 0;
+
+    g_state.write_calls++;
+    for (int i = 0; i < iovcnt; i++) {
+        memcpy(g_state.write_buf + g_state.write_len, iov[i].iov_base,
+            iov[i].iov_len);
+        count += iov[i].iov_len;
+    }
+    g_state.write_len += count;
+    return (ssize_t)count;
+}
+
+/* Test that fields print the same as their printf() equivalents. */
+static void test_kprint(void)
+{
+    char ref[64];
+    int rc;
+
+    prepare_test(&g_state);
+    rc = kprint(KP_S("t"), KP_D(2, -3), KP_S("=0x"), KP_X(0xcafeULL, 16),
+        KP_S("\t"));
+    snprintf(ref, sizeof(ref), "t%-3d=0x%016llx\t", 2, 0xcafeULL);
+    assert(rc == strlen(ref));
+    assert(g_state.write_calls == 1);
+    assert(!strcmp(g_state.write_buf, ref));
+
+    prepare_test(&g_state);
+    rc = kprint(KP_D(INTMAX_MIN, 0), KP_C(' '), KP_D(-42, 5), KP_C('|'),
+        KP_U(UINTMAX_MAX, 0), KP_C('|'), KP_U(7, -3), KP_C('|'),
+        KP_X(0xABC, -6), KP_STRING("end"));
+    snprintf(ref, sizeof(ref), "%jd %5d|%ju|%-3u|%-6x%s", INTMAX_MIN, -42,
+        UINTMAX_MAX, 7U, 0xABCU, "end");
+    assert(rc == strlen(ref));
+    assert(!strcmp(g_state.write_buf, ref));
+
+    /* Fields wider than their width are not truncated. */
+    prepare_test(&g_state);
+    rc = kfprint(uut_stderr, KP_X(0x12345, 2), KP_D(123, 1));
+    assert(rc == 8);
+    assert(!strcmp(g_state.write_buf, "12345123"));
+}
+
+int main(int argc, char **argv)
+{
+    test_kprint();
+    return 0;
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <assert.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define malloc uut_malloc
+#define calloc uut_calloc
+#define aligned_alloc uut_aligned_alloc
+#define realloc uut_realloc
+#define free uut_free
+#include "../../lib/libc/malloc.c"
+#undef malloc
+#undef calloc
+#undef aligned_alloc
+#undef realloc
+#undef free
+
+#define N_LIVE 4096
+
+static void fill(unsigned char *p, size_t size, unsigned seed)
+{
+    for (size_t i = 0; i < size; i++) {
+        p[i] = (unsigned char)(seed + i * 7);
+    }
+}
+
+static void check(const unsigned char *p, size_t size, unsigned seed)
+{
+    for (size_t i = 0; i < size; i++) {
+        assert(p[i] == (unsigned char)(seed + i * 7));
+    }
+}
+
+static void test_classes(void)
+{
+    assert(class_size(CLASS_COUNT - 1) == SMALL_MAX);
+    for (size_t size = 0; size <= SMALL_MAX; size++) {
+        unsigned cls = size_class(size);
+        assert(cls < CLASS_COUNT);
+        assert(class_size(cls) >= size);
+        assert(cls == 0 || class_size(cls - 1) < size);
+        assert(class_size(cls) % MALLOC_ALIGN == 0);
+    }
+}
+
+/* Random sizes, mostly small, with every allocation checked for overlaps
+ * before it is freed or resized. */
+static void test_random(void)
+{
+    static unsigned char *ptrs[N_LIVE];
+    static size_t sizes[N_LIVE];
+    size_t size, i;
+
+    srand(0x25);
+    for (unsigned it = 0; it < 200000; it++) {
+        i = (size_t)rand() % N_LIVE;
+        size = rand() % 16 != 0 ? (size_t)rand() % 512
+                                : (size_t)rand() % (3 * SMALL_MAX);
+        if (ptrs[i] == NULL) {
+            ptrs[i] = uut_malloc(size);
+            assert(ptrs[i] != NULL);
+        } else if (rand() % 2 == 0) {
+            check(ptrs[i], sizes[i], (unsigned)i);
+            ptrs[i] = uut_realloc(ptrs[i], size);
+            assert(ptrs[i] != NULL);
+            check(ptrs[i], size < sizes[i] ? size : sizes[i], (unsigned)i);
+        } else {
+            check(ptrs[i], sizes[i], (unsigned)i);
+            uut_free(ptrs[i]);
+            ptrs[i] = NULL;
+            continue;
+        }
+        assert((uintptr_t)ptrs[i] % MALLOC_ALIGN == 0);
+        sizes[i] = size;
+        fill(ptrs[i], size, (unsigned)i);
+    }
+    for (i = 0; i < N_LIVE; i++) {
+        if (ptrs[i] != NULL) {
+            check(ptrs[i], sizes[i], (unsigned)i);
+        }
+        uut_free(ptrs[i]);
+    }
+}
+
+static void test_calloc(void)
+{
+    static const size_t sizes[] = { 1, 16, 100, 4000, SMALL_MAX, 100000 };
+    static unsigned char *ptrs[64];
+    unsigned char *p;
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+        /* Dirty some objects so that the next ones are given back, not
+         * fresh. */
+        for (size_t j = 0; j < 64; j++) {
+            ptrs[j] = uut_malloc(sizes[i]);
+            memset(ptrs[j], 0xa5, sizes[i]);
+        }
+        for (size_t j = 0; j < 64; j++) {
+            uut_free(ptrs[j]);
+        }
+        for (size_t j = 0; j < 64; j++) {
+            ptrs[j] = uut_calloc(1, sizes[i]);
+            assert(ptrs[j] != NULL);
+            for (size_t k = 0; k < sizes[i]; k++) {
+                assert(ptrs[j][k] == 0);
+            }
+            memset(ptrs[j], 0x5a, sizes[i]);
+        }
+        for (size_t j = 0; j < 64; j++) {
+            uut_free(ptrs[j]);
+        }
+    }
+    p = uut_calloc(0, 0);
+    assert(p != NULL);
+    uut_free(p);
+    errno = 0;
+    assert(uut_calloc(SIZE_MAX / 2, 3) == NULL);
+    assert(errno == ENOMEM);
+    errno = 0;
+    assert(uut_malloc(SIZE_MAX - 100) == NULL);
+    assert(errno == ENOMEM);
+}
+
+static void test_aligned_alloc(void)
+{
+    unsigned char *p, *q;
+
+    for (size_t align = 1; align <= SPAN_SIZE * 4; align *= 2) {
+        for (size_t size = 1; size <= 3 * SMALL_MAX; size = size * 3 + 1) {
+            p = uut_aligned_alloc(align, size);
+            q = uut_aligned_alloc(align, size);
+            assert(p != NULL && q != NULL);
+            assert((uintptr_t)p % align == 0 && (uintptr_t)q % align == 0);
+            memset(p, 1, size);
+            memset(q, 2, size);
+            assert(p[size - 1] == 1);
+            uut_free(p);
+            uut_free(q);
+        }
+    }
+    errno = 0;
+    assert(uut_aligned_alloc(48, 16) == NULL);
+    assert(errno == EINVAL);
+}
+
+static void test_realloc(void)
+{
+    unsigned char *p = uut_realloc(NULL, 10), *q;
+
+    fill(p, 10, 1);
+    /* Growing within a class stays in place. */
+    assert(uut_realloc(p, 16) == p);
+    for (size_t size = 16; size <= 1UL << 22; size *= 2) {
+        q = uut_realloc(p, size);
+        assert(q != NULL);
+        check(q, 10, 1);
+        p = q;
+    }
+    /* Shrinking a large allocation a little keeps the mapping. */
+    assert(uut_realloc(p, (1UL << 22) - 4096) == p);
+    p = uut_realloc(p, 100);
+    check(p, 10, 1);
+    uut_free(p);
+    uut_free(NULL);
+}
+
+/* Once every object of a class is freed, only the spans of those left in
+ * the cache are in use, and a single empty span is kept mapped. */
+static void test_spans(void)
+{
+    static void *ptrs[N_LIVE];
+    unsigned cls = size_class(1000);
+    struct tcache_bin *bin = &tcache_get()[cls];
+    size_t partial = 0;
+
+    for (size_t i = 0; i < N_LIVE; i++) {
+        ptrs[i] = uut_malloc(1000);
+    }
+    for (size_t i = 0; i < N_LIVE; i++) {
+        uut_free(ptrs[i]);
+    }
+    while (bin->count >= tcache_max(cls) / 2) {
+        tcache_flush(bin, cls, tcache_max(cls) / 2);
+    }
+    for (struct span *s = centrals[cls].partial; s != NULL; s = s->next) {
+        assert(s->used > 0);
+        partial++;
+    }
+    assert(partial <= bin->count + 1);
+    assert(centrals[cls].empty != NULL && centrals[cls].empty->used == 0);
+}
+
+int main(int argc, char **argv)
+{
+    test_classes();
+    test_random();
+    test_calloc();
+    test_aligned_alloc();
+    test_realloc();
+    test_spans();
+    return 0;
+}
@@ -16,34 +16,81 @@
  */
 
 #include <assert.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/printf.h>
 
+/* Not defined by the host <limits.h> in strict C99 mode. */
+#define NL_ARGMAX 32
+
+#include "../../lib/libc/itoa.c"
 #include "../../lib/libc/printf_convspec.c"
+#include "../../lib/libc/printf_float.c"
+
+/* Rename the stream API so that it does not clash with that of the host. */
+typedef struct _FILE uut_FILE;
+#define FILE uut_FILE
+#undef stdout
+#undef stderr
+#define stdout uut_stdout
+#define stderr uut_stderr
+#define setvbuf uut_setvbuf
+#define fflush uut_fflush
+#define fwrite uut_fwrite
+#define fputc uut_fputc
+#undef putc
+#define putc uut_putc
+#define fputs uut_fputs
+#define ferror uut_ferror
+#define clearerr uut_clearerr
+#include "../../lib/libc/stdio.c"
 
 #define printf uut_printf
 #define vprintf uut_vprintf
+#define fprintf uut_fprintf
+#define vfprintf uut_vfprintf
+#define snprintf uut_snprintf
+#define vsnprintf uut_vsnprintf
+#define sprintf uut_sprintf
+#define vsprintf uut_vsprintf
 #include "../../lib/libc/printf.c"
 #undef printf
 #undef vprintf
+#undef fprintf
+#undef vfprintf
+#undef snprintf
+#undef vsnprintf
+#undef sprintf
+#undef vsprintf
 
 /* Test state. */
 struct state {
     size_t write_calls;
     char write_buf[1024];
     size_t write_len;
+    /* Buffers passed to the last writev() call. */
+    const void *write_iov[STREAM_IOV_MAX + 1];
 } g_state;
 
 static void prepare_test(struct state *state)
 {
     memset(state, 0, sizeof(*state));
+    /* Make each call write its output straight away. */
+    uut_setvbuf(uut_stdout, NULL, _IONBF, 0);
 }
 
-ssize_t write(int fd, const void *buf, size_t count)
+ssize_t writev(int fd, const struct iovec *iov, int iovcnt)
 {
+    size_t count = 0;
+
     g_state.write_calls++;
-    strncat(g_state.write_buf, buf, count);
+    for (int i = 0; i < iovcnt; i++) {
+        strncat(g_state.write_buf, iov[i].iov_base, iov[i].iov_len);
+        g_state.write_iov[i] = iov[i].iov_base;
+        count += iov[i].iov_len;
+    }
     g_state.write_len += count;
     return (ssize_t)count;
 }
@@ -66,7 +113,7 @@ static void test_vfprintf_impl(void)
     assert(rc == strlen("hello world"));
     assert(!strcmp(g_state.write_buf, "hello world"));
     assert(g_state.write_len == strlen("hello world"));
-    assert(g_state.write_calls == 3);
+    assert(g_state.write_calls == 1);
 
     /* Test writing simple strings. */
     prepare_test(&g_state);
@@ -74,7 +121,7 @@ static void test_vfprintf_impl(void)
     assert(rc == strlen("hello, world!\n"));
     assert(!strcmp(g_state.write_buf, "hello, world!\n"));
     assert(g_state.write_len == strlen("hello, world!\n"));
-    assert(g_state.write_calls == 4);
+    assert(g_state.write_calls == 1);
 
     /* Test leading padding. */
     prepare_test(&g_state);
@@ -82,7 +129,7 @@ static void test_vfprintf_impl(void)
     assert(rc == 4);
     assert(!strcmp(g_state.write_buf, "   x"));
     assert(g_state.write_len == 4);
-    assert(g_state.write_calls >= 2);
+    assert(g_state.write_calls == 1);
 
     /* Test trailing padding. */
     prepare_test(&g_state);
@@ -90,7 +137,7 @@ static void test_vfprintf_impl(void)
     assert(rc == 4);
     assert(!strcmp(g_state.write_buf, "x   "));
     assert(g_state.write_len == 4);
-    assert(g_state.write_calls >= 2);
+    assert(g_state.write_calls == 1);
 
     /* Test precision part on strings. */
     prepare_test(&g_state);
@@ -153,10 +200,356 @@ static void test_vfprintf_impl(void)
     assert(rc == 8);
     assert(!strcmp(g_state.write_buf, "00000010"));
     assert(g_state.write_len == 8);
+
+    /* Test zero padding after signs and prefixes. */
+    prepare_test(&g_state);
+    rc = uut_printf("%05d|%+05d|%+d|%#06x|%o", -42, 42, 0, 0xff, 8);
+    assert(rc == strlen("-0042|+0042|+0|0x00ff|10"));
+    assert(!strcmp(g_state.write_buf, "-0042|+0042|+0|0x00ff|10"));
+}
+
+/* Test that length modifiers fetch and truncate arguments correctly. */
+static void test_vfprintf_impl_length(void)
+{
+    int rc;
+
+    /* Signed conversions. */
+    prepare_test(&g_state);
+    rc = uut_printf("%ld|%lld|%D|%d", -9223372036854775807L - 1,
+        9223372036854775807LL, 1234567890123L, 42);
+    assert(!strcmp(g_state.write_buf,
+        "-9223372036854775808|9223372036854775807|1234567890123|42"));
+    assert(rc == strlen(g_state.write_buf));
+
+    prepare_test(&g_state);
+    rc = uut_printf("%hhd|%hd|%hhi|%hi", 200, 70000, -129, -32769);
+    assert(!strcmp(g_state.write_buf, "-56|4464|127|32767"));
+    assert(rc == strlen(g_state.write_buf));
+
+    prepare_test(&g_state);
+    rc = uut_printf("%jd|%zd|%td|%d", (intmax_t)-1, (size_t)-2,
+        (ptrdiff_t)-3, -4);
+    assert(!strcmp(g_state.write_buf, "-1|-2|-3|-4"));
+    assert(rc == strlen(g_state.write_buf));
+
+    /* Unsigned conversions. */
+    prepare_test(&g_state);
+    rc = uut_printf("%hhu|%hu|%hhx|%hx|%u", 300, 70000, -1, -1, -1);
+    assert(!strcmp(g_state.write_buf, "44|4464|ff|ffff|4294967295"));
+    assert(rc == strlen(g_state.write_buf));
+
+    prepare_test(&g_state);
+    rc = uut_printf("%lu|%llx|%jo|%zu|%tx|%U", 18446744073709551615UL,
+        0xdeadbeefcafebabeULL, (uintmax_t)8, (size_t)42, (ptrdiff_t)255,
+        4294967296UL);
+    assert(!strcmp(g_state.write_buf,
+        "18446744073709551615|deadbeefcafebabe|10|42|ff|4294967296"));
+    assert(rc == strlen(g_state.write_buf));
+}
+
+/* Test that fragments are coalesced into as few writes as possible. */
+static void test_vfprintf_impl_coalescing(void)
+{
+    char big[PRINTF_BUFSIZ * 3];
+    int rc;
+
+    /* Padding and conversions are staged and flushed once. */
+    prepare_test(&g_state);
+    rc = uut_printf("t%-3d=0x%016x\t", 4, 0xcafe);
+    assert(rc == strlen("t4  =0x000000000000cafe\t"));
+    assert(!strcmp(g_state.write_buf, "t4  =0x000000000000cafe\t"));
+    assert(g_state.write_calls == 1);
+
+    /* Padding wider than the staging buffer is split across flushes. */
+    prepare_test(&g_state);
+    rc = uut_printf("%300c", 'x');
+    assert(rc == 300);
+    assert(g_state.write_len == 300);
+    assert(g_state.write_buf[298] == ' ' && g_state.write_buf[299] == 'x');
+    assert(g_state.write_calls == 3);
+
+    /* Fragments larger than the staging buffer are referenced in place. */
+    memset(big, 'a', sizeof(big) - 1);
+    big[sizeof(big) - 1] = '\0';
+    prepare_test(&g_state);
+    rc = uut_printf("<%s>", big);
+    assert(rc == sizeof(big) + 1);
+    assert(g_state.write_len == sizeof(big) + 1);
+    assert(g_state.write_buf[0] == '<');
+    assert(g_state.write_buf[sizeof(big)] == '>');
+    assert(g_state.write_calls == 1);
+    assert(g_state.write_iov[1] == big);
+}
+
+/* Test that long literals and strings are not copied. */
+static void test_vfprintf_impl_gather(void)
+{
+    static const char fmt[] = "a literal run long enough to reference %s!";
+    static const char str[] = "and a string argument";
+    int rc;
+
+    prepare_test(&g_state);
+    rc = uut_printf(fmt, str);
+    assert(rc == strlen(fmt) - 2 + strlen(str));
+    assert(!strcmp(g_state.write_buf,
+        "a literal run long enough to reference and a string argument!"));
+    assert(g_state.write_calls == 1);
+    assert(g_state.write_iov[0] == fmt);
+    assert(g_state.write_iov[1] == str);
+
+    /* Short fragments are staged instead. */
+    prepare_test(&g_state);
+    rc = uut_printf("%s:%s", "a", "b");
+    assert(rc == 3);
+    assert(g_state.write_calls == 1);
+    assert(!strcmp(g_state.write_buf, "a:b"));
+
+    /* Vectors longer than the stream can take at once are split. */
+    prepare_test(&g_state);
+    rc = uut_printf("%s%d%s%d%s%d%s%d%s%d%s%d%s%d%s%d%s%d", str, 1, str, 2,
+        str, 3, str, 4, str, 5, str, 6, str, 7, str, 8, str, 9);
+    assert(rc == 9 * (strlen(str) + 1));
+    assert(g_state.write_calls == 2);
+    assert(g_state.write_len == 9 * (strlen(str) + 1));
+}
+
+/* Test formatting into memory with the *sprintf() family. */
+static void test_snprintf(void)
+{
+    char buf[16];
+    int rc;
+
+    /* Output fits in the buffer. */
+    prepare_test(&g_state);
+    memset(buf, 0xcc, sizeof(buf));
+    rc = uut_snprintf(buf, sizeof(buf), "%s=%4d", "x", 42);
+    assert(rc == strlen("x=  42"));
+    assert(!strcmp(buf, "x=  42"));
+    assert(g_state.write_calls == 0);
+
+    /* Output is truncated and NUL-terminated, but the return value is the
+     * length the full output would have had. */
+    memset(buf, 0xcc, sizeof(buf));
+    rc = uut_snprintf(buf, 8, "%s, %s!", "hello", "world");
+    assert(rc == strlen("hello, world!"));
+    assert(!strcmp(buf, "hello, "));
+    assert((unsigned char)buf[8] == 0xcc);
+
+    /* Padding is truncated as well. */
+    memset(buf, 0xcc, sizeof(buf));
+    rc = uut_snprintf(buf, 4, "%-8c|", 'x');
+    assert(rc == 9);
+    assert(!strcmp(buf, "x  "));
+
+    /* A size of 1 only fits the NUL terminator. */
+    memset(buf, 0xcc, sizeof(buf));
+    rc = uut_snprintf(buf, 1, "hello");
+    assert(rc == 5);
+    assert(buf[0] == '\0');
+    assert((unsigned char)buf[1] == 0xcc);
+
+    /* A size of 0 writes nothing, and the buffer may be NULL. */
+    rc = uut_snprintf(NULL, 0, "%x", 0xdead);
+    assert(rc == 4);
+
+    /* Unbounded variant. */
+    memset(buf, 0xcc, sizeof(buf));
+    rc = uut_sprintf(buf, "%08x", 0xbeef);
+    assert(rc == 8);
+    assert(!strcmp(buf, "0000beef"));
+    assert(g_state.write_calls == 0);
+}
+
+/* Test compiling format strings and formatting with them. */
+static void test_printf_compiled(void)
+{
+    struct printf_fmt pf;
+    int rc;
+
+    /* Literal spans and conversions are split into operations. */
+    rc = printf_compile(&pf, "t%-3d=0x%016x\t");
+    assert(rc == 3);
+    assert(pf.nops == 3);
+    assert(pf.ops[0].lit_len == 1 && pf.ops[0].conv == 'd');
+    assert(pf.ops[0].width == 3 && pf.ops[0].flags == CONVSPEC_MINUS);
+    assert(pf.ops[1].lit_len == 3 && pf.ops[1].conv == 'x');
+    assert(pf.ops[1].width == 16 && pf.ops[1].flags == CONVSPEC_ZERO);
+    assert(pf.ops[2].lit_len == 1 && pf.ops[2].conv == '\0');
+
+    /* Compiled format strings may be used repeatedly. */
+    for (int i = 0; i < 2; i++) {
+        prepare_test(&g_state);
+        rc = printf_compiled(&pf, 7, 0xcafe);
+        assert(rc == strlen("t7  =0x000000000000cafe\t"));
+        assert(!strcmp(g_state.write_buf, "t7  =0x000000000000cafe\t"));
+        assert(g_state.write_calls == 1);
+    }
+
+    /* The empty string compiles to a single empty literal. */
+    rc = printf_compile(&pf, "");
+    assert(rc == 1);
+    prepare_test(&g_state);
+    rc = printf_compiled(&pf);
+    assert(rc == 0);
+
+    /* Escaped percent signs. */
+    rc = printf_compile(&pf, "100%%");
+    assert(rc == 2);
+    prepare_test(&g_state);
+    rc = printf_compiled(&pf);
+    assert(rc == 4);
+    assert(!strcmp(g_state.write_buf, "100%"));
+
+    /* Invalid specifiers and positional arguments are rejected. */
+    errno = 0;
+    rc = printf_compile(&pf, "%#d");
+    assert(rc < 0 && pf.nops < 0 && errno == EINVAL);
+    errno = 0;
+    rc = printf_compile(&pf, "%1$d");
+    assert(rc < 0 && pf.nops < 0 && errno == EINVAL);
+    prepare_test(&g_state);
+    rc = printf_compiled(&pf, 1);
+    assert(rc < 0);
+    assert(g_state.write_calls == 0);
+
+    /* Too many conversions. */
+    rc = printf_compile(&pf, "%c%c%c%c%c%c%c%c%c%c%c%c%c%c%c");
+    assert(rc == PRINTF_OPS_MAX);
+    rc = printf_compile(&pf, "%c%c%c%c%c%c%c%c%c%c%c%c%c%c%c%c");
+    assert(rc < 0 && errno == EINVAL);
+
+    /* Call sites cache their compiled format string. */
+    for (int i = 0; i < 3; i++) {
+        prepare_test(&g_state);
+        PRINTF_CACHED("%s:%d", "line", i);
+        assert(g_state.write_buf[5] == '0' + i);
+        assert(g_state.write_calls == 1);
+    }
+
+    /* Format strings that cannot be compiled are still printed. */
+    memset(&pf, 0, sizeof(pf));
+    prepare_test(&g_state);
+    rc = printf_cached(&pf, "%1$c", 'x');
+    assert(rc == 1 && pf.nops < 0);
+    /* ...and are only tried once. */
+    pf.ops[0].lit = NULL;
+    prepare_test(&g_state);
+    rc = printf_cached(&pf, "%1$c", 'y');
+    assert(rc == 1 && pf.nops < 0 && pf.ops[0].lit == NULL);
+}
+
+/* Test padding of floating-point conversions. Their digits are covered by
+ * the printf_float tests. */
+static void test_snprintf_float(void)
+{
+    char buf[32];
+    int rc;
+
+    rc = uut_snprintf(buf, sizeof(buf), "[%8.3f]", -3.14159);
+    assert(rc == strlen("[  -3.142]"));
+    assert(!strcmp(buf, "[  -3.142]"));
+    rc = uut_snprintf(buf, sizeof(buf), "[%-8.1e]", 1500.0);
+    assert(!strcmp(buf, "[1.5e+03 ]"));
+    rc = uut_snprintf(buf, sizeof(buf), "[%+010.2f]", 2.5);
+    assert(!strcmp(buf, "[+000002.50]"));
+    rc = uut_snprintf(buf, sizeof(buf), "[%010a]", 1.0);
+    assert(!strcmp(buf, "[0x00001p+0]"));
+    rc = uut_snprintf(buf, sizeof(buf), "[%05f|%-5F]", -INFINITY, NAN);
+    assert(!strcmp(buf, "[ -inf|NAN  ]"));
+    rc = uut_snprintf(buf, sizeof(buf), "%g %g", 0.0001, 123456789.0);
+    assert(!strcmp(buf, "0.0001 1.23457e+08"));
+
+    /* Output is never buffered whole, so it may be truncated. */
+    rc = uut_snprintf(buf, sizeof(buf), "%.100f", 1.0);
+    assert(rc == 102);
+    assert(strlen(buf) == sizeof(buf) - 1);
+}
+
+/* Test that numbered arguments are fetched once, in any order. */
+static void test_positional(void)
+{
+    char fmt[256];
+    char buf[64];
+    int rc;
+
+    rc = uut_snprintf(buf, sizeof(buf), "%2$s %1$s", "world", "hello");
+    assert(rc == strlen("hello world"));
+    assert(!strcmp(buf, "hello world"));
+
+    /* Arguments of different types and widths, referenced more than once. */
+    rc = uut_snprintf(buf, sizeof(buf), "%3$.1f|%1$lld|%2$c|%3$g|%1$llx%%",
+        -1LL, 'x', 2.5);
+    assert(!strcmp(buf, "2.5|-1|x|2.5|ffffffffffffffff%"));
+
+    /* Up to NL_ARGMAX arguments can be referenced. */
+    fmt[0] = '\0';
+    for (int i = NL_ARGMAX; i > 0; i--) {
+        snprintf(fmt + strlen(fmt), sizeof(fmt) - strlen(fmt), "%%%d$d", i);
+    }
+    rc = uut_snprintf(buf, sizeof(buf), fmt, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1,
+        2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2);
+    assert(rc == NL_ARGMAX);
+    assert(!strcmp(buf, "21098765432109876543210987654321"));
+
+    /* Numbered and unnumbered conversions cannot be mixed. */
+    errno = 0;
+    rc = uut_snprintf(buf, sizeof(buf), "%1$d %d", 1, 2);
+    assert(rc < 0 && errno == EINVAL);
+    errno = 0;
+    rc = uut_snprintf(buf, sizeof(buf), "%d %1$d", 1);
+    assert(rc < 0 && errno == EINVAL);
+    /* The same argument cannot have different types. */
+    errno = 0;
+    rc = uut_snprintf(buf, sizeof(buf), "%1$d %1$s", 1);
+    assert(rc < 0 && errno == EINVAL);
+    /* All arguments up to the last one must be referenced. */
+    errno = 0;
+    rc = uut_snprintf(buf, sizeof(buf), "%2$d", 1, 2);
+    assert(rc < 0 && errno == EINVAL);
+    /* Arguments beyond NL_ARGMAX cannot be referenced. */
+    errno = 0;
+    rc = uut_snprintf(buf, sizeof(buf), "%33$d", 1);
+    assert(rc < 0 && errno == EINVAL);
+    /* Arguments are numbered from 1. */
+    errno = 0;
+    rc = uut_snprintf(buf, sizeof(buf), "%0$d", 1);
+    assert(rc < 0 && errno == EINVAL);
+}
+
+/* Test that output goes through the stream buffer. */
+static void test_fprintf(void)
+{
+    int rc;
+
+    prepare_test(&g_state);
+    uut_setvbuf(uut_stdout, NULL, _IOLBF, 0);
+    rc = uut_printf("%s, ", "hello");
+    assert(rc == strlen("hello, "));
+    rc = uut_fprintf(uut_stdout, "%s%c", "world", '!');
+    assert(rc == strlen("world!"));
+    assert(g_state.write_calls == 0);
+    rc = uut_printf("\n");
+    assert(g_state.write_calls == 1);
+    assert(!strcmp(g_state.write_buf, "hello, world!\n"));
+
+    /* Unbuffered streams get a single write per call. */
+    prepare_test(&g_state);
+    rc = uut_fprintf(uut_stderr, "%d%s%5c", 42, "abc", 'x');
+    assert(rc == strlen("42abc    x"));
+    assert(g_state.write_calls == 1);
+    assert(!strcmp(g_state.write_buf, "42abc    x"));
 }
 
 int main(int argc, char **argv)
 {
     test_vfprintf_impl();
+    test_vfprintf_impl_length();
+    test_vfprintf_impl_coalescing();
+    test_vfprintf_impl_gather();
+    test_snprintf();
+    test_snprintf_float();
+    test_positional();
+    test_fprintf();
+    test_printf_compiled();
     return 0;
 }
@@ -440,6 +440,100 @@ static void test_parse_full_hex(void)
     assert(s.rc < 0);
 }
 
+static void test_parse_full_float(void)
+{
+    struct state s;
+    prepare_test(&s);
+
+    s.rc = convspec_parse(&s.cs, "%2$#+010.3le");
+    assert(s.rc == strlen("%2$#+010.3le"));
+    assert(s.cs.argno == 2);
+    assert(s.cs.flags == (CONVSPEC_HASH | CONVSPEC_PLUS | CONVSPEC_ZERO));
+    assert(s.cs.width == 10);
+    assert(s.cs.prec == 3);
+    assert(s.cs.len == CONVSPEC_LONG);
+    assert(s.cs.conv == 'e');
+
+    /* All floating-point specifiers are supported. */
+    s.rc = convspec_parse(&s.cs, "%a");
+    assert(s.rc == strlen("%a") && s.cs.conv == 'a');
+    s.rc = convspec_parse(&s.cs, "%A");
+    assert(s.rc == strlen("%A") && s.cs.conv == 'A');
+    s.rc = convspec_parse(&s.cs, "%E");
+    assert(s.rc == strlen("%E") && s.cs.conv == 'E');
+    s.rc = convspec_parse(&s.cs, "%f");
+    assert(s.rc == strlen("%f") && s.cs.conv == 'f');
+    s.rc = convspec_parse(&s.cs, "%F");
+    assert(s.rc == strlen("%F") && s.cs.conv == 'F');
+    s.rc = convspec_parse(&s.cs, "%g");
+    assert(s.rc == strlen("%g") && s.cs.conv == 'g');
+    s.rc = convspec_parse(&s.cs, "%G");
+    assert(s.rc == strlen("%G") && s.cs.conv == 'G');
+
+    /* ' ' and '+' are mutually exclusive, and so are '-' and '0'. */
+    s.rc = convspec_parse(&s.cs, "% +f");
+    assert(s.rc < 0);
+    s.rc = convspec_parse(&s.cs, "%-0f");
+    assert(s.rc < 0);
+    /* Only the 'l' length modifier is supported, and 'L' fails with
+     * ENOSYS. */
+    s.rc = convspec_parse(&s.cs, "%hf");
+    assert(s.rc < 0);
+    s.rc = convspec_parse(&s.cs, "%llf");
+    assert(s.rc < 0);
+    errno = 0;
+    s.rc = convspec_parse(&s.cs, "%Lf");
+    assert(s.rc < 0 && errno == ENOSYS);
+}
+
+/* Test parsing conversion specifiers for the scanf() family. */
+static void test_parse_scan(void)
+{
+    struct state s;
+    prepare_test(&s);
+
+    s.rc = convspec_parse_scan(&s.cs, "%3$*12llx");
+    assert(s.rc == strlen("%3$*12llx"));
+    assert(s.cs.argno == 3);
+    assert(s.cs.flags == CONVSPEC_STAR);
+    assert(s.cs.width == 12);
+    assert(s.cs.len == CONVSPEC_LONG_LONG);
+    assert(s.cs.conv == 'x');
+
+    /* Scansets are skipped as a whole, including leading brackets. */
+    s.rc = convspec_parse_scan(&s.cs, "%5[^]a-z]%d");
+    assert(s.rc == strlen("%5[^]a-z]"));
+    assert(s.cs.conv == '[');
+    assert(s.cs.set != NULL && !strncmp(s.cs.set, "^]a-z]", 6));
+    s.rc = convspec_parse_scan(&s.cs, "%[]");
+    assert(s.rc < 0);
+
+    /* Printing flags, precisions and zero widths are not accepted. */
+    s.rc = convspec_parse_scan(&s.cs, "%-d");
+    assert(s.rc < 0);
+    s.rc = convspec_parse_scan(&s.cs, "%.3f");
+    assert(s.rc < 0);
+    s.rc = convspec_parse_scan(&s.cs, "%0d");
+    assert(s.rc < 0);
+    s.rc = convspec_parse_scan(&s.cs, "%*n");
+    assert(s.rc < 0);
+    s.rc = convspec_parse_scan(&s.cs, "%hn");
+    assert(s.rc == strlen("%hn") && s.cs.conv == 'n');
+    /* Wide characters and long doubles are not supported. */
+    errno = 0;
+    s.rc = convspec_parse_scan(&s.cs, "%ls");
+    assert(s.rc < 0 && errno == ENOSYS);
+    errno = 0;
+    s.rc = convspec_parse_scan(&s.cs, "%lc");
+    assert(s.rc < 0 && errno == ENOSYS);
+    errno = 0;
+    s.rc = convspec_parse_scan(&s.cs, "%l[a-z]");
+    assert(s.rc < 0 && errno == ENOSYS);
+    errno = 0;
+    s.rc = convspec_parse_scan(&s.cs, "%Lg");
+    assert(s.rc < 0 && errno == ENOSYS);
+}
+
 int main(int argc, char **argv)
 {
     test_parse_no_spec();
@@ -455,6 +549,9 @@ int main(int argc, char **argv)
     test_parse_full_signed();
     test_parse_full_unsigned();
     test_parse_full_hex();
+    test_parse_full_float();
+
+    test_parse_scan();
 
     return 0;
 }
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../lib/libc/itoa.c"
+#include "../../lib/libc/printf_convspec.c"
+#include "../../lib/libc/printf_float.c"
+
+/* Formats a value with float_format() and NUL-terminates the result. */
+static void format(char *buf, size_t size, const char *fmt, double val)
+{
+    struct convspec cs;
+    struct float_fmt ff;
+    size_t len = 0;
+
+    assert(convspec_parse(&cs, fmt) == (int)strlen(fmt));
+    float_format(&ff, val, &cs);
+    assert(ff.prefix_len + ff.len < size);
+
+    memcpy(buf, ff.prefix, ff.prefix_len);
+    len += ff.prefix_len;
+    for (int i = 0; i < ff.nseg; i++) {
+        memcpy(buf + len, ff.seg[i].ptr, ff.seg[i].len);
+        len += ff.seg[i].len;
+        memset(buf + len, '0', ff.seg[i].zeros);
+        len += ff.seg[i].zeros;
+    }
+    buf[len] = '\0';
+    assert(len == ff.prefix_len + ff.len);
+}
+
+/* Compares the output of float_format() with that of the host. */
+static void check(const char *fmt, double val)
+{
+    static char buf[2048];
+    static char ref[2048];
+
+    format(buf, sizeof(buf), fmt, val);
+    snprintf(ref, sizeof(ref), fmt, val);
+    if (strcmp(buf, ref) != 0) {
+        fprintf(stderr, "%s of %a: got \"%s\", expected \"%s\"\n", fmt, val,
+            buf, ref);
+        abort();
+    }
+}
+
+static const char *const formats[] = {
+    "%e", "%.0e", "%.3e", "%.16e", "%.40e", "%#.0e", "%+E", "% .1e",
+    "%f", "%.0f", "%.3f", "%.20f", "%#.0f", "%F", "%+.1f",
+    "%g", "%.0g", "%.1g", "%.3g", "%.17g", "%.25g", "%.3G", "%G",
+    "%a", "%.0a", "%.1a", "%.3a", "%.20a", "%#.0a", "%A",
+};
+
+/* Test special values and simple cases. */
+static void test_float_format_simple(void)
+{
+    static const double vals[] = {
+        0.0, -0.0, 1.0, -1.0, 0.5, 1.5, 2.5, 0.125, 0.1, 0.2, 0.3, 1e-5,
+        123456.0, 1e15, 1e16, 1e17, 1e21, 1e22, 1e23, 9.5, 99.5, 999.5,
+        0.05, 0.15, 0.25, 0.35, 5e-324, DBL_MIN, DBL_MAX, DBL_EPSILON,
+        1.0 / 3.0, 2.0 / 3.0, 3.141592653589793, 2.718281828459045,
+        4503599627370496.5, 9007199254740993.0, 0x1.fffffffffffffp-1,
+        0x1.8p+0, 0x1.08p+0, 0x1.fp+0, INFINITY, -INFINITY, NAN, -NAN,
+    };
+    char buf[64];
+
+    for (size_t i = 0; i < sizeof(vals) / sizeof(*vals); i++) {
+        for (size_t j = 0; j < sizeof(formats) / sizeof(*formats); j++) {
+            check(formats[j], vals[i]);
+        }
+    }
+
+    format(buf, sizeof(buf), "%f", 0.1);
+    assert(!strcmp(buf, "0.100000"));
+    format(buf, sizeof(buf), "%.2e", 12345.0);
+    assert(!strcmp(buf, "1.23e+04"));
+    format(buf, sizeof(buf), "%g", 100000.0);
+    assert(!strcmp(buf, "100000"));
+    format(buf, sizeof(buf), "%g", 1000000.0);
+    assert(!strcmp(buf, "1e+06"));
+    format(buf, sizeof(buf), "%#g", 1.0);
+    assert(!strcmp(buf, "1.00000"));
+    format(buf, sizeof(buf), "%#.3g", 0.0001);
+    assert(!strcmp(buf, "0.000100"));
+    /* Some hosts get this one wrong, printing "1.e+03". */
+    format(buf, sizeof(buf), "%#.3g", 999.5);
+    assert(!strcmp(buf, "1.00e+03"));
+    format(buf, sizeof(buf), "%a", 1.0);
+    assert(!strcmp(buf, "0x1p+0"));
+    format(buf, sizeof(buf), "%.0f", 0.5);
+    assert(!strcmp(buf, "0"));
+    format(buf, sizeof(buf), "%.0f", 1.5);
+    assert(!strcmp(buf, "2"));
+}
+
+/* Test that large precisions do not need to be stored. */
+static void test_float_format_large(void)
+{
+    struct convspec cs;
+    struct float_fmt ff;
+
+    assert(convspec_parse(&cs, "%.100000f") > 0);
+    float_format(&ff, 1.0, &cs);
+    assert(ff.len == 100002);
+
+    assert(convspec_parse(&cs, "%.100000e") > 0);
+    float_format(&ff, DBL_MAX, &cs);
+    assert(ff.len == 100007);
+}
+
+/* Returns a random 64-bit value. */
+static uint64_t rand64(void)
+{
+    uint64_t val = 0;
+
+    for (int i = 0; i < 4; i++) {
+        val = (val << 16U) | (uint64_t)(rand() & 0xffff);
+    }
+    return val;
+}
+
+/* Test random bit patterns, which cover all exponents, and random short
+ * decimals, which are prone to ties. */
+static void test_float_format_random(void)
+{
+    union {
+        double d;
+        uint64_t u;
+    } bits;
+
+    srand(0x5eed);
+    for (int i = 0; i < 4000; i++) {
+        bits.u = rand64();
+        if (isnan(bits.d)) {
+            continue;
+        }
+        for (size_t j = 0; j < sizeof(formats) / sizeof(*formats); j++) {
+            check(formats[j], bits.d);
+        }
+    }
+    for (int i = 0; i < 4000; i++) {
+        int scale = rand() % 40 - 20;
+        double val = (double)(rand() % 100000);
+
+        for (; scale > 0; scale--) {
+            val *= 10;
+        }
+        for (; scale < 0; scale++) {
+            val /= 10;
+        }
+
+        for (size_t j = 0; j < sizeof(formats) / sizeof(*formats); j++) {
+            check(formats[j], val);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    test_float_format_simple();
+    test_float_format_large();
+    test_float_format_random();
+    return 0;
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NL_ARGMAX 32
+
+/* Rename the conversions so that the host ones can be used as a reference. */
+#define strtol uut_strtol
+#define strtoll uut_strtoll
+#define strtoul uut_strtoul
+#define strtoull uut_strtoull
+#define strtoimax uut_strtoimax
+#define strtoumax uut_strtoumax
+#define strtod uut_strtod
+#define strtof uut_strtof
+#define atof uut_atof
+#define sscanf uut_sscanf
+#define vsscanf uut_vsscanf
+#include "../../lib/libc/printf_convspec.c"
+#include "../../lib/libc/scanf.c"
+#include "../../lib/libc/strtod.c"
+#include "../../lib/libc/strtoint.c"
+#undef strtol
+#undef strtoll
+#undef strtoul
+#undef strtoull
+#undef strtoimax
+#undef strtoumax
+#undef strtod
+#undef strtof
+#undef atof
+#undef sscanf
+#undef vsscanf
+
+/* Test integer conversions. */
+static void test_sscanf_int(void)
+{
+    signed char hh;
+    short h;
+    int d, i, n;
+    unsigned u;
+    long l;
+    long long ll;
+    uintmax_t j;
+    size_t z;
+    void *p;
+
+    assert(uut_sscanf("  -42 +17\t0x1F 077 -1", "%d%i%x%o%u", &d, &i, &u, &n,
+               &u)
+        == 5);
+    assert(d == -42 && i == 17 && n == 077 && u == UINT_MAX);
+    assert(uut_sscanf("0x1F 0X2a 010 -0x10", "%x%X%i%i", &d, &i, &n, &u) == 4);
+    assert(d == 0x1f && i == 0x2a && n == 8 && u == (unsigned)-16);
+
+    /* Length modifiers select the type that is stored. */
+    assert(uut_sscanf("300 70000 -5 123456789012 18446744073709551615 77",
+               "%hhd %hd %ld %lld %ju %zu", &hh, &h, &l, &ll, &j, &z)
+        == 6);
+    assert(hh == (signed char)300 && h == (short)70000 && l == -5);
+    assert(ll == 123456789012LL && j == UINTMAX_MAX && z == 77);
+    assert(uut_sscanf("0xdeadbeef", "%p", &p) == 1);
+    assert(p == (void *)0xdeadbeef);
+
+    /* Widths bound the field, signs included. */
+    assert(uut_sscanf("-12345", "%3d%d", &d, &i) == 2);
+    assert(d == -12 && i == 345);
+    assert(uut_sscanf("123456789012345678901234", "%9d%9d%n", &d, &i, &n)
+        == 2);
+    assert(d == 123456789 && i == 12345678 && n == 18);
+
+    /* A prefix with no digits after it is not part of the field. */
+    assert(uut_sscanf("0xg", "%x%n", &u, &n) == 1);
+    assert(u == 0 && n == 1);
+    assert(uut_sscanf("-x", "%d", &d) == 0);
+}
+
+/* Test character, string and scanset conversions. */
+static void test_sscanf_str(void)
+{
+    char c[4] = "";
+    char s[16], t[16];
+    int n;
+
+    assert(uut_sscanf(" ab", "%c%2c", &c[0], &c[1]) == 2);
+    assert(!memcmp(c, " ab", 3));
+    assert(uut_sscanf("a", "%2c", c) == EOF);
+
+    assert(uut_sscanf("  hello world", "%s%n", s, &n) == 1);
+    assert(!strcmp(s, "hello") && n == 7);
+    assert(uut_sscanf("abcdefgh", "%3s%s", s, t) == 2);
+    assert(!strcmp(s, "abc") && !strcmp(t, "defgh"));
+
+    assert(uut_sscanf("key=value;", "%[a-z]=%[^;]", s, t) == 2);
+    assert(!strcmp(s, "key") && !strcmp(t, "value"));
+    assert(uut_sscanf("]]-a-", "%[]-]%s", s, t) == 2);
+    assert(!strcmp(s, "]]-") && !strcmp(t, "a-"));
+    assert(uut_sscanf("  x", "%[ ]%n", s, &n) == 1);
+    assert(!strcmp(s, "  ") && n == 2);
+    assert(uut_sscanf("x", "%[0-9]", s) == 0);
+    /* Characters listed twice, or covered by overlapping ranges, stay in
+     * the set. */
+    assert(uut_sscanf("aaa", "%[aa]", s) == 1);
+    assert(!strcmp(s, "aaa"));
+    assert(uut_sscanf("deadBEEF", "%[0-9a-fA-Fa-f]", s) == 1);
+    assert(!strcmp(s, "deadBEEF"));
+    assert(uut_sscanf("mnop", "%[a-pm-z]", s) == 1);
+    assert(!strcmp(s, "mnop"));
+    assert(uut_sscanf("hello", "%[^ll]", s) == 1);
+    assert(!strcmp(s, "he"));
+    assert(uut_sscanf("hello", "%[^a-lh]%s", s, t) == 0);
+}
+
+/* Test floating-point conversions. */
+static void test_sscanf_float(void)
+{
+    float f;
+    double d;
+    int n;
+
+    assert(uut_sscanf("1.5 -2.5e3", "%f%lf", &f, &d) == 2);
+    assert(f == 1.5f && d == -2500.0);
+    assert(uut_sscanf("0x1.8p1 inf", "%la%lg", &d, &d) == 2);
+    assert(d == HUGE_VAL);
+    assert(uut_sscanf("0.1", "%lf", &d) == 1 && d == 0.1);
+    assert(uut_sscanf("0.1", "%f", &f) == 1 && f == 0.1f);
+
+    /* Widths bound the field. */
+    assert(uut_sscanf("1.2345e10", "%4lf%n", &d, &n) == 1);
+    assert(d == 1.23 && n == 4);
+    assert(uut_sscanf("1e5", "%2lf%n", &d, &n) == 1);
+    assert(d == 1.0 && n == 1);
+    assert(uut_sscanf("-.e", "%lf", &d) == 0);
+}
+
+/* Test literals, whitespace, suppression, and failures. */
+static void test_sscanf_directives(void)
+{
+    int a = 0, b = 0, n = 0;
+    char s[16];
+
+    assert(uut_sscanf("root=/dev/vda1 ro", "root=%15s", s) == 1);
+    assert(!strcmp(s, "/dev/vda1"));
+    assert(uut_sscanf("10:20", "%d:%d", &a, &b) == 2);
+    assert(a == 10 && b == 20);
+    assert(uut_sscanf("10 : 20", "%d : %d", &a, &b) == 2);
+    assert(uut_sscanf("10 20", "%*d%d", &a) == 1 && a == 20);
+    assert(uut_sscanf("50%", "%d%%%n", &a, &n) == 1 && n == 3);
+
+    /* Matching failures stop the scan, and an early end of the input is
+     * only reported before the first conversion. */
+    assert(uut_sscanf("10-20", "%d:%d", &a, &b) == 1);
+    assert(uut_sscanf("10", "%d:%d", &a, &b) == 1);
+    assert(uut_sscanf("", "%d", &a) == EOF);
+    assert(uut_sscanf("   ", "%d", &a) == EOF);
+    assert(uut_sscanf("x", "%d", &a) == 0);
+
+    /* Numbered arguments. */
+    assert(uut_sscanf("1 2", "%2$d %1$d", &a, &b) == 2);
+    assert(a == 2 && b == 1);
+
+    /* Invalid formats. */
+    errno = 0;
+    assert(uut_sscanf("1 2", "%1$d %d", &a, &b) == EOF);
+    assert(errno == EINVAL);
+    errno = 0;
+    assert(uut_sscanf("1", "%y", &a) == EOF);
+    assert(errno == EINVAL);
+    errno = 0;
+    assert(uut_sscanf("1", "%Lf", &a) == EOF);
+    assert(errno == ENOSYS);
+}
+
+/* Tells whether a string contains a "0x" prefix with no hex digit after it.
+ * The host consumes the whole prefix in this case, whereas strtol() and this
+ * implementation only consume the "0". */
+static int has_bare_prefix(const char *s)
+{
+    for (; *s != '\0'; s++) {
+        if (s[0] == '0' && (s[1] == 'x' || s[1] == 'X')
+            && (s[2] == '\0'
+                || strchr("0123456789abcdefABCDEF", s[2]) == NULL)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Compares integer conversions of random strings with those of the host. */
+static void test_sscanf_random(void)
+{
+    static const char *const formats[] = { "%d%n", "%i%n", "%x%n", "%o%n",
+        "%u%n", "%3d%n", "%5i%n" };
+    static const char chars[] = "0123456789abcdefxX+- ";
+    char buf[16];
+    int val, ref, n, ref_n;
+
+    srand(0x5eed);
+    for (int i = 0; i < 100000; i++) {
+        const char *fmt = formats[rand() % 7];
+        int len = rand() % 8;
+        int rc, ref_rc;
+
+        for (int j = 0; j < len; j++) {
+            buf[j] = chars[rand() % (sizeof(chars) - 1)];
+        }
+        buf[len] = '\0';
+        if (has_bare_prefix(buf)) {
+            continue;
+        }
+        val = ref = n = ref_n = -1;
+        rc = uut_sscanf(buf, fmt, &val, &n);
+        ref_rc = sscanf(buf, fmt, &ref, &ref_n);
+        if (rc != ref_rc || val != ref || n != ref_n) {
+            fprintf(stderr, "sscanf(\"%s\", \"%s\"): got %d (%d, %d), "
+                "expected %d (%d, %d)\n", buf, fmt, rc, val, n, ref_rc, ref,
+                ref_n);
+            abort();
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    test_sscanf_int();
+    test_sscanf_str();
+    test_sscanf_float();
+    test_sscanf_directives();
+    test_sscanf_random();
+    return 0;
+}
@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define qsort uut_qsort
+#define bsearch uut_bsearch
+#include "../../lib/libc/sort.c"
+#undef qsort
+#undef bsearch
+
+#define N_MAX 5000
+
+/* Element sizes that take each swap path. */
+struct elem3 {
+    unsigned char b[3];
+};
+struct elem16 {
+    uint64_t key;
+    uint64_t tag;
+};
+struct elem24 {
+    uint64_t key;
+    uint64_t pad[2];
+};
+
+static size_t ncmp;
+
+static int cmp_u8(const void *a, const void *b)
+{
+    ncmp++;
+    return (int)*(const unsigned char *)a - (int)*(const unsigned char *)b;
+}
+
+/* Elements may be misaligned on purpose, so they are copied out. */
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x, y;
+    memcpy(&x, a, sizeof(x));
+    memcpy(&y, b, sizeof(y));
+    ncmp++;
+    return (x > y) - (x < y);
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x, y;
+    memcpy(&x, a, sizeof(x));
+    memcpy(&y, b, sizeof(y));
+    ncmp++;
+    return (x > y) - (x < y);
+}
+
+static int cmp_elem3(const void *a, const void *b)
+{
+    ncmp++;
+    return memcmp(a, b, sizeof(struct elem3));
+}
+
+/* Input patterns, including some that are known to trouble quicksorts. */
+enum pattern {
+    RANDOM,
+    FEW_VALUES,
+    SORTED,
+    REVERSED,
+    EQUAL,
+    ORGAN_PIPE,
+    SAWTOOTH,
+    PATTERNS,
+};
+
+static uint64_t pattern_value(enum pattern p, size_t i, size_t n)
+{
+    switch (p) {
+    case RANDOM:
+        return (uint64_t)rand() << 31U ^ (uint64_t)rand();
+    case FEW_VALUES:
+        return (uint64_t)rand() % 4;
+    case SORTED:
+        return i;
+    case REVERSED:
+        return n - i;
+    case EQUAL:
+        return 42;
+    case ORGAN_PIPE:
+        return i < n / 2 ? i : n - i;
+    case SAWTOOTH:
+        return i % 17;
+    default:
+        return 0;
+    }
+}
+
+/* Sorts an array with both implementations and compares the results. Keys
+ * are truncated to the element type, so equal keys mean equal elements. */
+static void check(enum pattern p, size_t n, size_t size, size_t off,
+    int (*cmp)(const void *, const void *))
+{
+    static unsigned char buf1[N_MAX * sizeof(struct elem24) + 8];
+    static unsigned char buf2[N_MAX * sizeof(struct elem24) + 8];
+    unsigned char *a = buf1 + off, *b = buf2 + off;
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t v = pattern_value(p, i, n);
+        memset(a + i * size, 0, size);
+        memcpy(a + i * size, &v, size < 8 ? size : 8);
+    }
+    memcpy(b, a, n * size);
+    ncmp = 0;
+    uut_qsort(a, n, size, cmp);
+    qsort(b, n, size, cmp);
+    assert(memcmp(a, b, n * size) == 0);
+}
+
+static void test_qsort(void)
+{
+    static const size_t lens[] = { 0, 1, 2, 3, 4, 5, 11, 12, 13, 100, 127,
+        128, 129, 1000, N_MAX };
+
+    srand(0x5027);
+    for (int p = 0; p < PATTERNS; p++) {
+        for (size_t i = 0; i < sizeof(lens) / sizeof(*lens); i++) {
+            size_t n = lens[i];
+            check(p, n, 1, 0, cmp_u8);
+            check(p, n, 3, 1, cmp_elem3);
+            check(p, n, 4, 0, cmp_u32);
+            check(p, n, 4, 2, cmp_u32);
+            check(p, n, 8, 0, cmp_u64);
+            check(p, n, 8, 4, cmp_u64);
+            check(p, n, 16, 0, cmp_u64);
+            check(p, n, 24, 0, cmp_u64);
+            check(p, n, 24, 1, cmp_u64);
+        }
+    }
+}
+
+/* McIlroy's adversary: it decides the order of the elements as the sort
+ * compares them, so that every pivot turns out to be nearly the smallest.
+ * Any plain quicksort takes quadratic time against it. */
+static uint32_t adv_val[N_MAX];
+static uint32_t adv_gas, adv_solid, adv_candidate;
+
+static int cmp_adversary(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+    ncmp++;
+    if (adv_val[x] == adv_gas && adv_val[y] == adv_gas) {
+        adv_val[x == adv_candidate ? x : y] = adv_solid++;
+    }
+    if (adv_val[x] == adv_gas) {
+        adv_candidate = x;
+    } else if (adv_val[y] == adv_gas) {
+        adv_candidate = y;
+    }
+    return (adv_val[x] > adv_val[y]) - (adv_val[x] < adv_val[y]);
+}
+
+static void test_adversary(void)
+{
+    static uint32_t a[N_MAX];
+    size_t n = N_MAX;
+
+    adv_gas = (uint32_t)n;
+    adv_solid = 0;
+    adv_candidate = 0;
+    for (size_t i = 0; i < n; i++) {
+        a[i] = (uint32_t)i;
+        adv_val[i] = adv_gas;
+    }
+    ncmp = 0;
+    uut_qsort(a, n, sizeof(*a), cmp_adversary);
+    for (size_t i = 1; i < n; i++) {
+        assert(adv_val[a[i - 1]] <= adv_val[a[i]]);
+    }
+    /* The heapsort fallback keeps it to O(n log n) comparisons. */
+    assert(ncmp < 64 * n);
+}
+
+static void test_bsearch(void)
+{
+    static uint64_t a[N_MAX];
+    uint64_t key;
+    uint64_t *found;
+
+    for (size_t n = 0; n <= 70; n++) {
+        for (size_t i = 0; i < n; i++) {
+            a[i] = 2 * i + 1;
+        }
+        for (key = 0; key <= 2 * n + 1; key++) {
+            found = uut_bsearch(&key, a, n, sizeof(*a), cmp_u64);
+            if (key % 2 == 1 && key < 2 * n) {
+                assert(found == &a[key / 2]);
+            } else {
+                assert(found == NULL);
+            }
+        }
+    }
+
+    /* Runs of equal elements: any of them may be returned. */
+    for (size_t i = 0; i < N_MAX; i++) {
+        a[i] = i / 7;
+    }
+    for (key = 0; key <= N_MAX / 7 + 1; key++) {
+        found = uut_bsearch(&key, a, N_MAX, sizeof(*a), cmp_u64);
+        if (key <= (N_MAX - 1) / 7) {
+            assert(found != NULL && *found == key);
+        } else {
+            assert(found == NULL);
+        }
+    }
+
+    /* Single-byte elements take the same path as any others. */
+    unsigned char bytes[256];
+    for (int i = 0; i < 256; i++) {
+        bytes[i] = (unsigned char)i;
+    }
+    for (int i = 0; i < 256; i++) {
+        unsigned char c = (unsigned char)i;
+        assert(uut_bsearch(&c, bytes, 256, 1, cmp_u8) == &bytes[i]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    test_qsort();
+    test_adversary();
+    test_bsearch();
+    return 0;
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Rename the stream API so that it does not clash with that of the host. */
+typedef struct _FILE uut_FILE;
+#define FILE uut_FILE
+#undef stdout
+#undef stderr
+#define stdout uut_stdout
+#define stderr uut_stderr
+#define setvbuf uut_setvbuf
+#define fflush uut_fflush
+#define fwrite uut_fwrite
+#define fputc uut_fputc
+#undef putc
+#define putc uut_putc
+#define fputs uut_fputs
+#define ferror uut_ferror
+#define clearerr uut_clearerr
+#define putchar uut_putchar
+#define puts uut_puts
+#include "../../lib/libc/stdio.c"
+#include "../../lib/libc/puts.c"
+
+/* Test state. */
+struct state {
+    size_t write_calls;
+    int write_fd;
+    char write_buf[8192];
+    size_t write_len;
+    /* Maximum number of bytes accepted by each write() call. */
+    size_t write_max;
+    /* Whether write() fails. */
+    int write_fail;
+} g_state;
+
+static void prepare_test(struct state *state)
+{
+    memset(state, 0, sizeof(*state));
+    state->write_max = SIZE_MAX;
+}
+
+ssize_t writev(int fd, const struct iovec *iov, int iovcnt)
+{
+    size_t count = 0;
+
+    g_state.write_calls++;
+    g_state.write_fd = fd;
+    if (g_state.write_fail) {
+        errno = EIO;
+        return -1;
+    }
+    for (int i = 0; i < iovcnt && count < g_state.write_max; i++) {
+        size_t len = iov[i].iov_len;
+
+        if (len > g_state.write_max - count) {
+            len = g_state.write_max - count;
+        }
+        memcpy(g_state.write_buf + g_state.write_len, iov[i].iov_base, len);
+        g_state.write_len += len;
+        count += len;
+    }
+    return (ssize_t)count;
+}
+
+/* Test that the standard output stream is line buffered. */
+static void test_line_buffered(void)
+{
+    prepare_test(&g_state);
+    assert(uut_fputs("hello", uut_stdout) == 0);
+    assert(uut_putchar(',') == ',');
+    assert(uut_putchar(' ') == ' ');
+    assert(g_state.write_calls == 0);
+    assert(uut_puts("world") == 0);
+    assert(g_state.write_calls == 1);
+    assert(g_state.write_fd == STDOUT_FILENO);
+    assert(g_state.write_len == strlen("hello, world\n"));
+    assert(!memcmp(g_state.write_buf, "hello, world\n", g_state.write_len));
+
+    /* A single write may span several lines. */
+    prepare_test(&g_state);
+    assert(uut_fwrite("a\nb\nc", 1, 5, uut_stdout) == 5);
+    assert(g_state.write_calls == 1);
+    assert(g_state.write_len == 5);
+    assert(uut_fflush(uut_stdout) == 0);
+    assert(g_state.write_calls == 1);
+}
+
+/* Test that the standard error stream is unbuffered. */
+static void test_unbuffered(void)
+{
+    prepare_test(&g_state);
+    assert(uut_fputc('x', uut_stderr) == 'x');
+    assert(g_state.write_calls == 1);
+    assert(g_state.write_fd == STDERR_FILENO);
+    assert(uut_fputs("yz", uut_stderr) == 0);
+    assert(g_state.write_calls == 2);
+    assert(!memcmp(g_state.write_buf, "xyz", 3));
+}
+
+/* Test full buffering with a user-supplied buffer. */
+static void test_fully_buffered(void)
+{
+    char buf[8];
+
+    prepare_test(&g_state);
+    assert(uut_setvbuf(uut_stdout, buf, _IOFBF, sizeof(buf)) == 0);
+    assert(uut_fputs("0123\n", uut_stdout) == 0);
+    assert(uut_putc('4', uut_stdout) == '4');
+    assert(g_state.write_calls == 0);
+    /* Overflowing the buffer writes it along with the new data. */
+    assert(uut_fputs("567", uut_stdout) == 0);
+    assert(g_state.write_calls == 1);
+    assert(g_state.write_len == 9);
+    assert(uut_stdout->buflen == 0);
+    /* Data larger than the buffer is written straight away. */
+    assert(uut_fwrite("0123456789", 2, 5, uut_stdout) == 5);
+    assert(g_state.write_calls == 2);
+    assert(g_state.write_len == 19);
+    assert(!memcmp(g_state.write_buf, "0123\n45670123456789", 19));
+    assert(uut_fflush(NULL) == 0);
+    assert(g_state.write_calls == 2);
+
+    /* Invalid modes are rejected. */
+    errno = 0;
+    assert(uut_setvbuf(uut_stdout, NULL, 42, 0) != 0);
+    assert(errno == EINVAL);
+    /* Switching back to the default buffer. */
+    assert(uut_setvbuf(uut_stdout, NULL, _IOLBF, 0) == 0);
+    assert(uut_stdout->buf == uut_stdout->defbuf);
+}
+
+/* Test that short writes are retried and that errors are reported. */
+static void test_errors(void)
+{
+    prepare_test(&g_state);
+    g_state.write_max = 2;
+    assert(uut_puts("hello") == 0);
+    assert(g_state.write_calls == 3);
+    assert(!memcmp(g_state.write_buf, "hello\n", 6));
+
+    prepare_test(&g_state);
+    g_state.write_fail = 1;
+    assert(uut_puts("hello") == EOF);
+    assert(uut_ferror(uut_stdout));
+    uut_clearerr(uut_stdout);
+    assert(!uut_ferror(uut_stdout));
+    /* Failed data is discarded. */
+    g_state.write_fail = 0;
+    assert(uut_fflush(uut_stdout) == 0);
+    assert(g_state.write_len == 0);
+
+    /* Element counts that overflow are rejected. */
+    errno = 0;
+    assert(uut_fwrite("x", SIZE_MAX, 2, uut_stdout) == 0);
+    assert(errno == EINVAL);
+}
+
+/* Test that vectors are written in as few calls as possible. */
+static void test_gather(void)
+{
+    struct iovec iov[STREAM_IOV_MAX * 2 + 1];
+    char expected[STREAM_IOV_MAX * 2 + 1];
+    char buf[4];
+
+    for (int i = 0; i < STREAM_IOV_MAX * 2 + 1; i++) {
+        expected[i] = (char)('a' + i % 26);
+        iov[i] = (struct iovec) { .iov_base = &expected[i], .iov_len = 1 };
+    }
+
+    prepare_test(&g_state);
+    assert(stream_writev(uut_stderr, iov, 3) == 3);
+    assert(g_state.write_calls == 1);
+    assert(!memcmp(g_state.write_buf, "abc", 3));
+
+    /* Buffered data is written in the same call. */
+    prepare_test(&g_state);
+    assert(uut_setvbuf(uut_stdout, buf, _IOFBF, sizeof(buf)) == 0);
+    assert(uut_fputs("xy", uut_stdout) == 0);
+    assert(stream_writev(uut_stdout, iov, 3) == 3);
+    assert(g_state.write_calls == 1);
+    assert(!memcmp(g_state.write_buf, "xyabc", 5));
+    assert(uut_setvbuf(uut_stdout, NULL, _IOLBF, 0) == 0);
+
+    /* Long vectors are split. */
+    prepare_test(&g_state);
+    assert(stream_writev(uut_stderr, iov, STREAM_IOV_MAX * 2 + 1)
+        == STREAM_IOV_MAX * 2 + 1);
+    assert(g_state.write_calls == 3);
+    assert(g_state.write_len == STREAM_IOV_MAX * 2 + 1);
+    assert(!memcmp(g_state.write_buf, expected, STREAM_IOV_MAX * 2 + 1));
+}
+
+int main(int argc, char **argv)
+{
+    test_line_buffered();
+    test_unbuffered();
+    test_fully_buffered();
+    test_errors();
+    test_gather();
+    return 0;
+}
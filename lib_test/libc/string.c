@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define strlen uut_strlen
+#define strnlen uut_strnlen
+#define strcmp uut_strcmp
+#define strchr uut_strchr
+#define strrchr uut_strrchr
+#define strspn uut_strspn
+#define strcspn uut_strcspn
+#define strcat uut_strcat
+#define strncat uut_strncat
+#define memchr uut_memchr
+#define memcpy uut_memcpy
+#define memmove uut_memmove
+#define memcmp uut_memcmp
+#define memset uut_memset
+#include "../../lib/libc/string.c"
+#undef strlen
+#undef strnlen
+#undef strcmp
+#undef strchr
+#undef strrchr
+#undef strspn
+#undef strcspn
+#undef strcat
+#undef strncat
+#undef memchr
+#undef memcpy
+#undef memmove
+#undef memcmp
+#undef memset
+
+static int sign(int v) { return (v > 0) - (v < 0); }
+
+/* Checks every function on a string that starts at the given pointer. */
+static void check_string(const char *str, size_t size)
+{
+    static const int chars[] = { 'a', 'z', '\0', 0x80, 0xff, 0x101 };
+    size_t len = strlen(str);
+
+    assert(uut_strlen(str) == len);
+    for (size_t n = 0; n <= len + 1 && n < size; n++) {
+        assert(uut_strnlen(str, n) == strnlen(str, n));
+    }
+    for (size_t i = 0; i < sizeof(chars) / sizeof(*chars); i++) {
+        assert(uut_strchr(str, chars[i]) == strchr(str, chars[i]));
+        assert(uut_strrchr(str, chars[i]) == strrchr(str, chars[i]));
+        for (size_t n = 0; n <= size; n++) {
+            assert(uut_memchr(str, chars[i], n) == memchr(str, chars[i], n));
+        }
+    }
+}
+
+/* Tests strings of every length and alignment, including strings that end
+ * right before an unmapped page. */
+static void test_boundaries(void)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    char *map = mmap(NULL, page * 2, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    char *guard = map + page;
+
+    assert(map != MAP_FAILED);
+    assert(mprotect(guard, page, PROT_NONE) == 0);
+    srand(0x57a7);
+    for (size_t len = 0; len < 40; len++) {
+        for (size_t off = 0; off < 8; off++) {
+            char *str = guard - len - 1 - off;
+            for (size_t i = 0; i < len; i++) {
+                str[i] = "az\x80\xff"[rand() % 4];
+            }
+            str[len] = '\0';
+            memset(str + len + 1, 'a', off);
+            check_string(str, len + 1 + off);
+        }
+    }
+    assert(munmap(map, page * 2) == 0);
+}
+
+/* Tests comparison of strings with every pair of alignments. */
+static void test_strcmp(void)
+{
+    char buf1[64], buf2[64];
+
+    assert(uut_strcmp("", "") == 0);
+    assert(uut_strcmp("a", "") > 0);
+    assert(uut_strcmp("", "a") < 0);
+    assert(uut_strcmp("\x80", "a") > 0);
+    srand(0xc3b);
+    for (size_t len = 0; len < 24; len++) {
+        for (size_t off1 = 0; off1 < 8; off1++) {
+            for (size_t off2 = 0; off2 < 8; off2++) {
+                char *s1 = buf1 + off1, *s2 = buf2 + off2;
+                for (size_t i = 0; i < len; i++) {
+                    s1[i] = s2[i] = (char)(1 + rand() % 255);
+                }
+                s1[len] = s2[len] = '\0';
+                assert(uut_strcmp(s1, s2) == 0);
+                if (len > 0) {
+                    size_t i = (size_t)rand() % len;
+                    s2[i] = (char)(s2[i] == '\x7f' ? '\x80' : s2[i] ^ 0x40);
+                    assert(sign(uut_strcmp(s1, s2)) == sign(strcmp(s1, s2)));
+                    s2[i] = s1[i];
+                    s2[len] = 'x';
+                    s2[len + 1] = '\0';
+                    assert(uut_strcmp(s1, s2) < 0);
+                    assert(uut_strcmp(s2, s1) > 0);
+                }
+            }
+        }
+    }
+}
+
+/* Tests that words with several matches report the first one. */
+static void test_first_match(void)
+{
+    char buf[32] __attribute__((aligned(8))) = "xxaxaxxx\x01\x02\x01xaa";
+
+    assert(uut_strchr(buf, 'a') == buf + 2);
+    assert(uut_strchr(buf + 3, 'a') == buf + 4);
+    assert(uut_strchr(buf, 1) == buf + 8);
+    assert(uut_strchr(buf + 9, 1) == buf + 10);
+    assert(uut_strrchr(buf, 'a') == buf + 13);
+    assert(uut_strchr(buf, 'b') == NULL);
+    assert(uut_memchr(buf, 'x', 0) == NULL);
+    assert(uut_memchr(buf + 8, 'a', 4) == NULL);
+    assert(uut_memchr(buf + 8, 'a', 5) == buf + 12);
+}
+
+/* Tests copies, comparisons and fills with every pair of alignments,
+ * including buffers that end right before an unmapped page. */
+static void test_mem(void)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    char *map = mmap(NULL, page * 2, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    char *guard = map + page;
+    unsigned char dst[256], ref[256];
+
+    assert(map != MAP_FAILED);
+    assert(mprotect(guard, page, PROT_NONE) == 0);
+    srand(0x3e3);
+    for (size_t i = 0; i < page; i++) {
+        map[i] = (char)rand();
+    }
+    for (size_t len = 0; len < 160; len++) {
+        for (size_t soff = 0; soff < 8; soff++) {
+            const char *src = guard - len - soff;
+            for (size_t doff = 0; doff < 8; doff++) {
+                memset(dst, 0x5a, sizeof(dst));
+                memset(ref, 0x5a, sizeof(ref));
+                memcpy(ref + doff, src, len);
+                assert(uut_memcpy(dst + doff, src, len) == dst + doff);
+                assert(memcmp(dst, ref, sizeof(dst)) == 0);
+
+                assert(uut_memcmp(dst + doff, src, len) == 0);
+                if (len > 0) {
+                    size_t i = doff + (size_t)rand() % len;
+                    dst[i] ^= 1U << (rand() % 8);
+                    assert(sign(uut_memcmp(dst + doff, src, len))
+                        == sign(memcmp(dst + doff, src, len)));
+                    assert(sign(uut_memcmp(src, dst + doff, len))
+                        == sign(memcmp(src, dst + doff, len)));
+                }
+
+                memset(ref + doff, (int)len, len);
+                assert(uut_memset(dst + doff, (int)len, len) == dst + doff);
+                assert(memcmp(dst, ref, sizeof(dst)) == 0);
+            }
+        }
+    }
+    assert(munmap(map, page * 2) == 0);
+}
+
+/* Tests overlapping moves in both directions. */
+static void test_memmove(void)
+{
+    unsigned char buf[256], ref[256];
+
+    for (size_t len = 0; len < 100; len++) {
+        for (size_t from = 0; from < 24; from++) {
+            for (size_t to = 0; to < 24; to++) {
+                for (size_t i = 0; i < sizeof(buf); i++) {
+                    buf[i] = ref[i] = (unsigned char)i;
+                }
+                memmove(ref + to, ref + from, len);
+                assert(uut_memmove(buf + to, buf + from, len) == buf + to);
+                assert(memcmp(buf, ref, sizeof(buf)) == 0);
+            }
+        }
+    }
+}
+
+/* Tests span functions, including bytes above 0x7f and empty sets. */
+static void test_span(void)
+{
+    static const char *const strs[] = { "", "abc", "  \t x", "\x80\xff\x01",
+        "key=value;rest", "aaaa" };
+    static const char *const sets[] = { "", "a", " \t", "\xff\x80", "=;",
+        "abcdefghijklmnopqrstuvwxyz" };
+
+    for (size_t i = 0; i < sizeof(strs) / sizeof(*strs); i++) {
+        for (size_t j = 0; j < sizeof(sets) / sizeof(*sets); j++) {
+            assert(uut_strspn(strs[i], sets[j]) == strspn(strs[i], sets[j]));
+            assert(
+                uut_strcspn(strs[i], sets[j]) == strcspn(strs[i], sets[j]));
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    test_span();
+    test_boundaries();
+    test_strcmp();
+    test_first_match();
+    test_mem();
+    test_memmove();
+    return 0;
+}
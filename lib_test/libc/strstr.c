@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define strlen uut_strlen
+#define strnlen uut_strnlen
+#define strcmp uut_strcmp
+#define strchr uut_strchr
+#define strrchr uut_strrchr
+#define strspn uut_strspn
+#define strcspn uut_strcspn
+#define strcat uut_strcat
+#define strncat uut_strncat
+#define strstr uut_strstr
+#define memchr uut_memchr
+#define memcpy uut_memcpy
+#define memmove uut_memmove
+#define memcmp uut_memcmp
+#define memmem uut_memmem
+#define memset uut_memset
+#include "../../lib/libc/string.c"
+#include "../../lib/libc/strstr.c"
+#undef strlen
+#undef strnlen
+#undef strcmp
+#undef strchr
+#undef strrchr
+#undef strspn
+#undef strcspn
+#undef strcat
+#undef strncat
+#undef strstr
+#undef memchr
+#undef memcpy
+#undef memmove
+#undef memcmp
+#undef memmem
+#undef memset
+
+/* Finds a needle by comparing it at every position. */
+static const char *ref_memmem(
+    const char *h, size_t hlen, const char *n, size_t nlen)
+{
+    for (size_t i = 0; i + nlen <= hlen; i++) {
+        if (memcmp(h + i, n, nlen) == 0) {
+            return h + i;
+        }
+    }
+    return NULL;
+}
+
+/* Tests random haystacks and needles over small alphabets, which produce
+ * many partial and periodic matches. Needles are taken from the haystack
+ * half of the time. */
+static void test_random(void)
+{
+    char hay[300], needle[80];
+
+    srand(0x2a7);
+    for (int iter = 0; iter < 200000; iter++) {
+        int alpha = 1 + rand() % 4;
+        size_t hlen = (size_t)rand() % 260;
+        size_t nlen = (size_t)rand() % (iter % 4 == 0 ? 80 : 20);
+        size_t off = (size_t)rand() % 8;
+        char *h = hay + off;
+
+        for (size_t i = 0; i < hlen; i++) {
+            h[i] = (char)('a' + rand() % alpha);
+        }
+        h[hlen] = '\0';
+        if (rand() % 2 && nlen <= hlen) {
+            memcpy(needle, h + (size_t)rand() % (hlen - nlen + 1), nlen);
+        } else {
+            for (size_t i = 0; i < nlen; i++) {
+                needle[i] = (char)('a' + rand() % alpha);
+            }
+        }
+        needle[nlen] = '\0';
+        assert(uut_memmem(h, hlen, needle, nlen)
+            == ref_memmem(h, hlen, needle, nlen));
+        assert(uut_strstr(h, needle) == strstr(h, needle));
+    }
+}
+
+/* Tests needles that end right before an unmapped page. */
+static void test_boundaries(void)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    char *map = mmap(NULL, page * 2, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    char *guard = map + page;
+
+    assert(map != MAP_FAILED);
+    assert(mprotect(guard, page, PROT_NONE) == 0);
+    memset(map, 'a', page);
+    for (size_t nlen = 1; nlen < 40; nlen++) {
+        for (size_t tail = 0; tail < 16; tail++) {
+            size_t hlen = nlen + 64 + tail;
+            char *h = guard - hlen;
+            char needle[40];
+            memset(needle, 'a', nlen);
+            needle[nlen - 1] = 'b';
+            h[hlen - 1 - tail] = 'b';
+            assert(uut_memmem(h, hlen, needle, nlen)
+                == h + hlen - tail - nlen);
+            h[hlen - 1 - tail] = 'a';
+            assert(uut_memmem(h, hlen, needle, nlen) == NULL);
+        }
+    }
+    assert(munmap(map, page * 2) == 0);
+}
+
+/* Tests a needle whose naive search would be quadratic. */
+static void test_worst_case(void)
+{
+    size_t hlen = 1 << 20, nlen = 1 << 10;
+    char *h = malloc(hlen + 1);
+    char *n = malloc(nlen + 1);
+
+    memset(h, 'a', hlen);
+    h[hlen] = '\0';
+    memset(n, 'a', nlen);
+    n[0] = 'b';
+    n[nlen] = '\0';
+    assert(uut_strstr(h, n) == NULL);
+    n[0] = 'a';
+    n[nlen - 1] = 'b';
+    assert(uut_memmem(h, hlen, n, nlen) == NULL);
+    h[hlen - 1] = 'b';
+    assert(uut_memmem(h, hlen, n, nlen) == h + hlen - nlen);
+    free(h);
+    free(n);
+}
+
+static void test_strstr(void)
+{
+    const char *s = "console=ttyS0 root=/dev/vda1 ro";
+
+    assert(uut_strstr(s, "") == s);
+    assert(uut_strstr(s, "root=") == s + 14);
+    assert(uut_strstr(s, " ro ") == NULL);
+    assert(uut_strstr(s, "1 ro") == s + 27);
+    assert(uut_strstr(s, "rw") == NULL);
+    assert(uut_strstr("", "a") == NULL);
+    assert(uut_strstr("ab", "abc") == NULL);
+    assert(uut_memmem(s, 3, "ons", 3) == NULL);
+    assert(uut_memmem(s, 4, "ons", 3) == s + 1);
+    assert(uut_memmem("a\0b\0c", 5, "b\0c", 3) != NULL);
+}
+
+int main(int argc, char **argv)
+{
+    test_strstr();
+    test_random();
+    test_boundaries();
+    test_worst_case();
+    return 0;
+}
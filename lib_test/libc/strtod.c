@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Rename the conversions so that the host ones can be used as a reference. */
+#define strtol uut_strtol
+#define strtoll uut_strtoll
+#define strtoul uut_strtoul
+#define strtoull uut_strtoull
+#define strtoimax uut_strtoimax
+#define strtoumax uut_strtoumax
+#define strtod uut_strtod
+#define strtof uut_strtof
+#define atof uut_atof
+#include "../../lib/libc/strtod.c"
+#include "../../lib/libc/strtoint.c"
+#undef strtol
+#undef strtoll
+#undef strtoul
+#undef strtoull
+#undef strtoimax
+#undef strtoumax
+#undef strtod
+#undef strtof
+#undef atof
+
+static uint64_t dbits(double val)
+{
+    uint64_t u;
+
+    memcpy(&u, &val, sizeof(u));
+    return u;
+}
+
+static uint32_t fbits(float val)
+{
+    uint32_t u;
+
+    memcpy(&u, &val, sizeof(u));
+    return u;
+}
+
+/* Compares the conversions of a string with those of the host. */
+static void check(const char *str)
+{
+    char *end, *ref_end;
+    double d = uut_strtod(str, &end);
+    double ref = strtod(str, &ref_end);
+    float f;
+    float ref_f;
+
+    if (dbits(d) != dbits(ref) || end != ref_end) {
+        fprintf(stderr, "strtod(\"%s\"): got %a (+%td), expected %a (+%td)\n",
+            str, d, end - str, ref, ref_end - str);
+        abort();
+    }
+    f = uut_strtof(str, &end);
+    ref_f = strtof(str, &ref_end);
+    if (fbits(f) != fbits(ref_f) || end != ref_end) {
+        fprintf(stderr, "strtof(\"%s\"): got %a (+%td), expected %a (+%td)\n",
+            str, f, end - str, ref_f, ref_end - str);
+        abort();
+    }
+}
+
+/* Test syntax, special values and errors. */
+static void test_strtod_syntax(void)
+{
+    static const char *const strs[] = {
+        "0", "-0", "+0.0", "  \t1", "1.", ".5", "-.5e1", "1e", "1e+", "1e-x",
+        "1.5E3", "0x", "0x.", "0x1", "0X1.8p1", "0x.8P-1", "0x1p", "0x1p-",
+        "-0x1.fffffffffffffp1023", "0x1.fffffffffffff8p1023",
+        "0x1.00000000000008p0", "0x1.000000000000081p0", "0x0.00000000000008p0",
+        "0x1p-1074", "0x1p-1075", "0x1.0000000000001p-1075", "0x3p-1076",
+        "0x123456789abcdef0123p-8", "inf", "-INF", "Infinity", "infinit",
+        "nan", "-NaN", "nan()", "nan(0x1_f)", "nan(", "nan(x y)", "in", "na",
+        "1e99999999999", "1e-99999999999", "0e99999999999",
+        "1234567890123456789012345678901234567890e-40",
+        "0.000000000000000000000000000000000000000000000000001e51",
+    };
+
+    for (size_t i = 0; i < sizeof(strs) / sizeof(*strs); i++) {
+        check(strs[i]);
+    }
+}
+
+/* Test values that are hard to round correctly. */
+static void test_strtod_hard(void)
+{
+    static const char *const strs[] = {
+        "0.1", "0.3", "1e23", "8.98846567431158e307", "9007199254740993",
+        "9007199254740993.0000000000000000001", "9007199254740995",
+        "2.2250738585072011e-308", "2.2250738585072012e-308",
+        "2.2250738585072014e-308", "4.9406564584124654e-324",
+        "2.4703282292062327e-324", "2.4703282292062328e-324",
+        "1.7976931348623157e308", "1.7976931348623158e308",
+        "1.7976931348623159e308", "3.4028235e38", "3.4028236e38",
+        "1.4e-45", "7e-46", "7.006492321624085e-46", "1.17549435e-38",
+        /* Exactly halfway between 1 and the next double. */
+        "1.00000000000000011102230246251565404236316680908203125",
+        "1.000000000000000111022302462515654042363166809082031250000001",
+        "1.00000000000000011102230246251565404236316680908203124999999",
+        /* Exactly halfway between 1 and the next float. */
+        "1.000000059604644775390625", "1.0000000596046447753906250001",
+        "1.0000000596046447753906249999",
+    };
+    static char buf[2048];
+    size_t n;
+
+    for (size_t i = 0; i < sizeof(strs) / sizeof(*strs); i++) {
+        check(strs[i]);
+    }
+
+    /* A halfway case whose tie is only broken after many digits. */
+    strcpy(buf, "1.00000000000000011102230246251565404236316680908203125");
+    n = strlen(buf);
+    memset(buf + n, '0', 1000);
+    buf[n + 1000] = '\0';
+    check(buf);
+    strcpy(buf + strlen(buf), "1");
+    check(buf);
+    strcpy(buf + strlen(buf), "e-2");
+    check(buf);
+
+    /* The smallest subnormal, written out in full, and just below half of
+     * it. */
+    snprintf(buf, sizeof(buf), "%.1100f", 4.9406564584124654e-324);
+    check(buf);
+    snprintf(buf, sizeof(buf), "%.1100f", 4.9406564584124654e-324 / 2);
+    check(buf);
+}
+
+/* Test that range errors are reported. */
+static void test_strtod_errors(void)
+{
+    char *end;
+    const char *str;
+
+    errno = 0;
+    assert(uut_strtod("1e400", NULL) == HUGE_VAL);
+    assert(errno == ERANGE);
+    errno = 0;
+    assert(uut_strtod("-1e-400", NULL) == 0.0);
+    assert(errno == ERANGE);
+    errno = 0;
+    assert(uut_strtof("1e39", NULL) == HUGE_VALF);
+    assert(errno == ERANGE);
+    errno = 0;
+    assert(uut_strtod("0e400", NULL) == 0.0);
+    assert(uut_strtod("inf", NULL) == HUGE_VAL);
+    assert(uut_atof("1.25") == 1.25);
+    assert(errno == 0);
+
+    str = " +x";
+    assert(uut_strtod(str, &end) == 0.0);
+    assert(end == str);
+    assert(errno == EINVAL);
+}
+
+/* Returns a random 64-bit value. */
+static uint64_t rand64(void)
+{
+    uint64_t val = 0;
+
+    for (int i = 0; i < 4; i++) {
+        val = (val << 16U) | (uint64_t)(rand() & 0xffff);
+    }
+    return val;
+}
+
+/* Test random bit patterns printed in several ways, and random decimals. */
+static void test_strtod_random(void)
+{
+    static const char *const formats[] = { "%.17g", "%.16g", "%.6e", "%.25e",
+        "%a", "%.3a" };
+    char buf[128];
+    double val;
+
+    srand(0x5eed);
+    for (int i = 0; i < 20000; i++) {
+        uint64_t u = rand64();
+
+        memcpy(&val, &u, sizeof(val));
+        if (isnan(val)) {
+            continue;
+        }
+        for (size_t j = 0; j < sizeof(formats) / sizeof(*formats); j++) {
+            snprintf(buf, sizeof(buf), formats[j], val);
+            check(buf);
+        }
+        snprintf(buf, sizeof(buf), "%.9g", (double)(float)val);
+        check(buf);
+    }
+    for (int i = 0; i < 20000; i++) {
+        int ndigits = rand() % 30 + 1;
+        int n = 0;
+
+        for (int j = 0; j < ndigits; j++) {
+            buf[n++] = (char)('0' + rand() % 10);
+            if (j == 0) {
+                buf[n++] = '.';
+            }
+        }
+        snprintf(buf + n, sizeof(buf) - n, "e%d", rand() % 700 - 350);
+        check(buf);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    test_strtod_syntax();
+    test_strtod_hard();
+    test_strtod_errors();
+    test_strtod_random();
+    return 0;
+}
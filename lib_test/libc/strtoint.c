@@ -105,6 +105,27 @@ static void test_strtol(void)
     assert(rc == LONG_MIN);
     assert(!strcmp(endptr, "21234"));
     assert(errno == ERANGE);
+
+    /* Test exact bounds. */
+    errno = 0;
+    input = "-9223372036854775808";
+    rc = strtol(input, &endptr, 10);
+    assert(rc == LONG_MIN);
+    assert(errno == 0);
+    assert(!strcmp(endptr, ""));
+    input = "9223372036854775808";
+    rc = strtol(input, &endptr, 10);
+    assert(rc == LONG_MAX);
+    assert(errno == ERANGE);
+    assert(!strcmp(endptr, "8"));
+
+    /* Test upper case digits, and characters between 'Z' and 'a'. */
+    errno = 0;
+    input = "Zz[";
+    rc = strtol(input, &endptr, 36);
+    assert(rc == 35 * 36 + 35);
+    assert(errno == 0);
+    assert(!strcmp(endptr, "["));
 }
 
 static void test_strtoul(void)
@@ -120,11 +141,66 @@ static void test_strtoul(void)
     assert(rc == 0);
     assert(errno == EINVAL);
     assert(!strcmp(endptr, "-1"));
+
+    /* Test exact bounds. */
+    errno = 0;
+    input = "18446744073709551615";
+    rc = strtoul(input, &endptr, 10);
+    assert(rc == ULONG_MAX);
+    assert(errno == 0);
+    input = "0x1ffffffffffffffff";
+    rc = strtoul(input, &endptr, 0);
+    assert(rc == ULONG_MAX);
+    assert(errno == ERANGE);
+    assert(!strcmp(endptr, "f"));
+}
+
+/* Test long runs of digits at every alignment. */
+static void test_strtoumax_words(void)
+{
+    static const struct {
+        const char *input;
+        int base;
+        uintmax_t val;
+        const char *end;
+    } cases[] = {
+        { "12345678901234567890", 10, 12345678901234567890ULL, "" },
+        { "00000000000000000000000042 ", 10, 42, " " },
+        { "1234567x90123456", 10, 1234567, "x90123456" },
+        { "18446744073709551616", 10, UINTMAX_MAX, "6" },
+        { "0123456789aBcDeF:", 16, 0x0123456789abcdefULL, ":" },
+        { "FEDCBA9876543210", 16, 0xfedcba9876543210ULL, "" },
+        { "fedcba98g6543210", 16, 0xfedcba98, "g6543210" },
+        { "ffffffffffffffff0", 16, UINTMAX_MAX, "0" },
+        /* Control bytes that only differ from digits in the case bit. */
+        { "\x11\x12\x13\x14\x15\x16\x17\x18", 16, 0,
+            "\x11\x12\x13\x14\x15\x16\x17\x18" },
+        { "1234567\x11", 16, 0x1234567, "\x11" },
+        { "abcdef0\x10" "abcdef01", 16, 0xabcdef0, "\x10" "abcdef01" },
+        { "1234567\x19", 16, 0x1234567, "\x19" },
+        { "\x19" "1234567", 16, 0, "\x19" "1234567" },
+        { "0123456789\x19", 16, 0x0123456789ULL, "\x19" },
+    };
+    char buf[64];
+    char *endptr;
+    uintmax_t rc;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(*cases); i++) {
+        for (size_t off = 0; off < 8; off++) {
+            strcpy(buf + off, cases[i].input);
+            errno = 0;
+            rc = strtoumax(buf + off, &endptr, cases[i].base);
+            assert(rc == cases[i].val);
+            assert(!strcmp(endptr, cases[i].end));
+            assert(errno == (rc == UINTMAX_MAX ? ERANGE : 0));
+        }
+    }
 }
 
 int main(int argc, char **argv)
 {
     test_strtol();
     test_strtoul();
+    test_strtoumax_words();
     return 0;
 }
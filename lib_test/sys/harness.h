@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#define _DEFAULT_SOURCE
+
+#include <assert.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/* The host's <sys/param.h> comes first in the search path, so ours is
+ * included by name for its PAGE_SIZE. */
+#include "../../include/sys/param.h"
+#include <sys/page.h>
+
+/* Alignment of the memory handed to the page allocator, so that block
+ * boundaries do not depend on where it is mapped. */
+#define MEM_ALIGN (PAGE_SIZE << PAGE_MAX_ORDER)
+
+static jmp_buf panic_env;
+static int panic_expected;
+
+void panic(const char *fmt, ...)
+{
+    assert(panic_expected);
+    longjmp(panic_env, 1);
+}
+
+/* Checks that a statement panics. The panic may leave the page allocator
+ * lock held, so it is released afterwards. */
+#define assert_panics(stmt)                                                  \
+    do {                                                                     \
+        panic_expected = 1;                                                  \
+        if (setjmp(panic_env) == 0) {                                        \
+            stmt;                                                            \
+            assert(!"no panic");                                             \
+        }                                                                    \
+        panic_expected = 0;                                                  \
+        spin_unlock(&page_lock);                                             \
+    } while (0)
+
+/**
+ * @brief      Maps memory for the page allocator.
+ *
+ * @param[in]  size  The number of bytes to map.
+ *
+ * @return     The start of the memory, aligned to MEM_ALIGN.
+ */
+static uintptr_t map_mem(size_t size)
+{
+    char *raw = mmap(NULL, size + MEM_ALIGN, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    assert(raw != MAP_FAILED);
+    return ((uintptr_t)raw + MEM_ALIGN - 1) & ~(MEM_ALIGN - 1);
+}
+
+static void shuffle(void **ptrs, size_t n)
+{
+    for (size_t i = n; i > 1; i--) {
+        size_t j = (size_t)rand() % i;
+        void *t = ptrs[i - 1];
+        ptrs[i - 1] = ptrs[j];
+        ptrs[j] = t;
+    }
+}
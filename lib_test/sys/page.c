@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "harness.h"
+#include "../../sys/page.c"
+
+/* Size of the memory handed to the allocator. */
+#define MEM_SIZE (16UL << 20U)
+#define N_PAGES (MEM_SIZE / PAGE_SIZE)
+
+static uintptr_t mem;
+
+/* Checks the free lists and obtains the number of free blocks in them. */
+static size_t check_lists(void)
+{
+    size_t blocks = 0, count = 0;
+
+    for (unsigned o = 0; o <= PAGE_MAX_ORDER; o++) {
+        uint32_t prev = PAGE_NONE;
+        for (uint32_t i = free_lists[o]; i != PAGE_NONE;
+             i = pages[i].u.link.next) {
+            assert(i % (1U << o) == 0 && i + (1U << o) <= page_count);
+            assert(pages[i].state == PAGE_FREE && pages[i].order == o);
+            assert(pages[i].u.link.prev == prev);
+            prev = i;
+            blocks++;
+            count += 1U << o;
+        }
+    }
+    assert(count == free_count);
+    return blocks;
+}
+
+/* Sets up the allocator for all of the memory, with the caches off. */
+static void setup(void)
+{
+    page_init(mem, mem + MEM_SIZE);
+    page_add(mem, mem + MEM_SIZE);
+    page_cache_tune(0, 0);
+    memset(page_caches, 0, sizeof(page_caches));
+}
+
+/* Allocates every single page, and checks that none is handed out twice or
+ * lies in [hole, hole_end). */
+static size_t alloc_all(void **ptrs, uintptr_t hole, uintptr_t hole_end)
+{
+    size_t n = 0;
+    void *p;
+
+    while ((p = page_alloc(0)) != NULL) {
+        assert((uintptr_t)p % PAGE_SIZE == 0);
+        assert((uintptr_t)p >= page_first && (uintptr_t)p < mem + MEM_SIZE);
+        assert((uintptr_t)p < hole || (uintptr_t)p >= hole_end);
+        *(size_t *)p = n;
+        ptrs[n++] = p;
+    }
+    for (size_t i = 0; i < n; i++) {
+        assert(*(size_t *)ptrs[i] == i);
+    }
+    return n;
+}
+
+/* Test the metadata and the initial blocks. */
+static void test_init(void)
+{
+    page_init(mem + 12345, mem + MEM_SIZE - 100);
+    assert(page_free_count() == 0);
+    page_add(mem, mem + MEM_SIZE);
+    assert(page_first > mem + 12345 && page_first % PAGE_SIZE == 0);
+    assert(page_first >= mem + 12345 + page_count * sizeof(struct page));
+    assert(page_free_count()
+        == (mem + MEM_SIZE - PAGE_SIZE - page_first) / PAGE_SIZE);
+    check_lists();
+}
+
+/* Test splitting blocks on allocation and merging them back on free. */
+static void test_split_merge(void)
+{
+    static void *ptrs[N_PAGES];
+    size_t blocks, total, n;
+    void *p;
+
+    setup();
+    blocks = check_lists();
+    total = page_free_count();
+    p = page_alloc(0);
+    assert(p != NULL && page_free_count() == total - 1);
+    assert(check_lists() > blocks);
+    page_free(p, 0);
+    assert(page_free_count() == total && check_lists() == blocks);
+
+    n = alloc_all(ptrs, 0, 0);
+    assert(n == total && page_free_count() == 0 && check_lists() == 0);
+    shuffle(ptrs, n);
+    for (size_t i = 0; i < n; i++) {
+        page_free(ptrs[i], 0);
+    }
+    assert(page_free_count() == total && check_lists() == blocks);
+}
+
+/* Test that pages outside of the ranges given to page_add() are left alone.
+ */
+static void test_reserved(void)
+{
+    static void *ptrs[N_PAGES];
+    uintptr_t hole = mem + (5UL << 20U), hole_end = mem + (6UL << 20U);
+    size_t n;
+
+    page_init(mem, mem + MEM_SIZE);
+    page_cache_tune(0, 0);
+    /* Partial pages at either side of the hole are left out too. */
+    page_add(mem, hole + 100);
+    page_add(hole_end - 1, mem + MEM_SIZE);
+    n = alloc_all(ptrs, hole, hole_end);
+    assert(n == (hole - page_first + mem + MEM_SIZE - hole_end) / PAGE_SIZE);
+    for (size_t i = 0; i < n; i++) {
+        page_free(ptrs[i], 0);
+    }
+    check_lists();
+    /* Ranges outside of the one given to page_init() are ignored. */
+    page_add(mem + MEM_SIZE, mem + 2 * MEM_SIZE);
+    page_add(mem - MEM_SIZE, mem);
+    assert(page_free_count() == n);
+}
+
+/* Test blocks of every order. */
+static void test_orders(void)
+{
+    static void *ptrs[N_PAGES];
+    size_t total, n = 0;
+    void *p;
+
+    setup();
+    total = page_free_count();
+    for (unsigned o = 0; o <= PAGE_MAX_ORDER; o++) {
+        p = page_alloc(o);
+        assert(p != NULL && (uintptr_t)p % (PAGE_SIZE << o) == 0);
+        assert(page_free_count() == total - (1U << o));
+        memset(p, (int)o, PAGE_SIZE << o);
+        page_free(p, o);
+        assert(page_free_count() == total);
+    }
+    assert(page_alloc(PAGE_MAX_ORDER + 1) == NULL);
+    /* Blocks of order 3 do not overlap, since they are aligned. */
+    while ((p = page_alloc(3)) != NULL) {
+        assert((uintptr_t)p % (PAGE_SIZE << 3) == 0);
+        *(size_t *)p = n;
+        ptrs[n++] = p;
+    }
+    assert(page_free_count() < 8);
+    for (size_t i = 0; i < n; i++) {
+        assert(*(size_t *)ptrs[i] == i);
+        page_free(ptrs[i], 3);
+    }
+    assert(page_free_count() == total);
+    check_lists();
+}
+
+/* Test splitting an allocated block into single pages. */
+static void test_split(void)
+{
+    size_t blocks, total;
+    char *p;
+
+    setup();
+    blocks = check_lists();
+    total = page_free_count();
+    p = page_alloc(2);
+    page_split(p, 2);
+    assert_panics(page_free(p, 2));
+    page_free(p + 3 * PAGE_SIZE, 0);
+    page_free(p + PAGE_SIZE, 0);
+    page_free(p, 0);
+    page_free(p + 2 * PAGE_SIZE, 0);
+    assert(page_free_count() == total && check_lists() == blocks);
+}
+
+/* Test that frees of blocks that are not allocated panic. */
+static void test_bad_free(void)
+{
+    size_t blocks, total;
+    char *a, *b, *p;
+
+    setup();
+    blocks = check_lists();
+    total = page_free_count();
+    /* Buddies, so that freeing both merges them. */
+    a = page_alloc(0);
+    b = page_alloc(0);
+    assert(((uintptr_t)a ^ (uintptr_t)b) == PAGE_SIZE);
+    page_free(a, 0);
+    assert_panics(page_free(a, 0));
+    page_free(b, 0);
+    assert_panics(page_free(b, 0));
+    assert_panics(page_free(a, 0));
+    assert(page_free_count() == total && check_lists() == blocks);
+
+    p = page_alloc(2);
+    assert_panics(page_free(p + PAGE_SIZE, 0));
+    assert_panics(page_free(p, 1));
+    assert_panics(page_free(p + 1, 2));
+    assert_panics(page_free((void *)(mem - MEM_SIZE), 0));
+    page_free(p, 2);
+    assert(page_free_count() == total && check_lists() == blocks);
+}
+
+/* Checks the counters of the caches. */
+static void check_stats(size_t alloc_hits, size_t alloc_misses,
+    size_t free_hits, size_t free_misses)
+{
+    struct page_cache_stats stats;
+
+    page_cache_stats(&stats);
+    assert(stats.alloc_hits == alloc_hits);
+    assert(stats.alloc_misses == alloc_misses);
+    assert(stats.free_hits == free_hits);
+    assert(stats.free_misses == free_misses);
+}
+
+/* Test the cache of single pages of the current hart. */
+static void test_cache(void)
+{
+    struct page_cache *c = &page_caches[hart_id()];
+    void *ptrs[20];
+    size_t total;
+
+    setup();
+    total = page_free_count();
+    page_cache_tune(8, 16);
+    /* Each miss refills the cache with 8 pages at once. */
+    for (size_t i = 0; i < 20; i++) {
+        ptrs[i] = page_alloc(0);
+        assert(ptrs[i] != NULL);
+    }
+    check_stats(17, 3, 0, 0);
+    assert(c->count == 4);
+    assert(free_count == total - 24 && page_free_count() == total - 20);
+    check_lists();
+    /* Freeing into a full cache drains it down to 8 pages first. */
+    for (size_t i = 0; i < 20; i++) {
+        page_free(ptrs[i], 0);
+    }
+    check_stats(17, 3, 19, 1);
+    assert(c->count == 16);
+    assert(free_count == total - 16 && page_free_count() == total);
+    check_lists();
+    /* Cached pages are handed out before any other. */
+    assert(page_alloc(0) == ptrs[19]);
+    page_free(ptrs[19], 0);
+    check_stats(18, 3, 20, 1);
+    /* Blocks of other orders bypass the cache. */
+    page_free(page_alloc(1), 1);
+    check_stats(18, 3, 20, 1);
+    assert(c->count == 16 && page_free_count() == total);
+
+    /* A low watermark of 0 still refills a single page at a time. */
+    page_cache_tune(0, 4);
+    assert(cache_high == 4 && cache_low == 0);
+    c->count = 0;
+    page_init(mem, mem + MEM_SIZE);
+    page_add(mem, mem + MEM_SIZE);
+    ptrs[0] = page_alloc(0);
+    assert(c->count == 0 && free_count == total - 1);
+    page_free(ptrs[0], 0);
+    assert(c->count == 1 && page_free_count() == total);
+
+    /* The watermarks are clamped to the capacity, and low to below high. */
+    page_cache_tune(1000, 1000);
+    assert(cache_high == PAGE_CACHE_MAX && cache_low == PAGE_CACHE_MAX - 1);
+    page_cache_tune(10, 5);
+    assert(cache_high == 5 && cache_low == 4);
+    /* A high watermark of 0 turns the caches off. */
+    page_cache_tune(PAGE_CACHE_LOW, 0);
+    assert(cache_low == 0);
+    page_free(page_alloc(0), 0);
+    assert(c->count == 1);
+}
+
+int main(int argc, char **argv)
+{
+    mem = map_mem(MEM_SIZE);
+    srand(0x22);
+    test_init();
+    test_split_merge();
+    test_reserved();
+    test_orders();
+    test_split();
+    test_bad_free();
+    test_cache();
+    return 0;
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "harness.h"
+#include "../../sys/page.c"
+#include "../../sys/slab.c"
+
+#define MEM_SIZE (32UL << 20U)
+#define N_OBJS 4096
+
+/* Object of a cache with a constructor. */
+struct obj {
+    uint64_t magic;
+    void *self;
+    char data[40];
+};
+
+#define OBJ_MAGIC 0x6f626a6563747321ULL
+
+static size_t ctor_runs;
+
+static void obj_ctor(void *p)
+{
+    struct obj *o = p;
+
+    /* Objects are constructed once, on memory that held none before. */
+    assert(o->magic != OBJ_MAGIC || o->self != o);
+    o->magic = OBJ_MAGIC;
+    o->self = o;
+    ctor_runs++;
+}
+
+/* Gives the objects in the magazine of the current hart back to their
+ * slabs, so that the slabs tell how many objects are in use. */
+static void drain_magazine(struct kmem_cache *cache)
+{
+    struct kmem_magazine *mag = this_magazine(cache);
+
+    spin_lock(&cache->lock);
+    while (mag->count > 0) {
+        slab_put(cache, mag->objs[--mag->count]);
+    }
+    spin_unlock(&cache->lock);
+}
+
+/* Test the size classes at every boundary. */
+static void test_kmalloc_index(void)
+{
+    size_t prev = 0;
+
+    assert(kmalloc_classes[KMALLOC_CLASSES - 1].size
+        == KMALLOC_MAX_CACHE_SIZE);
+    for (unsigned i = 0; i < KMALLOC_CLASSES; i++) {
+        size_t size = kmalloc_classes[i].size;
+        assert(size > prev && size % KMALLOC_ALIGN == 0);
+        assert(kmalloc_index(prev + 1) == i);
+        assert(kmalloc_index(size) == i);
+        if (i + 1 < KMALLOC_CLASSES) {
+            assert(kmalloc_index(size + 1) == i + 1);
+        }
+        prev = size;
+    }
+    assert(kmalloc_index(0) == 0);
+    for (size_t size = 1; size <= KMALLOC_MAX_CACHE_SIZE; size++) {
+        unsigned i = kmalloc_index(size);
+        assert(kmalloc_classes[i].size >= size);
+        assert(i == 0 || kmalloc_classes[i - 1].size < size);
+    }
+}
+
+/* Test allocations of every size, including whole blocks of pages. */
+static void test_kmalloc(void)
+{
+    static unsigned char *ptrs[N_OBJS];
+    static size_t sizes[N_OBJS];
+    size_t total = page_free_count(), size;
+    struct slab *s;
+
+    for (size_t i = 0; i < N_OBJS; i++) {
+        size = i % 8 == 7 ? 1 + (size_t)rand() % (16 * PAGE_SIZE)
+                          : 1 + (size_t)rand() % KMALLOC_MAX_CACHE_SIZE;
+        ptrs[i] = kmalloc(size);
+        sizes[i] = size;
+        assert(ptrs[i] != NULL && (uintptr_t)ptrs[i] % KMALLOC_ALIGN == 0);
+        if (size <= KMALLOC_MAX_CACHE_SIZE) {
+            s = page_owner(ptrs[i]);
+            assert(s->cache == &kmalloc_caches[kmalloc_index(size)]);
+        } else {
+            assert((uintptr_t)ptrs[i] % PAGE_SIZE == 0);
+        }
+        memset(ptrs[i], (int)i, size);
+    }
+    /* Free in an order unrelated to that of allocation; 2731 is odd. */
+    for (size_t j = 0, i; j < N_OBJS; j++) {
+        i = j * 2731 % N_OBJS;
+        for (size_t k = 0; k < sizes[i]; k++) {
+            assert(ptrs[i][k] == (unsigned char)i);
+        }
+        kfree(ptrs[i]);
+    }
+    kfree(NULL);
+    assert(kmalloc((size_t)PAGE_SIZE << (PAGE_MAX_ORDER + 1)) == NULL);
+    for (unsigned i = 0; i < KMALLOC_CLASSES; i++) {
+        drain_magazine(&kmalloc_caches[i]);
+    }
+    /* Only the empty slab of each class is left. */
+    for (unsigned i = 0; i < KMALLOC_CLASSES; i++) {
+        total -= kmalloc_caches[i].partial == NULL
+                && kmalloc_caches[i].empty != NULL
+            ? 1U << kmalloc_caches[i].order
+            : 0;
+        assert(kmalloc_caches[i].partial == NULL);
+    }
+    assert(page_free_count() == total);
+}
+
+/* Test a named cache: constructors, frees across slabs, and slabs given
+ * back once empty. */
+static void test_cache(void)
+{
+    static void *objs[N_OBJS];
+    struct kmem_cache *cache, *other;
+    size_t total, slabs = 0;
+    struct slab *s;
+
+    cache = kmem_cache_create("obj", sizeof(struct obj), 0, obj_ctor);
+    other = kmem_cache_create("other", sizeof(struct obj), 0, NULL);
+    assert(cache != NULL && other != NULL);
+    assert(strcmp(cache->name, "obj") == 0);
+    assert(cache->size == sizeof(struct obj));
+    total = page_free_count();
+
+    for (size_t i = 0; i < N_OBJS; i++) {
+        struct obj *o = objs[i] = kmem_cache_alloc(cache);
+        assert(o != NULL && (uintptr_t)o % sizeof(void *) == 0);
+        assert(o->magic == OBJ_MAGIC && o->self == o);
+    }
+    /* The constructor ran once for every object of every slab. */
+    slabs = (total - page_free_count()) >> cache->order;
+    assert(slabs > 1 && ctor_runs == slabs * cache->per_slab);
+    assert_panics(kmem_cache_free(other, objs[0]));
+
+    /* Objects go back in the state they were constructed in, and are
+     * handed out again without being constructed anew. */
+    shuffle(objs, N_OBJS);
+    for (size_t i = 0; i < N_OBJS / 2; i++) {
+        kmem_cache_free(cache, objs[i]);
+    }
+    for (size_t i = 0; i < N_OBJS / 2; i++) {
+        objs[i] = kmem_cache_alloc(cache);
+        assert(((struct obj *)objs[i])->self == objs[i]);
+    }
+    assert(ctor_runs == slabs * cache->per_slab);
+
+    /* Frees in random order, across every slab, give all of their pages
+     * back but for one empty slab. */
+    shuffle(objs, N_OBJS);
+    for (size_t i = 0; i < N_OBJS; i++) {
+        s = page_owner(objs[i]);
+        assert(s->cache == cache);
+        kfree(objs[i]);
+    }
+    drain_magazine(cache);
+    assert(cache->partial == NULL && cache->empty != NULL);
+    assert(page_free_count() == total - (1U << cache->order));
+}
+
+/* Test that slabs of a cache start their objects at different colors. */
+static void test_color(void)
+{
+    static void *objs[N_OBJS];
+    struct kmem_cache *cache = &kmalloc_caches[kmalloc_index(512)];
+    size_t seen = 0, off;
+    struct slab *s;
+
+    assert(cache->colors > 1);
+    for (size_t i = 0; i < N_OBJS; i++) {
+        objs[i] = kmem_cache_alloc(cache);
+        s = page_owner(objs[i]);
+        off = (size_t)(s->objs - (char *)s - cache->offset);
+        assert(off % CACHE_LINE_SIZE == 0);
+        assert(off / cache->color_step < cache->colors);
+        seen |= (size_t)1 << (off / cache->color_step);
+    }
+    assert(seen == ((size_t)1 << cache->colors) - 1);
+    for (size_t i = 0; i < N_OBJS; i++) {
+        kmem_cache_free(cache, objs[i]);
+    }
+}
+
+/* Test alignments, and sizes too large for a slab. */
+static void test_create(void)
+{
+    struct kmem_cache *cache = kmem_cache_create("a256", 100, 256, NULL);
+    void *objs[64];
+
+    assert(cache != NULL && cache->size == 256);
+    for (size_t i = 0; i < 64; i++) {
+        objs[i] = kmem_cache_alloc(cache);
+        assert((uintptr_t)objs[i] % 256 == 0);
+    }
+    for (size_t i = 0; i < 64; i++) {
+        kmem_cache_free(cache, objs[i]);
+    }
+    assert(kmem_cache_create("huge", PAGE_SIZE << KMEM_SLAB_MAX_ORDER, 0,
+               NULL)
+        == NULL);
+    assert_panics(kmem_cache_create("odd", 64, 24, NULL));
+}
+
+int main(int argc, char **argv)
+{
+    uintptr_t mem = map_mem(MEM_SIZE);
+
+    page_init(mem, mem + MEM_SIZE);
+    page_add(mem, mem + MEM_SIZE);
+    /* Keep whole pages out of the page caches, so that they are counted
+     * as soon as slabs are freed. */
+    page_cache_tune(0, 0);
+    slab_init();
+    srand(0x24);
+    test_kmalloc_index();
+    test_kmalloc();
+    test_cache();
+    test_color();
+    test_create();
+    return 0;
+}
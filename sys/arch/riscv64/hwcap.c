@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/arch/riscv64/csr.h>
+#include <sys/fdt.h>
+#include <sys/hwcap.h>
+
+/* Multi-letter extensions that are detected, by name. */
+static const struct {
+    const char *name;
+    unsigned long hwcap;
+} isa_exts[] = {
+    { "zbb", HWCAP_ZBB },
+    { "zbc", HWCAP_ZBC },
+    { "zicbom", HWCAP_ZICBOM },
+    { "zicboz", HWCAP_ZICBOZ },
+    { "zihintpause", HWCAP_ZIHINTPAUSE },
+};
+
+/**
+ * @brief      Maps the name of a multi-letter extension to its capability flag.
+ *
+ * @param[in]  name  The name, which need not be null-terminated.
+ * @param[in]  len   The length of the name.
+ *
+ * @return     The flag, or 0 if the extension is not one that is detected.
+ */
+static unsigned long isa_ext(const char *name, size_t len)
+{
+    for (size_t i = 0; i < sizeof(isa_exts) / sizeof(*isa_exts); i++) {
+        if (strlen(isa_exts[i].name) == len
+            && memcmp(isa_exts[i].name, name, len) == 0) {
+            return isa_exts[i].hwcap;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief      Parses an ISA string such as "rv64imafdcv_zicbom_zbb".
+ *
+ * @param[in]  isa   The ISA string.
+ * @param[in]  len   The length of the string.
+ *
+ * @return     The extensions it names, as HWCAP_* flags.
+ */
+static unsigned long isa_parse(const char *isa, size_t len)
+{
+    const char *end = isa + strnlen(isa, len);
+    unsigned long hwcap = 0;
+    const char *p = isa;
+
+    if (end - p < 4 || memcmp(p, "rv", 2) != 0) {
+        return 0;
+    }
+    /* Single-letter extensions follow the base ISA width. */
+    for (p += 4; p < end && *p != '_'; p++) {
+        if (*p >= 'a' && *p <= 'z') {
+            hwcap |= HWCAP_ISA(*p - 'a' + 'A');
+        }
+    }
+    /* Then come multi-letter extensions, separated by underscores. */
+    while (p < end) {
+        const char *name = ++p;
+        while (p < end && *p != '_') {
+            p++;
+        }
+        hwcap |= isa_ext(name, (size_t)(p - name));
+    }
+    return hwcap;
+}
+
+unsigned long hwcap_probe(const void *fdt)
+{
+    unsigned long misa = csr_read(CSR_MISA);
+    unsigned long hwcap = 0;
+    const char *prop;
+    size_t len;
+
+    if (fdt_valid(fdt)) {
+        /* Newer device trees list extensions one by one, each of them a
+         * null-terminated string. */
+        prop = fdt_find_prop(fdt, "riscv,isa-extensions", &len);
+        if (prop != NULL) {
+            for (const char *end = prop + len; prop < end;) {
+                size_t n = strnlen(prop, (size_t)(end - prop));
+                if (n == 1 && *prop >= 'a' && *prop <= 'z') {
+                    hwcap |= HWCAP_ISA(*prop - 'a' + 'A');
+                } else {
+                    hwcap |= isa_ext(prop, n);
+                }
+                prop += n + 1;
+            }
+        } else if ((prop = fdt_find_prop(fdt, "riscv,isa", &len)) != NULL) {
+            hwcap |= isa_parse(prop, len);
+        }
+    }
+    /* misa describes this very hart, so it prevails over the device tree
+     * for single-letter extensions, unless it is not implemented. */
+    if (misa != 0) {
+        hwcap = (hwcap & ~HWCAP_ISA_MASK) | (misa & HWCAP_ISA_MASK);
+    }
+    return hwcap;
+}
@@ -15,11 +15,20 @@
  * this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <errno.h>
+#include <limits.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/arch/riscv64/csr.h>
 #include <sys/arch/riscv64/pt.h>
+#include <sys/fdt.h>
+#include <sys/hwcap.h>
+#include <sys/page.h>
 #include <sys/panic.h>
+#include <sys/slab.h>
+#include <sys/spinlock.h>
+#include <unistd.h>
 
 /* TODO: call kernel console devices when we have that (: */
 ssize_t write(int fd, const void *buf, size_t count)
@@ -31,18 +40,52 @@ ssize_t write(int fd, const void *buf, size_t count)
     return (ssize_t)count;
 }
 
+ssize_t writev(int fd, const struct iovec *iov, int iovcnt)
+{
+    uint8_t *uart = (uint8_t *)0x10000000;
+    ssize_t count = 0;
+
+    if (iovcnt <= 0 || iovcnt > IOV_MAX) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (int i = 0; i < iovcnt; i++) {
+        const uint8_t *buf = iov[i].iov_base;
+        for (size_t j = 0; j < iov[i].iov_len; j++) {
+            *uart = buf[j];
+        }
+        count += (ssize_t)iov[i].iov_len;
+    }
+    return count;
+}
+
 void __attribute__((naked)) _start(void)
 {
-    /* Set global and stack pointers, and call _early_init(). */
+    /* Set global and stack pointers, keep the hart ID in the thread pointer
+       for hart_id(), and call _early_init(). Each hart gets a 64 KiB slice
+       of the boot stack, hart 0 the topmost one, and harts past the last
+       slice are parked. The hart ID and the device tree address passed by
+       the firmware in a0 and a1 are left untouched for it. */
     __asm__(".option push; .option norelax;"
             "la gp, __global_pointer;"
             ".option pop;"
+            "csrr tp, mhartid;"
+            "la t0, __stack_start;"
             "la sp, __stack_end;"
-            "jal zero, _early_init");
+            "sub t0, sp, t0;"
+            "srli t0, t0, 16;"
+            "bgeu tp, t0, 1f;"
+            "slli t0, tp, 16;"
+            "sub sp, sp, t0;"
+            "jal zero, _early_init;"
+            "1: wfi;"
+            "j 1b");
 }
 
 void __attribute__((noreturn)) _end(int exit_code)
 {
+    /* Write out any buffered output before halting. */
+    fflush(NULL);
     for (;;) {
         __asm__("wfi");
     }
@@ -51,8 +94,99 @@ void __attribute__((noreturn)) _end(int exit_code)
 void kmain(void);
 void _trap(void);
 
-void _early_init(void)
+extern char __ro_after_init_start[], __ro_after_init_end[];
+extern char __heap_start[];
+
+/* Set by hart 0 once the C library and the allocators are set up. */
+static int boot_done;
+
+/* Write-protects the objects marked __ro_after_init. The PMP entry is locked
+   so that it applies to M-mode too, which also means that it stays in place
+   until the next reset. */
+static void seal_ro_after_init(void)
+{
+    csr_pmpcfgx_t cfg = { 0 };
+    csr_write(CSR_PMPADDR0, (uintptr_t)__ro_after_init_start >> 2U);
+    csr_write(CSR_PMPADDR1, (uintptr_t)__ro_after_init_end >> 2U);
+    cfg.regs[1].fields.r = 1;
+    cfg.regs[1].fields.a = ADDRMATCH_TOR;
+    cfg.regs[1].fields.l = 1;
+    csr_write(CSR_PMPCFG0, cfg.value);
+}
+
+/* Reads a numeric option, such as "pagecache.high=64", from the command line
+   in the device tree. */
+static unsigned long boot_option(
+    const void *fdt, const char *name, unsigned long def)
+{
+    size_t len, name_len = strlen(name);
+    const char *args, *end, *p, *q;
+    unsigned long val;
+    char *val_end;
+
+    if (!fdt_valid(fdt)
+        || (args = fdt_find_prop(fdt, "bootargs", &len)) == NULL) {
+        return def;
+    }
+    end = args + strnlen(args, len);
+    for (p = args; p < end; p = q) {
+        while (p < end && *p == ' ') {
+            p++;
+        }
+        q = p;
+        while (q < end && *q != ' ') {
+            q++;
+        }
+        if ((size_t)(q - p) > name_len + 1 && memcmp(p, name, name_len) == 0
+            && p[name_len] == '=') {
+            val = strtoul(p + name_len + 1, &val_end, 0);
+            if (val_end == q) {
+                return val;
+            }
+        }
+    }
+    return def;
+}
+
+/* Hands a range of RAM over to the page allocator, except for the parts
+   that the device tree reserves, which include the device tree itself. */
+static void add_memory(const void *fdt, uintptr_t start, uintptr_t end)
+{
+    uintptr_t rstart, rend;
+
+    for (size_t i = 0; fdt_reserved(fdt, i, &rstart, &rend) == 0; i++) {
+        if (rstart < end && rend > start) {
+            if (rstart > start) {
+                add_memory(fdt, start, rstart);
+            }
+            if (rend < end) {
+                add_memory(fdt, rend, end);
+            }
+            return;
+        }
+    }
+    page_add(start, end);
+}
+
+/* Sets up the page allocator for the RAM past the boot stack. */
+static void memory_init(const void *fdt)
 {
+    uintptr_t start = (uintptr_t)__heap_start;
+    uintptr_t ram_start, ram_end;
+
+    if (!fdt_valid(fdt)
+        || fdt_memory(fdt, start, &ram_start, &ram_end) != 0) {
+        panic("cannot find the size of RAM in the device tree");
+    }
+    page_init(start, ram_end);
+    add_memory(fdt, start, ram_end);
+    page_cache_tune(boot_option(fdt, "pagecache.low", PAGE_CACHE_LOW),
+        boot_option(fdt, "pagecache.high", PAGE_CACHE_HIGH));
+}
+
+void _early_init(unsigned long hartid, const void *fdt)
+{
+    unsigned long hwcap = hwcap_probe(fdt);
     /* Disable supervisor address translation and protection. */
     csr_write(CSR_SATP, 0);
     /* Setup trap handler. */
@@ -61,7 +195,31 @@ void _early_init(void)
     csr_mstatus_t s = { 0 };
     s.value = csr_read(CSR_MSTATUS);
     s.fields.mpp = PRIV_MACHINE;
+    /* Enable the floating-point unit (initial state), which the compiler may
+       use for double arguments such as those of the printf() family. */
+    s.fields.fs = 1;
+    /* Likewise for the vector unit, which the C library uses when present. */
+    if (hwcap & HWCAP_ISA_V) {
+        s.fields.vs = 1;
+    }
     csr_write(CSR_MSTATUS, s.value);
+    if (hartid != 0) {
+        /* Only hart 0 runs the kernel for now. The others wait for it to
+           set up the shared state, take on its PMP entry, and are parked. */
+        while (!__atomic_load_n(&boot_done, __ATOMIC_ACQUIRE)) {
+            cpu_relax();
+        }
+        seal_ro_after_init();
+        for (;;) {
+            __asm__("wfi");
+        }
+    }
+    /* Let the C library pick its implementations, then lock them in. */
+    libc_init(hwcap);
+    seal_ro_after_init();
+    memory_init(fdt);
+    slab_init();
+    __atomic_store_n(&boot_done, 1, __ATOMIC_RELEASE);
     /* Set machine exception program counter. This makes the `mret`
        instruction jump to main() in M-mode. */
     csr_write(CSR_MEPC, (uintptr_t)&kmain);
@@ -35,6 +35,7 @@ void __attribute__((noreturn)) panic(const char *fmt, ...)
     putchar('\n');
     va_end(v);
     regs_print(&r);
-    puts("system halted\n");
+    puts("system halted");
+    fflush(stdout);
     _end();
 }
@@ -18,36 +18,39 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <sys/arch/riscv64/regs.h>
+#include <sys/kprint.h>
 
 int regs_print(const struct regs *r)
 {
     const uint64_t *rb = (const uint64_t *)r;
     /* Temporary registers t0-t6. */
     for (int t = 0; t <= 6; t++, rb++) {
-        printf("t%-3d=0x%016x\t", t, *rb);
+        kprint(KP_S("t"), KP_D(t, -3), KP_S("=0x"), KP_X(*rb, 16),
+            KP_S("\t"));
         if (t % 3 > 1 || t == 6) {
-            puts("\n");
+            putchar('\n');
         }
     }
     /* Saved registers s0-s11. */
     for (int s = 0; s <= 11; s++, rb++) {
-        printf("s%-3d=0x%016x\t", s, *rb);
+        kprint(KP_S("s"), KP_D(s, -3), KP_S("=0x"), KP_X(*rb, 16),
+            KP_S("\t"));
         if (s % 3 > 1 || s == 11) {
-            puts("\n");
+            putchar('\n');
         }
     }
     /* Function argument registers a0-a7. */
     for (int a = 0; a <= 7; a++, rb++) {
-        printf("a%-3d=0x%016x\t", a, *rb);
+        kprint(KP_S("a"), KP_D(a, -3), KP_S("=0x"), KP_X(*rb, 16),
+            KP_S("\t"));
         if (a % 3 > 1 || a == 7) {
-            puts("\n");
+            putchar('\n');
         }
     }
     /* Special registers. */
-    printf("zero=0x%016x\t", r->zero);
-    printf("ra  =0x%016x\t", r->ra);
-    printf("sp  =0x%016x\t\n", r->sp);
-    printf("gp  =0x%016x\t", r->gp);
-    printf("tp  =0x%016x\t\n", r->tp);
+    kprint(KP_S("zero=0x"), KP_X(r->zero, 16), KP_S("\tra  =0x"),
+        KP_X(r->ra, 16), KP_S("\tsp  =0x"), KP_X(r->sp, 16),
+        KP_S("\t\ngp  =0x"), KP_X(r->gp, 16), KP_S("\ttp  =0x"),
+        KP_X(r->tp, 16), KP_S("\t\n"));
     return 0;
 }
@@ -62,8 +62,8 @@ void _trap(void)
         if (cause_code < descs_len && exception_descs[cause_code] != NULL) {
             desc = (char *)exception_descs[cause_code];
         }
-        panic("synchronous exception on hart %d at %p: %s "
-              "(cause=%lld, tval=%p)",
+        panic("synchronous exception on hart %llu at %p: %s "
+              "(cause=%llu, tval=%p)",
             hartid, epc, desc, cause_code, tval);
     }
 }
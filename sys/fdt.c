@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/fdt.h>
+
+/* Structure block tokens. */
+#define FDT_BEGIN_NODE 1U
+#define FDT_END_NODE 2U
+#define FDT_PROP 3U
+#define FDT_NOP 4U
+
+/* Offsets of the header fields that are used. */
+#define FDT_TOTALSIZE 4
+#define FDT_OFF_DT_STRUCT 8
+#define FDT_OFF_DT_STRINGS 12
+#define FDT_OFF_MEM_RSVMAP 16
+#define FDT_SIZE_DT_STRUCT 36
+
+uint32_t fdt32(const void *p)
+{
+    const uint8_t *b = p;
+    return (uint32_t)b[0] << 24U | (uint32_t)b[1] << 16U
+        | (uint32_t)b[2] << 8U | b[3];
+}
+
+/**
+ * @brief      Reads a value made of one or more 32-bit cells.
+ *
+ * @param[in]  p      Pointer to the first cell.
+ * @param[in]  cells  The number of cells, of which only the last two count.
+ *
+ * @return     The value.
+ */
+static uint64_t fdt_cells(const uint8_t *p, uint32_t cells)
+{
+    uint64_t v = 0;
+    for (; cells > 0; cells--, p += 4) {
+        v = v << 32U | fdt32(p);
+    }
+    return v;
+}
+
+int fdt_valid(const void *fdt)
+{
+    return fdt != NULL && fdt32(fdt) == FDT_MAGIC;
+}
+
+const char *fdt_find_prop(const void *fdt, const char *name, size_t *len)
+{
+    const uint8_t *base = fdt;
+    const uint8_t *p = base + fdt32(base + FDT_OFF_DT_STRUCT);
+    const char *strings = (const char *)base + fdt32(base + FDT_OFF_DT_STRINGS);
+    const uint8_t *end = p + fdt32(base + FDT_SIZE_DT_STRUCT);
+
+    while (p < end) {
+        uint32_t token = fdt32(p);
+        p += 4;
+        if (token == FDT_BEGIN_NODE) {
+            /* Skip the node name and its padding. */
+            p += (strlen((const char *)p) + 4) & ~(size_t)3;
+        } else if (token == FDT_PROP) {
+            uint32_t size = fdt32(p);
+            const char *prop = strings + fdt32(p + 4);
+            p += 8;
+            if (strcmp(prop, name) == 0) {
+                *len = size;
+                return (const char *)p;
+            }
+            p += (size + 3) & ~(size_t)3;
+        } else if (token != FDT_END_NODE && token != FDT_NOP) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+int fdt_memory(const void *fdt, uintptr_t addr, uintptr_t *start,
+    uintptr_t *end)
+{
+    const uint8_t *base = fdt;
+    const uint8_t *p = base + fdt32(base + FDT_OFF_DT_STRUCT);
+    const char *strings = (const char *)base + fdt32(base + FDT_OFF_DT_STRINGS);
+    const uint8_t *struct_end = p + fdt32(base + FDT_SIZE_DT_STRUCT);
+    /* Defaults that the root node may override. */
+    uint32_t addr_cells = 2, size_cells = 1;
+    int depth = 0, memory = 0;
+
+    while (p < struct_end) {
+        uint32_t token = fdt32(p);
+        p += 4;
+        if (token == FDT_BEGIN_NODE) {
+            const char *name = (const char *)p;
+            size_t len = strlen(name);
+            /* Memory nodes are children of the root, named "memory" or
+             * "memory@<address>". */
+            depth++;
+            memory = depth == 2 && len >= 6 && memcmp(name, "memory", 6) == 0
+                && (name[6] == '\0' || name[6] == '@');
+            p += (len + 4) & ~(size_t)3;
+        } else if (token == FDT_END_NODE) {
+            depth--;
+            memory = 0;
+        } else if (token == FDT_PROP) {
+            uint32_t size = fdt32(p);
+            const char *prop = strings + fdt32(p + 4);
+            const uint8_t *val = p + 8;
+            p = val + ((size + 3) & ~(size_t)3);
+            if (depth == 1 && strcmp(prop, "#address-cells") == 0) {
+                addr_cells = fdt32(val);
+            } else if (depth == 1 && strcmp(prop, "#size-cells") == 0) {
+                size_cells = fdt32(val);
+            } else if (memory && strcmp(prop, "reg") == 0) {
+                size_t entry = 4 * (size_t)(addr_cells + size_cells);
+                while (entry > 0 && size >= entry) {
+                    uint64_t lo = fdt_cells(val, addr_cells);
+                    uint64_t len = fdt_cells(val + 4 * addr_cells, size_cells);
+                    if (addr >= lo && addr - lo < len) {
+                        *start = (uintptr_t)lo;
+                        *end = (uintptr_t)(lo + len);
+                        return 0;
+                    }
+                    val += entry;
+                    size -= (uint32_t)entry;
+                }
+            }
+        } else if (token != FDT_NOP) {
+            break;
+        }
+    }
+    return -1;
+}
+
+int fdt_reserved(const void *fdt, size_t index, uintptr_t *start,
+    uintptr_t *end)
+{
+    const uint8_t *base = fdt;
+    const uint8_t *entry;
+    uint64_t addr, size;
+
+    if (index == 0) {
+        *start = (uintptr_t)fdt;
+        *end = *start + fdt32(base + FDT_TOTALSIZE);
+        return 0;
+    }
+    /* The reservation block is a list of address and size pairs, ended by
+     * one that is all zeros. */
+    entry = base + fdt32(base + FDT_OFF_MEM_RSVMAP);
+    for (size_t i = 1; i < index; i++, entry += 16) {
+        if (fdt_cells(entry, 2) == 0 && fdt_cells(entry + 8, 2) == 0) {
+            return -1;
+        }
+    }
+    addr = fdt_cells(entry, 2);
+    size = fdt_cells(entry + 8, 2);
+    if (addr == 0 && size == 0) {
+        return -1;
+    }
+    *start = (uintptr_t)addr;
+    *end = (uintptr_t)(addr + size);
+    return 0;
+}
@@ -16,10 +16,20 @@
  */
 
 #include <stdio.h>
+#include <sys/hwcap.h>
+#include <sys/page.h>
 
 void kmain(void)
 {
     printf("Hello, world!\n");
+    printf("ISA extensions: ");
+    for (char ext = 'A'; ext <= 'Z'; ext++) {
+        if (libc_hwcap & HWCAP_ISA(ext)) {
+            putchar(ext);
+        }
+    }
+    printf(" (hwcap %#lx)\n", libc_hwcap);
+    printf("Free memory: %zu KiB\n", page_free_count() * PAGE_SIZE / 1024);
     /* Illegal instruction for testing trap handler. */
     ((void (*)(void)) "..")();
 }
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/page.h>
+#include <sys/param.h>
+
+/* Memory is not translated, so mappings are blocks of physical pages, and
+ * only anonymous ones are supported. A block is split into single pages as
+ * soon as it is allocated, so that any whole pages of a mapping can be
+ * unmapped, and the pages past its length are given back at once. Mappings
+ * are still aligned to the size of the block they came from, that is, to
+ * their length rounded up to a power of two. */
+
+void *mmap(
+    void *addr, size_t length, int prot, int flags, int fd, off_t offset)
+{
+    size_t pages = (length + PAGE_SIZE - 1) >> PAGE_SHIFT;
+    unsigned order = page_order(length);
+    char *p;
+
+    if (length == 0 || (flags & MAP_ANONYMOUS) == 0) {
+        errno = EINVAL;
+        return MAP_FAILED;
+    }
+    if (order > PAGE_MAX_ORDER || (p = page_alloc(order)) == NULL) {
+        errno = ENOMEM;
+        return MAP_FAILED;
+    }
+    page_split(p, order);
+    for (size_t i = pages; i < (size_t)1 << order; i++) {
+        page_free(p + (i << PAGE_SHIFT), 0);
+    }
+    memset(p, 0, pages << PAGE_SHIFT);
+    return p;
+}
+
+int munmap(void *addr, size_t length)
+{
+    if ((uintptr_t)addr % PAGE_SIZE != 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (size_t i = 0; i < length; i += PAGE_SIZE) {
+        page_free((char *)addr + i, 0);
+    }
+    return 0;
+}
@@ -0,0 +1,398 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/hart.h>
+#include <sys/page.h>
+#include <sys/panic.h>
+#include <sys/param.h>
+#include <sys/spinlock.h>
+
+/* Binary buddy allocator. Free blocks of each order are kept in a list, and
+ * a block of order n can only merge with its buddy, the block of the same
+ * order whose index differs in bit n alone. Allocating splits a larger block
+ * in halves until one of the requested order is left, and freeing merges
+ * the block with its buddy for as long as the buddy is free too, so both
+ * take O(PAGE_MAX_ORDER) steps.
+ *
+ * Single pages, by far the most common request, go through a cache in each
+ * hart instead: a stack of pages that only that hart touches, so that it
+ * needs no lock. An empty cache is refilled up to the low watermark, and a
+ * full one, at the high watermark, is drained down to the low one, so that
+ * the global lock is taken once per batch of pages. Nothing may allocate
+ * pages from a trap handler, which could interrupt its hart halfway through
+ * an update of the cache. */
+
+/* Index that stands for no page at all. */
+#define PAGE_NONE UINT32_MAX
+
+/* States of a page. Only the first page of a block tells the state of the
+ * whole block. The others are never looked at, but none of them is left
+ * marked as used, so that freeing one is caught. */
+enum {
+    PAGE_RESERVED, /* Not managed by the allocator. */
+    PAGE_FREE, /* First page of a free block. */
+    PAGE_USED, /* First page of an allocated block. */
+    PAGE_CACHED, /* Single page held by the cache of a hart. */
+    PAGE_TAIL, /* First page of a block merged into a larger one. */
+};
+
+/* Metadata of a page. Free blocks are linked by the indices of their first
+ * pages, while pages of allocated blocks may record an owner instead. */
+struct page {
+    union {
+        struct {
+            uint32_t next;
+            uint32_t prev;
+        } link; /* Neighbours of a free block in its list. */
+        void *owner; /* Owner of an allocated page. */
+    } u;
+    uint8_t order;
+    uint8_t state;
+};
+
+static spinlock_t page_lock = SPINLOCK_INIT;
+/* Metadata of every page, from the one at page_base onwards. */
+static struct page *pages;
+static size_t page_count;
+/* Address of the first page, aligned to the largest block size so that
+ * buddies of any order are also buddies in physical memory. */
+static uintptr_t page_base;
+/* Address of the first page past the metadata. */
+static uintptr_t page_first;
+/* Heads of the lists of free blocks of each order. */
+static uint32_t free_lists[PAGE_MAX_ORDER + 1];
+static size_t free_count;
+
+/* Cache of single pages of a hart. It is aligned to a cache line so that
+ * harts do not share any. */
+struct page_cache {
+    unsigned count;
+    struct page_cache_stats stats;
+    uint32_t pages[PAGE_CACHE_MAX];
+} __attribute__((__aligned__(CACHE_LINE_SIZE)));
+
+static struct page_cache page_caches[HART_MAX];
+/* Watermarks of every cache, set by page_cache_tune(). */
+static unsigned cache_low = PAGE_CACHE_LOW;
+static unsigned cache_high = PAGE_CACHE_HIGH;
+
+static void list_push(uint32_t idx, unsigned order)
+{
+    struct page *p = &pages[idx];
+    uint32_t head = free_lists[order];
+
+    p->u.link.next = head;
+    p->u.link.prev = PAGE_NONE;
+    p->order = (uint8_t)order;
+    p->state = PAGE_FREE;
+    if (head != PAGE_NONE) {
+        pages[head].u.link.prev = idx;
+    }
+    free_lists[order] = idx;
+}
+
+static void list_remove(uint32_t idx, unsigned order)
+{
+    struct page *p = &pages[idx];
+
+    if (p->u.link.prev != PAGE_NONE) {
+        pages[p->u.link.prev].u.link.next = p->u.link.next;
+    } else {
+        free_lists[order] = p->u.link.next;
+    }
+    if (p->u.link.next != PAGE_NONE) {
+        pages[p->u.link.next].u.link.prev = p->u.link.prev;
+    }
+}
+
+/**
+ * @brief      Puts a block in the free lists, merged with as many of its
+ *             buddies as are free.
+ *
+ * @param[in]  idx    The index of the first page of the block.
+ * @param[in]  order  The order of the block.
+ */
+static void free_block(uint32_t idx, unsigned order)
+{
+    uint32_t buddy;
+
+    for (; order < PAGE_MAX_ORDER; order++) {
+        buddy = idx ^ (1U << order);
+        if (buddy >= page_count || pages[buddy].state != PAGE_FREE
+            || pages[buddy].order != order) {
+            break;
+        }
+        list_remove(buddy, order);
+        /* The upper half is no longer a block of its own. */
+        pages[idx | (1U << order)].state = PAGE_TAIL;
+        idx &= ~(1U << order);
+    }
+    list_push(idx, order);
+}
+
+void page_init(uintptr_t start, uintptr_t end)
+{
+    uintptr_t block = PAGE_SIZE << PAGE_MAX_ORDER;
+
+    start = (start + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    end &= ~(PAGE_SIZE - 1);
+    page_base = start & ~(block - 1);
+    page_count = (end - page_base) >> PAGE_SHIFT;
+    pages = (struct page *)start;
+    page_first = (start + page_count * sizeof(struct page) + PAGE_SIZE - 1)
+        & ~(PAGE_SIZE - 1);
+    for (size_t i = 0; i < page_count; i++) {
+        pages[i].order = 0;
+        pages[i].state = PAGE_RESERVED;
+    }
+    for (unsigned i = 0; i <= PAGE_MAX_ORDER; i++) {
+        free_lists[i] = PAGE_NONE;
+    }
+    free_count = 0;
+}
+
+void page_add(uintptr_t start, uintptr_t end)
+{
+    uintptr_t limit = page_base + page_count * PAGE_SIZE;
+    uint32_t idx, last;
+    unsigned order;
+
+    start = MAX((start + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1), page_first);
+    end = MIN(end & ~(PAGE_SIZE - 1), limit);
+    if (start >= end) {
+        return;
+    }
+    idx = (uint32_t)((start - page_base) >> PAGE_SHIFT);
+    last = (uint32_t)((end - page_base) >> PAGE_SHIFT);
+
+    spin_lock(&page_lock);
+    free_count += last - idx;
+    /* Cut the range into the largest blocks its alignment allows. */
+    while (idx < last) {
+        order = PAGE_MAX_ORDER;
+        while (idx % (1U << order) != 0 || idx + (1U << order) > last) {
+            order--;
+        }
+        free_block(idx, order);
+        idx += 1U << order;
+    }
+    spin_unlock(&page_lock);
+}
+
+/**
+ * @brief      Takes a block out of the free lists. The caller holds page_lock.
+ *
+ * @param[in]  order  The order of the block.
+ *
+ * @return     The index of the first page of the block, or PAGE_NONE if there
+ *             is no free block that large.
+ */
+static uint32_t alloc_block(unsigned order)
+{
+    unsigned o = order;
+    uint32_t idx;
+
+    while (o <= PAGE_MAX_ORDER && free_lists[o] == PAGE_NONE) {
+        o++;
+    }
+    if (o > PAGE_MAX_ORDER) {
+        return PAGE_NONE;
+    }
+    idx = free_lists[o];
+    list_remove(idx, o);
+    /* Give back the upper half of the block until it is small enough. */
+    while (o > order) {
+        o--;
+        list_push(idx + (1U << o), o);
+    }
+    pages[idx].order = (uint8_t)order;
+    pages[idx].state = PAGE_USED;
+    free_count -= 1U << order;
+    return idx;
+}
+
+static void *page_addr(uint32_t idx)
+{
+    return (void *)(page_base + ((uintptr_t)idx << PAGE_SHIFT));
+}
+
+/**
+ * @brief      Checks that an address is that of an allocated block, and obtains
+ *             its index.
+ *
+ * @param      addr   The address.
+ * @param[in]  order  The order the block was allocated with.
+ *
+ * @return     The index of the first page of the block.
+ */
+static uint32_t page_index(void *addr, unsigned order)
+{
+    uintptr_t a = (uintptr_t)addr;
+    uint32_t idx = (uint32_t)((a - page_base) >> PAGE_SHIFT);
+
+    if (a < page_base || a % PAGE_SIZE != 0 || idx >= page_count
+        || pages[idx].state != PAGE_USED || pages[idx].order != order) {
+        panic("%p is not an allocated block of order %u", addr, order);
+    }
+    return idx;
+}
+
+/* Obtains the cache of the current hart, or NULL if it has none. */
+static struct page_cache *this_cache(void)
+{
+    unsigned hart = hart_id();
+    return hart < HART_MAX && cache_high > 0 ? &page_caches[hart] : NULL;
+}
+
+/* Fills an empty cache up to the low watermark, or with a single page if
+ * that is zero. */
+static void cache_refill(struct page_cache *c)
+{
+    unsigned want = MAX(cache_low, 1U);
+    uint32_t idx;
+
+    spin_lock(&page_lock);
+    while (c->count < want && (idx = alloc_block(0)) != PAGE_NONE) {
+        pages[idx].state = PAGE_CACHED;
+        c->pages[c->count++] = idx;
+    }
+    spin_unlock(&page_lock);
+}
+
+/* Gives pages back from a full cache until the low watermark is reached. */
+static void cache_drain(struct page_cache *c)
+{
+    uint32_t idx;
+
+    spin_lock(&page_lock);
+    while (c->count > cache_low) {
+        idx = c->pages[--c->count];
+        free_count++;
+        free_block(idx, 0);
+    }
+    spin_unlock(&page_lock);
+}
+
+void *page_alloc(unsigned order)
+{
+    struct page_cache *c;
+    uint32_t idx;
+
+    if (order > PAGE_MAX_ORDER) {
+        return NULL;
+    }
+    if (order == 0 && (c = this_cache()) != NULL) {
+        if (c->count > 0) {
+            c->stats.alloc_hits++;
+        } else {
+            c->stats.alloc_misses++;
+            cache_refill(c);
+            if (c->count == 0) {
+                return NULL;
+            }
+        }
+        idx = c->pages[--c->count];
+        pages[idx].state = PAGE_USED;
+        return page_addr(idx);
+    }
+    spin_lock(&page_lock);
+    idx = alloc_block(order);
+    spin_unlock(&page_lock);
+    return idx == PAGE_NONE ? NULL : page_addr(idx);
+}
+
+void page_free(void *addr, unsigned order)
+{
+    struct page_cache *c;
+    uint32_t idx;
+
+    if (order == 0 && (c = this_cache()) != NULL) {
+        idx = page_index(addr, order);
+        if (c->count < cache_high) {
+            c->stats.free_hits++;
+        } else {
+            c->stats.free_misses++;
+            cache_drain(c);
+        }
+        pages[idx].state = PAGE_CACHED;
+        c->pages[c->count++] = idx;
+        return;
+    }
+    spin_lock(&page_lock);
+    idx = page_index(addr, order);
+    free_count += 1U << order;
+    free_block(idx, order);
+    spin_unlock(&page_lock);
+}
+
+void page_split(void *addr, unsigned order)
+{
+    uint32_t idx;
+
+    spin_lock(&page_lock);
+    idx = page_index(addr, order);
+    for (uint32_t i = 0; i < 1U << order; i++) {
+        pages[idx + i].order = 0;
+        pages[idx + i].state = PAGE_USED;
+    }
+    spin_unlock(&page_lock);
+}
+
+void page_set_owner(void *addr, unsigned order, void *owner)
+{
+    uint32_t idx = (uint32_t)(((uintptr_t)addr - page_base) >> PAGE_SHIFT);
+
+    for (uint32_t i = 0; i < 1U << order; i++) {
+        pages[idx + i].u.owner = owner;
+    }
+}
+
+void *page_owner(const void *addr)
+{
+    return pages[((uintptr_t)addr - page_base) >> PAGE_SHIFT].u.owner;
+}
+
+void page_cache_tune(unsigned low, unsigned high)
+{
+    cache_high = MIN(high, PAGE_CACHE_MAX);
+    /* Draining must leave room for the page being freed. */
+    cache_low = MIN(low, cache_high > 0 ? cache_high - 1 : 0);
+}
+
+void page_cache_stats(struct page_cache_stats *stats)
+{
+    stats->alloc_hits = stats->alloc_misses = 0;
+    stats->free_hits = stats->free_misses = 0;
+    for (unsigned i = 0; i < HART_MAX; i++) {
+        stats->alloc_hits += page_caches[i].stats.alloc_hits;
+        stats->alloc_misses += page_caches[i].stats.alloc_misses;
+        stats->free_hits += page_caches[i].stats.free_hits;
+        stats->free_misses += page_caches[i].stats.free_misses;
+    }
+}
+
+size_t page_free_count(void)
+{
+    size_t count = free_count;
+    /* Cached pages are as good as free, if only for their own hart. */
+    for (unsigned i = 0; i < HART_MAX; i++) {
+        count += page_caches[i].count;
+    }
+    return count;
+}
@@ -0,0 +1,449 @@
+/*
+ * Copyright (C) 2023 Ángel Pérez <ap@anpep.co>
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/hart.h>
+#include <sys/page.h>
+#include <sys/panic.h>
+#include <sys/param.h>
+#include <sys/slab.h>
+#include <sys/spinlock.h>
+
+/* Slab allocator. Each cache carves blocks of pages, its slabs, into objects
+ * of a single size. A slab starts with a header that holds a stack of the
+ * indices of its free objects, so that neither taking nor returning one
+ * needs a search, and free objects are never written to, keeping whatever
+ * state the constructor of the cache left in them. Every page of a slab has
+ * the slab as its owner, which takes an object back to its slab in O(1).
+ *
+ * In front of the slabs, each hart has a magazine of free objects of every
+ * cache that only it touches, so that the common case takes no lock. An
+ * empty magazine is refilled, and a full one drained, by half of its size
+ * at a time under the lock of the cache. The lock of a cache is taken
+ * before that of the page allocator, never the other way around, and as
+ * with pages, nothing may allocate from a trap handler.
+ *
+ * Whatever a slab has left over after its objects moves them along by a
+ * different multiple of a cache line in each new slab, its color, so that
+ * the first objects of every slab do not all land on the same cache sets. */
+
+/* Capacity of the magazines of a cache. Caches of large objects use less of
+ * it so as not to hoard pages in each hart. */
+#define KMEM_MAG_MAX 32U
+/* Largest order of a slab, and largest fraction of it that may be wasted
+ * before a larger one is tried. */
+#define KMEM_SLAB_MAX_ORDER 3U
+#define KMEM_WASTE_DIV 8U
+
+struct slab {
+    struct kmem_cache *cache;
+    /* Neighbours in the list of partial slabs of the cache. */
+    struct slab *next;
+    struct slab *prev;
+    /* First object, past the header and the color of the slab. */
+    char *objs;
+    /* Number of free objects, whose indices fill stack up to this point. */
+    unsigned free;
+    uint16_t stack[];
+};
+
+/* Free objects of a cache held by a hart. It is aligned to a cache line so
+ * that harts do not share any. */
+struct kmem_magazine {
+    unsigned count;
+    void *objs[KMEM_MAG_MAX];
+} __attribute__((__aligned__(CACHE_LINE_SIZE)));
+
+struct kmem_cache {
+    struct kmem_magazine mags[HART_MAX];
+    spinlock_t lock;
+    /* Slabs with some objects in use and some free. Full slabs are not kept
+     * anywhere until an object of theirs is freed. */
+    struct slab *partial;
+    /* A slab with no objects in use, kept to avoid handing its pages back
+     * and forth. Any other such slab is freed at once. */
+    struct slab *empty;
+    const char *name;
+    void (*ctor)(void *);
+    size_t size;
+    unsigned order;
+    unsigned per_slab;
+    /* Offset of the objects from the start of a slab of color 0. */
+    size_t offset;
+    /* Number of colors, their spacing, and the color of the next slab. */
+    unsigned colors;
+    size_t color_step;
+    unsigned color;
+    /* Size of the magazines, and number of objects moved at a time. */
+    unsigned mag_size;
+    unsigned batch;
+};
+
+/* Cache of the caches made by kmem_cache_create(). */
+static struct kmem_cache cache_cache;
+
+/* Size classes of kmalloc(): powers of two and the midpoints between them
+ * from 64 bytes on, so that no more than a quarter of an object goes to
+ * waste past 96 bytes. */
+static const struct {
+    size_t size;
+    const char *name;
+} kmalloc_classes[] = {
+    { 16, "kmalloc-16" },
+    { 32, "kmalloc-32" },
+    { 64, "kmalloc-64" },
+    { 96, "kmalloc-96" },
+    { 128, "kmalloc-128" },
+    { 192, "kmalloc-192" },
+    { 256, "kmalloc-256" },
+    { 384, "kmalloc-384" },
+    { 512, "kmalloc-512" },
+    { 768, "kmalloc-768" },
+    { 1024, "kmalloc-1k" },
+    { 1536, "kmalloc-1.5k" },
+    { 2048, "kmalloc-2k" },
+    { 3072, "kmalloc-3k" },
+    { 4096, "kmalloc-4k" },
+};
+
+#define KMALLOC_CLASSES (sizeof(kmalloc_classes) / sizeof(kmalloc_classes[0]))
+#define KMALLOC_ALIGN 16U
+
+static struct kmem_cache kmalloc_caches[KMALLOC_CLASSES];
+/* Owners of the blocks of pages that kmalloc() hands out whole, one for
+ * each order, which only stand for it. */
+static char kmalloc_large[PAGE_MAX_ORDER + 1];
+
+/**
+ * @brief      Obtains the offset of the first object of a slab past its header.
+ *
+ * @param[in]  per_slab  The number of objects in the slab.
+ * @param[in]  align     The alignment of the objects.
+ *
+ * @return     The offset.
+ */
+static size_t slab_header(unsigned per_slab, size_t align)
+{
+    size_t size = sizeof(struct slab) + per_slab * sizeof(uint16_t);
+    return (size + align - 1) & ~(align - 1);
+}
+
+/**
+ * @brief      Lays out the slabs of a cache and makes it ready for use.
+ *
+ * @param      cache  The cache.
+ * @param[in]  name   The name of the cache.
+ * @param[in]  size   The size of each object.
+ * @param[in]  align  The alignment of each object, a power of two.
+ * @param[in]  ctor   The constructor of the objects, or NULL.
+ *
+ * @return     0 on success, or -1 if objects that large are not supported.
+ */
+static int cache_setup(struct kmem_cache *cache, const char *name,
+    size_t size, size_t align, void (*ctor)(void *))
+{
+    size_t bytes, left = 0;
+    unsigned order, n = 0;
+
+    size = (MAX(size, 1U) + align - 1) & ~(align - 1);
+    /* Take the smallest slab that wastes little enough, or failing that,
+     * the largest one. */
+    for (order = 0; order <= KMEM_SLAB_MAX_ORDER; order++) {
+        bytes = PAGE_SIZE << order;
+        n = (unsigned)MIN(bytes / size, UINT16_MAX);
+        while (n > 0 && slab_header(n, align) + n * size > bytes) {
+            n--;
+        }
+        if (n == 0) {
+            continue;
+        }
+        left = bytes - slab_header(n, align) - n * size;
+        if (left <= bytes / KMEM_WASTE_DIV || order == KMEM_SLAB_MAX_ORDER) {
+            break;
+        }
+    }
+    if (n == 0) {
+        return -1;
+    }
+    for (unsigned i = 0; i < HART_MAX; i++) {
+        cache->mags[i].count = 0;
+    }
+    cache->lock = (spinlock_t)SPINLOCK_INIT;
+    cache->partial = NULL;
+    cache->empty = NULL;
+    cache->name = name;
+    cache->ctor = ctor;
+    cache->size = size;
+    cache->order = order;
+    cache->per_slab = n;
+    cache->offset = slab_header(n, align);
+    cache->color_step = MAX(align, (size_t)CACHE_LINE_SIZE);
+    cache->colors = (unsigned)(left / cache->color_step) + 1;
+    cache->color = 0;
+    cache->mag_size = (unsigned)MIN(MAX(2 * PAGE_SIZE / size, 4U),
+        KMEM_MAG_MAX);
+    cache->batch = cache->mag_size / 2;
+    return 0;
+}
+
+static void slab_push(struct kmem_cache *cache, struct slab *s)
+{
+    s->prev = NULL;
+    s->next = cache->partial;
+    if (s->next != NULL) {
+        s->next->prev = s;
+    }
+    cache->partial = s;
+}
+
+static void slab_remove(struct kmem_cache *cache, struct slab *s)
+{
+    if (s->prev != NULL) {
+        s->prev->next = s->next;
+    } else {
+        cache->partial = s->next;
+    }
+    if (s->next != NULL) {
+        s->next->prev = s->prev;
+    }
+}
+
+/**
+ * @brief      Makes a new slab with all of its objects constructed and free.
+ *             The caller holds the lock of the cache.
+ *
+ * @param      cache  The cache.
+ *
+ * @return     The slab, or NULL if there were no pages for it.
+ */
+static struct slab *slab_create(struct kmem_cache *cache)
+{
+    struct slab *s = page_alloc(cache->order);
+
+    if (s == NULL) {
+        return NULL;
+    }
+    page_set_owner(s, cache->order, s);
+    s->cache = cache;
+    s->objs = (char *)s + cache->offset + cache->color * cache->color_step;
+    cache->color = (cache->color + 1) % cache->colors;
+    /* Hand out the first objects first, in the hope of touching fewer lines
+     * of a slab that is not full. */
+    s->free = cache->per_slab;
+    for (unsigned i = 0; i < cache->per_slab; i++) {
+        s->stack[i] = (uint16_t)(cache->per_slab - 1 - i);
+        if (cache->ctor != NULL) {
+            cache->ctor(s->objs + i * cache->size);
+        }
+    }
+    return s;
+}
+
+/**
+ * @brief      Takes a free object from the slabs of a cache. The caller holds
+ *             its lock.
+ *
+ * @param      cache  The cache.
+ *
+ * @return     The object, or NULL if there were no pages for a new slab.
+ */
+static void *slab_take(struct kmem_cache *cache)
+{
+    struct slab *s = cache->partial;
+
+    if (s == NULL) {
+        if (cache->empty != NULL) {
+            s = cache->empty;
+            cache->empty = NULL;
+        } else if ((s = slab_create(cache)) == NULL) {
+            return NULL;
+        }
+        slab_push(cache, s);
+    }
+    if (--s->free == 0) {
+        slab_remove(cache, s);
+    }
+    return s->objs + s->stack[s->free] * cache->size;
+}
+
+/**
+ * @brief      Returns an object to its slab. The caller holds the lock of the
+ *             cache.
+ *
+ * @param      cache  The cache.
+ * @param      obj    The object.
+ */
+static void slab_put(struct kmem_cache *cache, void *obj)
+{
+    struct slab *s = page_owner(obj);
+
+    if (s->free == 0) {
+        slab_push(cache, s);
+    }
+    s->stack[s->free++]
+        = (uint16_t)((size_t)((char *)obj - s->objs) / cache->size);
+    if (s->free == cache->per_slab) {
+        slab_remove(cache, s);
+        if (cache->empty == NULL) {
+            cache->empty = s;
+        } else {
+            page_free(s, cache->order);
+        }
+    }
+}
+
+/* Obtains the magazine of the current hart, or NULL if it has none. */
+static struct kmem_magazine *this_magazine(struct kmem_cache *cache)
+{
+    unsigned hart = hart_id();
+    return hart < HART_MAX ? &cache->mags[hart] : NULL;
+}
+
+void *kmem_cache_alloc(struct kmem_cache *cache)
+{
+    struct kmem_magazine *mag = this_magazine(cache);
+    void *obj;
+
+    if (mag == NULL) {
+        spin_lock(&cache->lock);
+        obj = slab_take(cache);
+        spin_unlock(&cache->lock);
+        return obj;
+    }
+    if (mag->count == 0) {
+        spin_lock(&cache->lock);
+        while (mag->count < cache->batch
+            && (obj = slab_take(cache)) != NULL) {
+            mag->objs[mag->count++] = obj;
+        }
+        spin_unlock(&cache->lock);
+        if (mag->count == 0) {
+            return NULL;
+        }
+    }
+    return mag->objs[--mag->count];
+}
+
+void kmem_cache_free(struct kmem_cache *cache, void *obj)
+{
+    struct kmem_magazine *mag = this_magazine(cache);
+    struct slab *s = page_owner(obj);
+
+    if (s->cache != cache) {
+        panic("kmem_cache_free: %p does not belong to %s", obj, cache->name);
+    }
+    if (mag == NULL) {
+        spin_lock(&cache->lock);
+        slab_put(cache, obj);
+        spin_unlock(&cache->lock);
+        return;
+    }
+    if (mag->count == cache->mag_size) {
+        spin_lock(&cache->lock);
+        while (mag->count > cache->mag_size - cache->batch) {
+            slab_put(cache, mag->objs[--mag->count]);
+        }
+        spin_unlock(&cache->lock);
+    }
+    mag->objs[mag->count++] = obj;
+}
+
+struct kmem_cache *kmem_cache_create(
+    const char *name, size_t size, size_t align, void (*ctor)(void *))
+{
+    struct kmem_cache *cache;
+
+    if (align == 0) {
+        align = sizeof(void *);
+    }
+    if ((align & (align - 1)) != 0) {
+        panic("kmem_cache_create: bad alignment %zu for %s", align, name);
+    }
+    if ((cache = kmem_cache_alloc(&cache_cache)) == NULL) {
+        return NULL;
+    }
+    if (cache_setup(cache, name, size, align, ctor) != 0) {
+        kmem_cache_free(&cache_cache, cache);
+        return NULL;
+    }
+    return cache;
+}
+
+/**
+ * @brief      Obtains the size class of kmalloc() for a number of bytes.
+ *
+ * @param[in]  size  The number of bytes, up to KMALLOC_MAX_CACHE_SIZE.
+ *
+ * @return     The index of the class.
+ */
+static unsigned kmalloc_index(size_t size)
+{
+    unsigned b;
+
+    if (size <= 16) {
+        return 0;
+    }
+    b = fls64(size - 1);
+    if (b < 7) {
+        return b - 4;
+    }
+    /* Classes 3 << (b - 2) and 1 << b share the same b. */
+    return 3 + 2 * (b - 7) + (size > (size_t)3 << (b - 2));
+}
+
+void *kmalloc(size_t size)
+{
+    unsigned order;
+    void *ptr;
+
+    if (size <= KMALLOC_MAX_CACHE_SIZE) {
+        return kmem_cache_alloc(&kmalloc_caches[kmalloc_index(size)]);
+    }
+    order = page_order(size);
+    if (order > PAGE_MAX_ORDER || (ptr = page_alloc(order)) == NULL) {
+        return NULL;
+    }
+    page_set_owner(ptr, order, &kmalloc_large[order]);
+    return ptr;
+}
+
+void kfree(void *ptr)
+{
+    uintptr_t owner;
+
+    if (ptr == NULL) {
+        return;
+    }
+    owner = (uintptr_t)page_owner(ptr);
+    if (owner >= (uintptr_t)kmalloc_large
+        && owner < (uintptr_t)kmalloc_large + sizeof(kmalloc_large)) {
+        page_free(ptr, (unsigned)(owner - (uintptr_t)kmalloc_large));
+        return;
+    }
+    kmem_cache_free(((struct slab *)owner)->cache, ptr);
+}
+
+void slab_init(void)
+{
+    cache_setup(&cache_cache, "kmem_cache", sizeof(struct kmem_cache),
+        CACHE_LINE_SIZE, NULL);
+    for (unsigned i = 0; i < KMALLOC_CLASSES; i++) {
+        cache_setup(&kmalloc_caches[i], kmalloc_classes[i].name,
+            kmalloc_classes[i].size, KMALLOC_ALIGN, NULL);
+    }
+}